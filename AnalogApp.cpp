@@ -6,6 +6,7 @@
 
 #include "AnalogApp.h"
 #include "Exception.h"
+#include "LogStyle.h"
 
 
 //****************************************************************************************************************************************************
@@ -13,6 +14,7 @@
 //****************************************************************************************************************************************************
 AnalogApp::AnalogApp(int &argc, char *argv[])
     : QApplication(argc, argv) {
+    LogStyle::install();
 }
 
 
@@ -0,0 +1,321 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of the benchmark tool entry-point.
+
+
+#include "Exception.h"
+#include "FilterModel.h"
+
+
+namespace {
+
+
+qint64 constexpr defaultMinDurationMs = 1000; ///< The default minimum duration of a benchmark, in milliseconds.
+qsizetype constexpr defaultLineCount = 200000; ///< The default number of lines of the generated log files.
+qsizetype constexpr maxSampleLineCount = 100000; ///< The maximum number of lines used by the line-level benchmarks.
+QString const optBridge = "bridge"; ///< The name of the bridge file option.
+QString const optGUI = "gui"; ///< The name of the bridge-gui file option.
+QString const optLines = "lines"; ///< The name of the line count option.
+QString const optMinTime = "min-time"; ///< The name of the minimum duration option.
+QString const optOutput = "output"; ///< The name of the output option.
+QString const optFilter = "filter"; ///< The name of the benchmark filter option.
+
+QStringList const bridgeSampleLines = {
+    R"(time="Oct 30 09:10:20.858" level=info msg="Run app" SentryID="k8jwFdFskPxr1yGyMgZE1Mn0n5ofYJnedhGOLrP3F+Y=" appName="Proton Mail Bridge" )"
+    R"(args="[/Users/user/bridge -c]" build="2022-10-18T13:13:13+0200" revision=5b650b1be3 runtime=darwin tag=devel version=3.99.99+git)",
+    R"(time="Oct 30 09:10:20.858" level=debug msg="Checking for other instances")",
+    R"(time="Oct 30 09:10:20.858" level=debug msg="Created lock file; no other instance is running" path=/Users/user/Library/Caches/bridge.lock)",
+    R"(time="Oct 30 09:10:20.878" level=info msg="Vault loaded" DoH=false autoUpdate=false lastVersion=3.99.99+git rollout=0.6668597594749908)",
+    R"(time="Oct 30 09:10:21.105" level=warning msg="Failed to fetch event" error="context canceled" pkg=imap/service userID=7f3a2c)",
+    R"(time="Oct 30 09:10:21.320" level=error msg="Sync failed" error="http: \"server\" closed the connection" pkg=sync attempt=3)",
+    R"(time="Oct 30 09:10:22.001" level=debug msg="Uploading attachment" contentID= disposition= mime-type=image/jpeg service=smtp )"
+    R"(user="MS8-8p9A1Cabs64gJqqQiz95yPASm_NYFnvz_Ytvj667LEkKko_CPvUAUSA_McXCFj625Gckb_w9OvJAN5uhdw==")",
+    R"(time="Oct 30 09:10:22.017" level=trace msg="IMAP command" pkg=gluon/imap session=12 command="UID FETCH 1:* (FLAGS)")",
+}; ///< The lines used to generate bridge log files.
+
+QStringList const guiSampleLines = {
+    "INFO[Oct 30 09:10:21.002] bridge-gui starting",
+    "DEBU[Oct 30 09:10:21.015] Loading QML from qrc:/qml/Bridge.qml",
+    "DEBU[Oct 30 09:10:21.250] Connecting to gRPC service on 127.0.0.1:1042",
+    "WARN[Oct 30 09:10:21.400] Could not load the tray icon theme, falling back to default",
+    "ERRO[Oct 30 09:10:22.810] gRPC call failed: Deadline Exceeded",
+    "INFO[Oct 30 09:10:23.000] Main window shown",
+}; ///< The lines used to generate bridge-gui log files.
+
+
+//****************************************************************************************************************************************************
+/// \brief Structure for benchmark results.
+//****************************************************************************************************************************************************
+struct Result {
+    QString name; ///< The name of the benchmark.
+    qint64 iterations { 0 }; ///< The number of iterations.
+    qint64 elapsedNs { 0 }; ///< The total duration of the iterations, in nanoseconds.
+    qint64 lineCount { 0 }; ///< The number of lines processed by an iteration.
+    qint64 byteCount { 0 }; ///< The number of bytes processed by an iteration.
+};
+
+
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] result The result.
+/// \return The JSON object for the result.
+//****************************************************************************************************************************************************
+QJsonObject resultToJson(Result const &result) {
+    double const secs = double(result.elapsedNs) / 1e9;
+    double const iterationCount = double(result.iterations);
+    return {
+        { "name", result.name },
+        { "iterations", result.iterations },
+        { "nsPerIteration", double(result.elapsedNs) / iterationCount },
+        { "linesPerIteration", result.lineCount },
+        { "bytesPerIteration", result.byteCount },
+        { "linesPerSec", (secs > 0.0) ? double(result.lineCount) * iterationCount / secs : 0.0 },
+        { "mbPerSec", (secs > 0.0) ? double(result.byteCount) * iterationCount / (secs * 1024.0 * 1024.0) : 0.0 },
+    };
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] lines The lines.
+/// \return The number of bytes of the lines, encoded in UTF-8, including end-of-line characters.
+//****************************************************************************************************************************************************
+qint64 utf8Size(QByteArrayList const &lines) {
+    return std::accumulate(lines.begin(), lines.end(), qint64(0), [](qint64 acc, QByteArray const &line) -> qint64 {
+        return acc + line.size() + 1;
+    });
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] filePath The path of the file.
+/// \param[in] sampleLines The lines repeated in the file.
+/// \param[in] lineCount The number of lines.
+//****************************************************************************************************************************************************
+void generateFile(QString const &filePath, QStringList const &sampleLines, qsizetype lineCount) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        throw Exception(QString("The file '%1' could not be created.").arg(QDir::toNativeSeparators(filePath)));
+    }
+    QList<QByteArray> encoded;
+    for (QString const &line: sampleLines) {
+        encoded.append(line.toUtf8() + '\n');
+    }
+    for (qsizetype i = 0; i < lineCount; ++i) {
+        if (file.write(encoded[i % encoded.count()]) < 0) {
+            throw Exception(QString("Could not write to '%1'.").arg(QDir::toNativeSeparators(filePath)));
+        }
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] filePath The path of the file.
+/// \return The UTF-8 lines of the file, without end-of-line characters, up to maxSampleLineCount lines.
+//****************************************************************************************************************************************************
+QByteArrayList readLines(QString const &filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        throw Exception(QString("The file '%1' could not be opened.").arg(QDir::toNativeSeparators(filePath)));
+    }
+    QByteArrayList result;
+    while ((!file.atEnd()) && (result.count() < maxSampleLineCount)) {
+        QByteArray line = file.readLine();
+        while (line.endsWith('\n') || line.endsWith('\r')) {
+            line.chop(1);
+        }
+        line.squeeze();
+        result.append(line);
+    }
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// The function is called repeatedly until the minimum duration is reached.
+///
+/// \param[in] name The name of the benchmark.
+/// \param[in] lineCount The number of lines processed by an iteration.
+/// \param[in] byteCount The number of bytes processed by an iteration.
+/// \param[in] minDurationMs The minimum duration of the benchmark, in milliseconds.
+/// \param[in] func The function to benchmark.
+/// \return The result of the benchmark.
+//****************************************************************************************************************************************************
+Result runBenchmark(QString const &name, qint64 lineCount, qint64 byteCount, qint64 minDurationMs, std::function<void()> const &func) {
+    Result result { name, 0, 0, lineCount, byteCount };
+    func(); // warm-up iteration.
+    QElapsedTimer timer;
+    timer.start();
+    do {
+        func();
+        ++result.iterations;
+    } while (timer.elapsed() < minDurationMs);
+    result.elapsedNs = timer.nsecsElapsed();
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] filter The filter model, whose log is set.
+/// \param[in] apply The function applying the filter to benchmark.
+/// \param[in] reset The function removing the filter.
+/// \return A function performing a filter change and reverting it.
+//****************************************************************************************************************************************************
+std::function<void()> refilterFunction(FilterModel &filter, std::function<void(FilterModel &)> const &apply,
+    std::function<void(FilterModel &)> const &reset) {
+    return [&filter, apply, reset]() {
+        apply(filter);
+        reset(filter);
+    };
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] argc The number of command-line arguments.
+/// \param[in] argv The list of command-line arguments.
+//****************************************************************************************************************************************************
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("analog-bench");
+    QCoreApplication::setApplicationVersion(QString("%1").arg(ANALOG_VERSION));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Measure the throughput of parsing, filtering and model access. Results are printed as JSON.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addOptions({
+        { optBridge, "The bridge log file to use. By default, a file is generated.", "path" },
+        { optGUI, "The bridge-gui log file to use. By default, a file is generated.", "path" },
+        { optLines, "The number of lines of the generated files.", "count", QString::number(defaultLineCount) },
+        { optMinTime, "The minimum duration of each benchmark, in milliseconds.", "ms", QString::number(defaultMinDurationMs) },
+        { { "o", optOutput }, "The file the results are written to. By default, results are printed to the standard output.", "path" },
+        { { "f", optFilter }, "Only run the benchmarks whose name contains the given text.", "text" },
+    });
+    parser.process(app);
+
+    QTextStream err(stderr);
+    try {
+        qint64 const minDurationMs = qMax(qint64(1), parser.value(optMinTime).toLongLong());
+        qsizetype const generatedLineCount = qMax(qsizetype(1), qsizetype(parser.value(optLines).toLongLong()));
+        QString const nameFilter = parser.value(optFilter);
+
+        QTemporaryDir tempDir;
+        if (!tempDir.isValid()) {
+            throw Exception("Could not create a temporary folder.");
+        }
+        QString bridgePath = parser.value(optBridge);
+        if (bridgePath.isEmpty()) {
+            bridgePath = tempDir.filePath("20231030_091020857_bri_000_v3.99.99+git_bench.log");
+            generateFile(bridgePath, bridgeSampleLines, generatedLineCount);
+        }
+        QString guiPath = parser.value(optGUI);
+        if (guiPath.isEmpty()) {
+            guiPath = tempDir.filePath("20231030_091021002_gui_000_v3.99.99+git_bench.log");
+            generateFile(guiPath, guiSampleLines, generatedLineCount);
+        }
+
+        QByteArrayList const bridgeLines = readLines(bridgePath);
+        QByteArrayList const guiLines = readLines(guiPath);
+        qint64 const bridgeLinesSize = utf8Size(bridgeLines);
+        qint64 const guiLinesSize = utf8Size(guiLines);
+        qint64 const bridgeFileSize = QFileInfo(bridgePath).size();
+        qint64 const guiFileSize = QFileInfo(guiPath).size();
+
+        QList<Result> results;
+        auto const run = [&](QString const &name, qint64 lineCount, qint64 byteCount, std::function<void()> const &func) {
+            if (nameFilter.isEmpty() || name.contains(nameFilter)) {
+                err << "Running " << name << "...\n";
+                err.flush();
+                results.append(runBenchmark(name, lineCount, byteCount, minDurationMs, func));
+            }
+        };
+
+        run("tokenizeBridge34Entry", bridgeLines.count(), bridgeLinesSize, [&]() {
+            for (QByteArray const &line: bridgeLines) {
+                volatile qsizetype const count = tokenizeBridge34Entry(line).count();
+                Q_UNUSED(count)
+            }
+        });
+        run("LogEntry/bridge", bridgeLines.count(), bridgeLinesSize, [&]() {
+            for (QByteArray const &line: bridgeLines) {
+                volatile bool const valid = LogEntry(line, LogEntry::Format::Bridge_3_4_0).isValid();
+                Q_UNUSED(valid)
+            }
+        });
+        run("LogEntry/gui", guiLines.count(), guiLinesSize, [&]() {
+            for (QByteArray const &line: guiLines) {
+                volatile bool const valid = LogEntry(line, LogEntry::Format::BridgeGUI_3_4_0).isValid();
+                Q_UNUSED(valid)
+            }
+        });
+
+        SPLog const bridgeLog = std::make_shared<Log>(bridgePath);
+        SPLog const guiLog = std::make_shared<Log>(guiPath);
+        qint64 const bridgeEntryCount = bridgeLog->entries().count();
+        run("Log::open/bridge", bridgeEntryCount, bridgeFileSize, [&]() { Log log(bridgePath); });
+        run("Log::open/gui", guiLog->entries().count(), guiFileSize, [&]() { Log log(guiPath); });
+
+        FilterModel filter(bridgeLog);
+        run("FilterModel/text", bridgeEntryCount, bridgeFileSize, refilterFunction(filter,
+            [](FilterModel &f) { f.setTextFilter("failed"); }, [](FilterModel &f) { f.setTextFilter(QString()); }));
+        run("FilterModel/package", bridgeEntryCount, bridgeFileSize, refilterFunction(filter,
+            [](FilterModel &f) { f.setPackageFilter("imap"); }, [](FilterModel &f) { f.setPackageFilter(QString()); }));
+        run("FilterModel/level", bridgeEntryCount, bridgeFileSize, refilterFunction(filter,
+            [](FilterModel &f) { f.setLevel(LogEntry::Level::Warn); }, [](FilterModel &f) { f.setLevel(LogEntry::Level::Trace); }));
+
+        int const rowCount = bridgeLog->rowCount(QModelIndex());
+        int const columnCount = bridgeLog->columnCount(QModelIndex());
+        QList<std::pair<int, QString>> const roles = { { Qt::DisplayRole, "display" }, { Qt::ForegroundRole, "foreground" },
+            { Qt::BackgroundRole, "background" } };
+        for (auto const &[role, roleName]: roles) {
+            for (int column = 0; column < columnCount; ++column) {
+                QString const name = QString("Log::data/%1/%2").arg(bridgeLog->headerData(column, Qt::Horizontal, Qt::DisplayRole).toString(),
+                    roleName);
+                run(name, rowCount, bridgeFileSize, [&, column, role]() {
+                    for (int row = 0; row < rowCount; ++row) {
+                        volatile bool const valid = bridgeLog->data(bridgeLog->index(row, column), role).isValid();
+                        Q_UNUSED(valid)
+                    }
+                });
+            }
+        }
+
+        run("LogEntry::dateTime", bridgeEntryCount, bridgeFileSize, [&]() {
+            for (LogEntry const &entry: bridgeLog->entries()) {
+                volatile bool const valid = entry.dateTime().isValid();
+                Q_UNUSED(valid)
+            }
+        });
+
+        QJsonArray array;
+        for (Result const &result: results) {
+            array.append(resultToJson(result));
+        }
+        QJsonObject const root {
+            { "version", QCoreApplication::applicationVersion() },
+            { "threadCount", qint64(std::thread::hardware_concurrency()) },
+            { "minDurationMs", minDurationMs },
+            { "results", array },
+        };
+        QByteArray const json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+        QString const outputPath = parser.value(optOutput);
+        if (outputPath.isEmpty()) {
+            QTextStream(stdout) << json;
+        } else {
+            QFile file(outputPath);
+            if ((!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) || (file.write(json) != json.size())) {
+                throw Exception(QString("Could not write to '%1'.").arg(QDir::toNativeSeparators(outputPath)));
+            }
+        }
+        return EXIT_SUCCESS;
+    } catch (Exception const &e) {
+        err << e.message() << '\n';
+    } catch (std::exception const &e) {
+        err << e.what() << '\n';
+    } catch (...) {
+        err << "A fatal error occurred.\n";
+    }
+    return EXIT_FAILURE;
+}
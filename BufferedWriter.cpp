@@ -0,0 +1,123 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of buffered file writer class.
+
+
+#include "BufferedWriter.h"
+#include "Exception.h"
+
+
+//****************************************************************************************************************************************************
+/// \param[in] filePath The path of the file. The file is truncated if it exists.
+/// \param[in] capacity The capacity of the buffer in bytes.
+/// \throw Exception if the file cannot be opened.
+//****************************************************************************************************************************************************
+BufferedWriter::BufferedWriter(QString const &filePath, qsizetype capacity)
+    : file_(filePath),
+      buffer_(qMax(qsizetype(4096), capacity), Qt::Uninitialized) {
+    if (!file_.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        throw Exception(QString("The file '%1' could not be opened for writing.").arg(QDir::toNativeSeparators(filePath)));
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] c The character.
+//****************************************************************************************************************************************************
+void BufferedWriter::append(char c) {
+    this->reserve(1);
+    buffer_.data()[size_++] = c;
+    ++bytesWritten_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] bytes The bytes.
+//****************************************************************************************************************************************************
+void BufferedWriter::append(QByteArrayView bytes) {
+    if (bytes.size() > buffer_.size()) {
+        this->flush();
+        if (file_.write(bytes.data(), bytes.size()) != bytes.size()) {
+            throw Exception(QString("Error writing to '%1': %2").arg(QDir::toNativeSeparators(file_.fileName()), file_.errorString()));
+        }
+        bytesWritten_ += bytes.size();
+        return;
+    }
+    this->reserve(bytes.size());
+    memcpy(buffer_.data() + size_, bytes.data(), bytes.size());
+    size_ += bytes.size();
+    bytesWritten_ += bytes.size();
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] str The string.
+//****************************************************************************************************************************************************
+void BufferedWriter::append(QStringView str) {
+    // Very long strings are split so that their encoded form always fits in the buffer.
+    qsizetype const maxChunk = buffer_.size() / 4;
+    while (str.size() > maxChunk) {
+        qsizetype split = maxChunk;
+        if (str[split - 1].isHighSurrogate()) {
+            --split;
+        }
+        this->append(str.first(split));
+        str = str.sliced(split);
+    }
+    this->reserve(encoder_.requiredSpace(str.size()));
+    char *const begin = buffer_.data() + size_;
+    char const *const end = encoder_.appendToBuffer(begin, str);
+    size_ += end - begin;
+    bytesWritten_ += end - begin;
+}
+
+
+//****************************************************************************************************************************************************
+/// \throw Exception if the write operation fails.
+//****************************************************************************************************************************************************
+void BufferedWriter::flush() {
+    if (size_ == 0) {
+        return;
+    }
+    if (file_.write(buffer_.constData(), size_) != size_) {
+        throw Exception(QString("Error writing to '%1': %2").arg(QDir::toNativeSeparators(file_.fileName()), file_.errorString()));
+    }
+    size_ = 0;
+}
+
+
+//****************************************************************************************************************************************************
+/// \throw Exception if the write operation fails.
+//****************************************************************************************************************************************************
+void BufferedWriter::close() {
+    this->flush();
+    file_.close();
+}
+
+
+//****************************************************************************************************************************************************
+/// This function is used before removing a partially written file, and never fails.
+//****************************************************************************************************************************************************
+void BufferedWriter::discard() {
+    size_ = 0;
+    file_.close();
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The number of bytes appended to the writer so far.
+//****************************************************************************************************************************************************
+qint64 BufferedWriter::bytesWritten() const {
+    return bytesWritten_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] size The number of bytes. Must not exceed the capacity of the buffer.
+//****************************************************************************************************************************************************
+void BufferedWriter::reserve(qsizetype size) {
+    if (size_ + size > buffer_.size()) {
+        this->flush();
+    }
+}
@@ -0,0 +1,49 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of buffered file writer class.
+
+
+#ifndef ANALOG_BUFFERED_WRITER_H
+#define ANALOG_BUFFERED_WRITER_H
+
+
+//****************************************************************************************************************************************************
+/// \brief Buffered file writer class.
+///
+/// Text is appended to a large memory buffer, that is written to the file when full. Strings are encoded to UTF-8 directly into the buffer,
+/// without intermediate allocation. Errors are reported by throwing an Exception.
+//****************************************************************************************************************************************************
+class BufferedWriter {
+public: // static members
+    static qsizetype constexpr defaultCapacity = 4 * 1024 * 1024; ///< The default capacity of the buffer.
+
+public: // member functions.
+    explicit BufferedWriter(QString const &filePath, qsizetype capacity = defaultCapacity); ///< Default constructor.
+    BufferedWriter(BufferedWriter const &) = delete; ///< Disabled copy-constructor.
+    BufferedWriter(BufferedWriter &&) = delete; ///< Disabled assignment copy-constructor.
+    ~BufferedWriter() = default; ///< Destructor.
+    BufferedWriter& operator=(BufferedWriter const &) = delete; ///< Disabled assignment operator.
+    BufferedWriter& operator=(BufferedWriter &&) = delete; ///< Disabled move assignment operator.
+
+    void append(char c); ///< Append a character.
+    void append(QByteArrayView bytes); ///< Append raw bytes.
+    void append(QStringView str); ///< Append a string, encoded as UTF-8.
+    void flush(); ///< Write the content of the buffer to the file.
+    void close(); ///< Flush the buffer and close the file.
+    void discard(); ///< Close the file without writing the content of the buffer.
+    qint64 bytesWritten() const; ///< Return the number of bytes appended so far.
+
+private: // member functions.
+    void reserve(qsizetype size); ///< Make sure the buffer has room for a number of bytes.
+
+private: // data members
+    QFile file_; ///< The file.
+    QByteArray buffer_; ///< The buffer.
+    qsizetype size_ { 0 }; ///< The number of bytes used in the buffer.
+    qint64 bytesWritten_ { 0 }; ///< The number of bytes appended so far.
+    QStringEncoder encoder_ { QStringEncoder::Utf8 }; ///< The UTF-8 encoder.
+};
+
+
+#endif //ANALOG_BUFFERED_WRITER_H
@@ -0,0 +1,171 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of burst detector class.
+
+
+#include "BurstDetector.h"
+
+
+namespace {
+qsizetype constexpr maxLabelLength = 80; ///< The maximum length of the template part of labels.
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] timestamp The timestamp.
+/// \return The timestamp as a string, without milliseconds.
+//****************************************************************************************************************************************************
+QString timestampToSecondString(qint64 timestamp) {
+    QString result = LogEntry::timestampToString(timestamp);
+    result.chop(4);
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return A human readable description of the anomaly.
+//****************************************************************************************************************************************************
+QString BurstDetector::Anomaly::toString() const {
+    return QString("%1 - %2: %3 burst, %4 entries/min (expected %5)").arg(timestampToSecondString(startTimestamp),
+        timestampToSecondString(endTimestamp).right(8), label).arg(peakCount).arg(expectedCount, 0, 'f', 1);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] packages The package dictionary.
+/// \param[in] templates The text of the message templates, indexed by template id.
+//****************************************************************************************************************************************************
+BurstDetector::BurstDetector(QStringList const &packages, QStringList const &templates)
+    : packages_(packages),
+      templates_(templates),
+      packageCounters_(packages.size()),
+      templateCounters_(templates.size()) {
+}
+
+
+//****************************************************************************************************************************************************
+/// Entries must be added in row order. Entries whose timestamp is invalid, or older than a previous entry, are considered to happen at the
+/// largest timestamp seen so far, so the window always moves forward.
+///
+/// \param[in] timestamp The timestamp of the entry.
+/// \param[in] level The level of the entry.
+/// \param[in] packageId The package id of the entry, or -1.
+/// \param[in] templateId The template id of the entry, or -1.
+//****************************************************************************************************************************************************
+void BurstDetector::addEntry(qint64 timestamp, LogEntry::Level level, qint32 packageId, qint32 templateId) {
+    ++entryCount_;
+    clock_ = qMax(clock_, timestamp);
+    if (clock_ < 0) {
+        return;
+    }
+    if (firstTimestamp_ < 0) {
+        firstTimestamp_ = clock_;
+    }
+
+    while ((!window_.empty()) && (window_.front().timestamp <= clock_ - windowWidth)) {
+        WindowEntry const &entry = window_.front();
+        evict(lineCounter_);
+        evict(levelCounters_[qsizetype(entry.level)]);
+        if (entry.packageId >= 0) {
+            evict(packageCounters_[entry.packageId]);
+        }
+        if (entry.templateId >= 0) {
+            evict(templateCounters_[entry.templateId]);
+        }
+        window_.pop_front();
+    }
+
+    packageId = (packageId < packageCounters_.size()) ? packageId : -1;
+    templateId = (templateId < templateCounters_.size()) ? templateId : -1;
+    window_.push_back({ clock_, level, packageId, templateId });
+    this->increment(lineCounter_, Kind::LineRate, -1, clock_);
+    this->increment(levelCounters_[qsizetype(level)], Kind::Level, qint32(level), clock_);
+    if (packageId >= 0) {
+        this->increment(packageCounters_[packageId], Kind::Package, packageId, clock_);
+    }
+    if (templateId >= 0) {
+        this->increment(templateCounters_[templateId], Kind::Template, templateId, clock_);
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The anomalies, sorted by start time.
+//****************************************************************************************************************************************************
+QList<BurstDetector::Anomaly> const &BurstDetector::anomalies() const {
+    return anomalies_;
+}
+
+
+//****************************************************************************************************************************************************
+/// The baseline of a counter is the average rate of the entries that have left the window. Detection only starts once the baseline covers
+/// warmUpDuration.
+///
+/// \param[in] counter The counter.
+/// \param[in] kind The kind of the counter.
+/// \param[in] key The key of the counter.
+/// \param[in] timestamp The timestamp of the entry, i.e. the end of the window.
+//****************************************************************************************************************************************************
+void BurstDetector::increment(Counter &counter, Kind kind, qint32 key, qint64 timestamp) {
+    ++counter.windowCount;
+    qint64 const windowStart = timestamp - windowWidth;
+    qint64 const baselineDuration = windowStart - firstTimestamp_;
+    if ((baselineDuration < warmUpDuration) || (counter.windowCount < minBurstCount)) {
+        return;
+    }
+    double const expected = double(counter.evictedCount) * double(windowWidth) / double(baselineDuration);
+    if (double(counter.windowCount) < minBurstRatio * expected) {
+        return;
+    }
+
+    if (counter.openAnomaly >= 0) {
+        Anomaly &anomaly = anomalies_[counter.openAnomaly];
+        if (anomaly.endTimestamp >= windowStart) {
+            anomaly.endTimestamp = timestamp;
+            if (counter.windowCount > anomaly.peakCount) {
+                anomaly.peakCount = counter.windowCount;
+                anomaly.expectedCount = expected;
+            }
+            return;
+        }
+    }
+    if (anomalies_.count() >= maxAnomalyCount) {
+        return;
+    }
+    counter.openAnomaly = qint32(anomalies_.count());
+    anomalies_.append(Anomaly { kind, key, this->label(kind, key), windowStart, timestamp, qint32(entryCount_ - qsizetype(window_.size())),
+        counter.windowCount, expected });
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] counter The counter.
+//****************************************************************************************************************************************************
+void BurstDetector::evict(Counter &counter) {
+    --counter.windowCount;
+    ++counter.evictedCount;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] kind The kind of the counter.
+/// \param[in] key The key of the counter.
+/// \return The label of the counter.
+//****************************************************************************************************************************************************
+QString BurstDetector::label(Kind kind, qint32 key) const {
+    switch (kind) {
+    case Kind::LineRate:
+        return "line rate";
+    case Kind::Level:
+        return QString("%1 level").arg(LogEntry::levelToString(LogEntry::Level(key)));
+    case Kind::Package:
+        return QString("package '%1'").arg(packages_[key]);
+    case Kind::Template: {
+        QString const text = templates_[key];
+        return QString("message '%1'").arg((text.size() > maxLabelLength) ? text.left(maxLabelLength) + "..." : text);
+    }
+    default:
+        return {};
+    }
+}
@@ -0,0 +1,96 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of burst detector class.
+
+
+#ifndef ANALOG_BURST_DETECTOR_H
+#define ANALOG_BURST_DETECTOR_H
+
+
+#include "LogEntry.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Burst detector class.
+///
+/// The detector streams over the entries in row order, and maintains the number of entries in a sliding time window, for the whole log, for
+/// each level, for each package and for each message template. Entries leaving the window are accumulated into a baseline, i.e. the average
+/// rate observed so far. A window is flagged when a count exceeds its baseline by a large factor. Consecutive flagged windows for the same
+/// counter are merged into a single anomaly. Each entry is added to and removed from the window once, with O(1) work, so the detection is O(n).
+//****************************************************************************************************************************************************
+class BurstDetector {
+public: // data types
+    enum class Kind {
+        LineRate = 0,
+        Level = 1,
+        Package = 2,
+        Template = 3,
+    }; ///< Enumeration for the kinds of counters.
+
+    struct Anomaly {
+        Kind kind { Kind::LineRate }; ///< The kind of counter that triggered the anomaly.
+        qint32 key { -1 }; ///< The level, package id or template id of the counter, or -1 for the line rate.
+        QString label; ///< A human readable description of the counter.
+        qint64 startTimestamp { LogEntry::invalidTimestamp }; ///< The start of the first flagged window.
+        qint64 endTimestamp { LogEntry::invalidTimestamp }; ///< The end of the last flagged window.
+        qint32 firstRow { -1 }; ///< The first row of the first flagged window.
+        qsizetype peakCount { 0 }; ///< The largest number of entries in a window.
+        double expectedCount { 0.0 }; ///< The number of entries expected in a window at the peak, according to the baseline.
+
+        QString toString() const; ///< Return a human readable description of the anomaly.
+    }; ///< Structure for anomalies.
+
+public: // static members
+    static qint64 constexpr windowWidth = 60 * 1000; ///< The width of the sliding window, in milliseconds.
+    static qint64 constexpr warmUpDuration = 5 * 60 * 1000; ///< The duration of the log used to establish the baseline before detection starts.
+    static qsizetype constexpr minBurstCount = 20; ///< The minimum number of entries in a window for a burst.
+    static double constexpr minBurstRatio = 4.0; ///< The minimum ratio between the window count and the expected count for a burst.
+    static qsizetype constexpr maxAnomalyCount = 1000; ///< The maximum number of anomalies reported.
+
+public: // member functions.
+    BurstDetector(QStringList const &packages, QStringList const &templates); ///< Default constructor.
+    BurstDetector(BurstDetector const &) = delete; ///< Disabled copy-constructor.
+    BurstDetector(BurstDetector &&) = delete; ///< Disabled assignment copy-constructor.
+    ~BurstDetector() = default; ///< Destructor.
+    BurstDetector& operator=(BurstDetector const &) = delete; ///< Disabled assignment operator.
+    BurstDetector& operator=(BurstDetector &&) = delete; ///< Disabled move assignment operator.
+
+    void addEntry(qint64 timestamp, LogEntry::Level level, qint32 packageId, qint32 templateId); ///< Add the next entry.
+    QList<Anomaly> const &anomalies() const; ///< Return the anomalies, sorted by start time.
+
+private: // data types
+    struct Counter {
+        qsizetype windowCount { 0 }; ///< The number of entries in the window.
+        qsizetype evictedCount { 0 }; ///< The number of entries that have left the window.
+        qint32 openAnomaly { -1 }; ///< The index of the last anomaly of the counter, or -1.
+    }; ///< Structure for counters.
+
+    struct WindowEntry {
+        qint64 timestamp; ///< The timestamp of the entry.
+        LogEntry::Level level; ///< The level of the entry.
+        qint32 packageId; ///< The package id of the entry.
+        qint32 templateId; ///< The template id of the entry.
+    }; ///< Structure for the entries in the window.
+
+private: // member functions.
+    void increment(Counter &counter, Kind kind, qint32 key, qint64 timestamp); ///< Increment a counter and check it for a burst.
+    static void evict(Counter &counter); ///< Remove an entry from a counter.
+    QString label(Kind kind, qint32 key) const; ///< Return the label of a counter.
+
+private: // data members
+    QStringList packages_; ///< The package dictionary.
+    QStringList templates_; ///< The text of the message templates.
+    Counter lineCounter_; ///< The counter for all entries.
+    std::array<Counter, LogEntry::levelCount> levelCounters_; ///< The counters for each level.
+    QList<Counter> packageCounters_; ///< The counters for each package.
+    QList<Counter> templateCounters_; ///< The counters for each template.
+    std::deque<WindowEntry> window_; ///< The entries in the window.
+    qint64 firstTimestamp_ { LogEntry::invalidTimestamp }; ///< The timestamp of the first entry.
+    qint64 clock_ { LogEntry::invalidTimestamp }; ///< The largest timestamp seen so far.
+    qint32 entryCount_ { 0 }; ///< The number of entries added so far.
+    QList<Anomaly> anomalies_; ///< The anomalies.
+};
+
+
+#endif //ANALOG_BURST_DETECTOR_H
@@ -0,0 +1,160 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of the command-line tool entry-point.
+
+
+#include "Exception.h"
+#include "FilterModel.h"
+#include "Instrumentation.h"
+#include "LogExporter.h"
+
+
+namespace {
+QString const optLevel = "level"; ///< The name of the level option.
+QString const optStrictLevel = "strict-level"; ///< The name of the strict level option.
+QString const optPackage = "package"; ///< The name of the package option.
+QString const optText = "text"; ///< The name of the text option.
+QString const optSummary = "summary"; ///< The name of the summary option.
+QString const optCount = "count"; ///< The name of the count option.
+QString const optOutput = "output"; ///< The name of the output option.
+QString const optFormat = "format"; ///< The name of the format option.
+QString const optTimings = "timings"; ///< The name of the timings option.
+}
+
+
+//****************************************************************************************************************************************************
+/// The string can be the name of a level, or any prefix of it, e.g. 'warn' for 'warning'.
+///
+/// \param[in] str The string.
+/// \return The level.
+//****************************************************************************************************************************************************
+LogEntry::Level parseLevel(QString const &str) {
+    QString const lower = str.trimmed().toLower();
+    for (qsizetype i = 0; i < LogEntry::levelCount; ++i) {
+        LogEntry::Level const level = LogEntry::Level(i);
+        if ((!lower.isEmpty()) && LogEntry::levelToString(level).startsWith(lower)) {
+            return level;
+        }
+    }
+    throw Exception(QString("'%1' is not a valid log level.").arg(str));
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] str The string.
+/// \return The export format.
+//****************************************************************************************************************************************************
+LogExporter::Format parseFormat(QString const &str) {
+    QString const lower = str.trimmed().toLower();
+    if (lower == "csv") {
+        return LogExporter::Format::CSV;
+    }
+    if ((lower == "jsonl") || (lower == "json")) {
+        return LogExporter::Format::JSONLines;
+    }
+    if (lower == "logfmt") {
+        return LogExporter::Format::Logfmt;
+    }
+    throw Exception(QString("'%1' is not a valid export format.").arg(str));
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] log The log.
+/// \param[in] rows The rows to print.
+/// \param[in] out The stream to print to.
+//****************************************************************************************************************************************************
+void printRows(Log const &log, QList<qint32> const &rows, QTextStream &out) {
+    QList<LogEntry> const &entries = log.entries();
+    for (qint32 const row: rows) {
+        LogEntry const &entry = entries[row];
+        out << LogEntry::timestampToString(entry.timestamp()) << ' ' << LogEntry::levelToString(entry.level()) << ' ' << entry.package()
+            << ' ' << entry.message();
+        QString const fields = entry.fieldsString();
+        if (!fields.isEmpty()) {
+            out << ' ' << fields;
+        }
+        out << '\n';
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] argc The number of command-line arguments.
+/// \param[in] argv The list of command-line arguments.
+//****************************************************************************************************************************************************
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("analog-cli");
+    QCoreApplication::setApplicationVersion(QString("%1").arg(ANALOG_VERSION));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Parse and filter Bridge and bridge-gui log files.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addOptions({
+        { { "l", optLevel }, "Only keep entries of at least the given level (trace, debug, info, warning, error, fatal or panic).", "level" },
+        { optStrictLevel, "Only keep entries of exactly the level given with --level." },
+        { { "p", optPackage }, "Only keep entries whose package contains the given text.", "filter" },
+        { { "t", optText }, "Only keep entries whose message or fields contain the given text.", "filter" },
+        { { "s", optSummary }, "Print a summary report of the whole log instead of the matching entries." },
+        { { "c", optCount }, "Print the number of matching entries instead of the entries." },
+        { { "o", optOutput }, "Export the matching entries to a file instead of printing them.", "path" },
+        { { "f", optFormat }, "The format of the exported file (csv, jsonl or logfmt). The default is csv.", "format", "csv" },
+        { optTimings, "Save the time spent in each stage of loading and filtering as JSON to the given file.", "path" },
+    });
+    parser.addPositionalArgument("files", "The ordered list of files forming the log.", "files...");
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    try {
+        QStringList const filePaths = parser.positionalArguments();
+        if (filePaths.isEmpty()) {
+            parser.showHelp(EXIT_FAILURE);
+        }
+
+        FilterModel filter;
+        if (parser.isSet(optLevel)) {
+            filter.setLevel(parseLevel(parser.value(optLevel)));
+        }
+        filter.setUseStrictLevelFilter(parser.isSet(optStrictLevel));
+        filter.setPackageFilter(parser.value(optPackage));
+        filter.setTextFilter(parser.value(optText));
+        LogExporter::Format const format = parseFormat(parser.value(optFormat));
+        Instrumentation::setEnabled(parser.isSet(optTimings));
+
+        SPLog const log = std::make_shared<Log>(filePaths);
+        for (QString const &error: log->errors()) {
+            err << error << '\n';
+        }
+        err.flush();
+
+        if (parser.isSet(optSummary)) {
+            out << log->generateReport().toString();
+        } else {
+            filter.setLog(log);
+            QList<qint32> const rows = filter.visibleSourceRows();
+            if (parser.isSet(optCount)) {
+                out << rows.count() << '\n';
+            } else if (parser.isSet(optOutput)) {
+                std::atomic_bool const cancelled { false };
+                LogExporter::exportRows(*log, rows, parser.value(optOutput), format, {}, cancelled);
+            } else {
+                printRows(*log, rows, out);
+            }
+        }
+        if (parser.isSet(optTimings)) {
+            Instrumentation::saveJson(parser.value(optTimings));
+        }
+        return EXIT_SUCCESS;
+    } catch (Exception const &e) {
+        err << e.message() << '\n';
+    } catch (std::exception const &e) {
+        err << e.what() << '\n';
+    } catch (...) {
+        err << "A fatal error occurred.\n";
+    }
+    return EXIT_FAILURE;
+}
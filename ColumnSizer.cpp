@@ -0,0 +1,153 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of column sizer class.
+
+
+#include "ColumnSizer.h"
+
+
+namespace {
+int constexpr headRowCount = 200; ///< The number of rows sampled at the beginning of the model.
+int constexpr tailRowCount = 200; ///< The number of rows sampled at the end of the model.
+int constexpr strideRowCount = 600; ///< The number of rows sampled in the middle of the model, one at a random offset in each stride.
+quint32 constexpr samplingSeed = 0x5eed; ///< The seed of the random offsets, fixed so that estimates are reproducible.
+int constexpr cellPadding = 16; ///< The horizontal padding added to measured text widths.
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] view The table view. The sizer is a child of the view.
+//****************************************************************************************************************************************************
+ColumnSizer::ColumnSizer(QTableView *view)
+    : QObject(view),
+      view_(view) {
+    connect(view_->verticalScrollBar(), &QScrollBar::valueChanged, this, &ColumnSizer::refineVisibleRows);
+    connect(view_->horizontalHeader(), &QHeaderView::sectionResized, this, &ColumnSizer::onSectionResized);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] column The column.
+/// \param[in] width The maximum width, in pixels.
+//****************************************************************************************************************************************************
+void ColumnSizer::setMaximumWidth(int column, int width) {
+    maxWidths_[column] = width;
+}
+
+
+//****************************************************************************************************************************************************
+/// The cost of the estimation does not depend on the number of rows in the model. In the middle of the model, one row is sampled at a random
+/// offset in each stride, so periodic logs, e.g. with a long line every N rows, do not alias with the sampling.
+//****************************************************************************************************************************************************
+void ColumnSizer::estimate() {
+    userSizedColumns_.clear();
+    QAbstractItemModel const *model = view_->model();
+    if (!model) {
+        return;
+    }
+
+    QFontMetrics const metrics(view_->font());
+    QHeaderView const *header = view_->horizontalHeader();
+    QList<int> widths(this->lastSizedColumn());
+    for (int column = 0; column < widths.count(); ++column) {
+        widths[column] = header->sectionSizeHint(column);
+    }
+
+    int const rowCount = model->rowCount();
+    int const headEnd = qMin(rowCount, headRowCount);
+    for (int row = 0; row < headEnd; ++row) {
+        this->measureRow(row, metrics, widths);
+    }
+    int const tailStart = qMax(headEnd, rowCount - tailRowCount);
+    for (int row = tailStart; row < rowCount; ++row) {
+        this->measureRow(row, metrics, widths);
+    }
+    if (tailStart > headEnd) {
+        QRandomGenerator random(samplingSeed);
+        int const stride = qMax(1, (tailStart - headEnd) / strideRowCount);
+        for (int start = headEnd; start < tailStart; start += stride) {
+            int const end = qMin(start + stride, tailStart);
+            this->measureRow(start + int(random.bounded(end - start)), metrics, widths);
+        }
+    }
+
+    this->applyWidths(widths, false);
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void ColumnSizer::refineVisibleRows() {
+    QAbstractItemModel const *model = view_->model();
+    if ((!model) || (model->rowCount() == 0)) {
+        return;
+    }
+    int const first = qMax(0, view_->rowAt(0));
+    int last = view_->rowAt(view_->viewport()->height() - 1);
+    last = (last < 0) ? model->rowCount() - 1 : last;
+
+    QFontMetrics const metrics(view_->font());
+    QList<int> widths(this->lastSizedColumn(), 0);
+    for (int row = first; row <= last; ++row) {
+        this->measureRow(row, metrics, widths);
+    }
+    this->applyWidths(widths, true);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] column The column.
+//****************************************************************************************************************************************************
+void ColumnSizer::onSectionResized(int column, int, int) {
+    if (!resizing_) {
+        userSizedColumns_.insert(column);
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] row The row.
+/// \param[in] metrics The font metrics.
+/// \param[in,out] widths The widths, updated with the cells of the row.
+//****************************************************************************************************************************************************
+void ColumnSizer::measureRow(int row, QFontMetrics const &metrics, QList<int> &widths) const {
+    QAbstractItemModel const *model = view_->model();
+    for (int column = 0; column < widths.count(); ++column) {
+        QString const text = model->data(model->index(row, column), Qt::DisplayRole).toString();
+        widths[column] = qMax(widths[column], metrics.horizontalAdvance(text) + cellPadding);
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// When refining, columns are only grown, never shrunk, so the table does not jitter while scrolling.
+///
+/// \param[in] widths The widths.
+/// \param[in] growOnly Should the columns only be grown.
+//****************************************************************************************************************************************************
+void ColumnSizer::applyWidths(QList<int> const &widths, bool growOnly) {
+    resizing_ = true;
+    for (int column = 0; column < widths.count(); ++column) {
+        if (userSizedColumns_.contains(column)) {
+            continue;
+        }
+        int const width = qMin(widths[column], maxWidths_.value(column, std::numeric_limits<int>::max()));
+        if ((!growOnly) || (width > view_->columnWidth(column))) {
+            view_->setColumnWidth(column, width);
+        }
+    }
+    resizing_ = false;
+}
+
+
+//****************************************************************************************************************************************************
+/// The last column is stretched by the view when the header is configured to do so, so it is not sized.
+///
+/// \return The index past the last column handled by the sizer.
+//****************************************************************************************************************************************************
+int ColumnSizer::lastSizedColumn() const {
+    int const count = view_->model() ? view_->model()->columnCount() : 0;
+    return view_->horizontalHeader()->stretchLastSection() ? qMax(0, count - 1) : count;
+}
@@ -0,0 +1,51 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of column sizer class.
+
+
+#ifndef ANALOG_COLUMN_SIZER_H
+#define ANALOG_COLUMN_SIZER_H
+
+
+//****************************************************************************************************************************************************
+/// \brief Column sizer class.
+///
+/// Contrary to QTableView::resizeColumnsToContents(), which measures every row of the model, the sizer estimates column widths from a bounded
+/// sample of rows (head, tail and regular strides), then refines them lazily as rows scroll into view. Widths only grow, and columns resized
+/// by the user are left untouched.
+//****************************************************************************************************************************************************
+class ColumnSizer : public QObject {
+    Q_OBJECT
+
+public: // member functions.
+    explicit ColumnSizer(QTableView *view); ///< Default constructor.
+    ColumnSizer(ColumnSizer const &) = delete; ///< Disabled copy-constructor.
+    ColumnSizer(ColumnSizer &&) = delete; ///< Disabled assignment copy-constructor.
+    ~ColumnSizer() override = default; ///< Destructor.
+    ColumnSizer& operator=(ColumnSizer const &) = delete; ///< Disabled assignment operator.
+    ColumnSizer& operator=(ColumnSizer &&) = delete; ///< Disabled move assignment operator.
+
+    void setMaximumWidth(int column, int width); ///< Set the maximum width for a column.
+    void estimate(); ///< Estimate the column widths from a sample of rows.
+
+public slots:
+    void refineVisibleRows(); ///< Grow the column widths to fit the visible rows.
+
+private slots:
+    void onSectionResized(int column, int oldSize, int newSize); ///< Slot for the resizing of a column.
+
+private: // member functions.
+    void measureRow(int row, QFontMetrics const &metrics, QList<int> &widths) const; ///< Measure the cells of a row.
+    void applyWidths(QList<int> const &widths, bool growOnly); ///< Apply the measured widths to the view.
+    int lastSizedColumn() const; ///< Return the index past the last column handled by the sizer.
+
+private: // data members.
+    QTableView *view_ { nullptr }; ///< The table view.
+    QMap<int, int> maxWidths_; ///< The maximum widths of columns.
+    QSet<int> userSizedColumns_; ///< The columns resized by the user.
+    bool resizing_ { false }; ///< Set while the sizer is resizing columns.
+};
+
+
+#endif //ANALOG_COLUMN_SIZER_H
@@ -0,0 +1,23 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of pre-compiled headers for the core library
+
+
+#ifndef ANALOG_CORE_PCH_H
+#define ANALOG_CORE_PCH_H
+
+
+#include <QtCore>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <thread>
+
+
+#endif //ANALOG_CORE_PCH_H
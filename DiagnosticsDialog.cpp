@@ -0,0 +1,173 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of diagnostics dialog class.
+
+
+#include "DiagnosticsDialog.h"
+#include "Exception.h"
+#include "Instrumentation.h"
+#include "LogCache.h"
+
+
+namespace {
+
+
+int constexpr nameColumn = 0; ///< The index of the name column.
+int constexpr callCountColumn = 1; ///< The index of the call count column.
+int constexpr totalColumn = 2; ///< The index of the total duration column.
+int constexpr meanColumn = 3; ///< The index of the mean duration column.
+int constexpr maxColumn = 4; ///< The index of the max duration column.
+int constexpr refreshIntervalMs = 500; ///< The interval between two refreshes of the statistics, in milliseconds.
+int constexpr sizeColumn = 1; ///< The index of the size column in the memory tree.
+qint64 constexpr mebibyte = 1024 * 1024; ///< The number of bytes in a mebibyte.
+
+
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] parent The parent widget of the dialog.
+/// \param[in] memoryUsageProvider The function returning the memory usages shown in the dialog.
+//****************************************************************************************************************************************************
+DiagnosticsDialog::DiagnosticsDialog(QWidget *parent, MemoryUsageProvider memoryUsageProvider)
+    : QDialog(parent),
+      memoryUsageProvider_(std::move(memoryUsageProvider)) {
+    ui_.setupUi(this);
+
+    auto *stagesNode = new QTreeWidgetItem(ui_.tree, { "Stages" });
+    stagesNode->setFirstColumnSpanned(true);
+    stagesNode->setExpanded(true);
+    for (qsizetype i = 0; i < qsizetype(Instrumentation::Stage::Count); ++i) {
+        auto *item = new QTreeWidgetItem(stagesNode, { Instrumentation::stageName(Instrumentation::Stage(i)) });
+        for (int column = callCountColumn; column <= maxColumn; ++column) {
+            item->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+        }
+        stageItems_.append(item);
+    }
+    auto *countersNode = new QTreeWidgetItem(ui_.tree, { "Counters" });
+    countersNode->setFirstColumnSpanned(true);
+    countersNode->setExpanded(true);
+    for (qsizetype i = 0; i < qsizetype(Instrumentation::Counter::Count); ++i) {
+        auto *item = new QTreeWidgetItem(countersNode, { Instrumentation::counterName(Instrumentation::Counter(i)) });
+        item->setTextAlignment(callCountColumn, Qt::AlignRight | Qt::AlignVCenter);
+        counterItems_.append(item);
+    }
+
+    ui_.checkEnabled->setChecked(Instrumentation::isEnabled());
+    ui_.spinBudget->setValue(int(LogCache::budget() / mebibyte));
+    connect(ui_.checkEnabled, &QCheckBox::toggled, this, &DiagnosticsDialog::onEnabledToggled);
+    connect(ui_.buttonReset, &QPushButton::clicked, this, &DiagnosticsDialog::onReset);
+    connect(ui_.buttonSave, &QPushButton::clicked, this, &DiagnosticsDialog::onSave);
+    connect(ui_.buttonClose, &QPushButton::clicked, this, &QDialog::accept);
+    connect(ui_.spinBudget, &QSpinBox::valueChanged, this, &DiagnosticsDialog::onBudgetChanged);
+    connect(&refreshTimer_, &QTimer::timeout, this, &DiagnosticsDialog::refresh);
+    refreshTimer_.start(refreshIntervalMs);
+    this->refresh();
+    ui_.tree->resizeColumnToContents(nameColumn);
+    ui_.treeMemory->resizeColumnToContents(nameColumn);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] checked Is the check box checked?
+//****************************************************************************************************************************************************
+void DiagnosticsDialog::onEnabledToggled(bool checked) {
+    Instrumentation::setEnabled(checked);
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void DiagnosticsDialog::onReset() {
+    Instrumentation::reset();
+    this->refresh();
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void DiagnosticsDialog::onSave() {
+    QString const filePath = QFileDialog::getSaveFileName(this, tr("Save Diagnostics"), QString(), tr("JSON files (*.json);;All files (*.*)"));
+    if (filePath.isEmpty()) {
+        return;
+    }
+    QJsonObject memory;
+    for (std::pair<QString, MemoryUsage> const &usage: memoryUsageProvider_ ? memoryUsageProvider_() : QList<std::pair<QString, MemoryUsage>>()) {
+        memory.insert(usage.first, usage.second.toJson());
+    }
+    try {
+        Instrumentation::saveJson(filePath, { { "memory", memory }, { "memoryBudget", LogCache::budget() } });
+    } catch (Exception const &e) {
+        QMessageBox::critical(this, tr("Error"), e.message());
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] value The memory budget, in mebibytes.
+//****************************************************************************************************************************************************
+void DiagnosticsDialog::onBudgetChanged(int value) {
+    LogCache::setBudget(qint64(value) * mebibyte);
+    this->refreshMemory();
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void DiagnosticsDialog::refresh() {
+    Instrumentation::flushThread();
+    for (qsizetype i = 0; i < stageItems_.count(); ++i) {
+        Instrumentation::StageStats const stats = Instrumentation::stageStats(Instrumentation::Stage(i));
+        QTreeWidgetItem *item = stageItems_[i];
+        item->setText(callCountColumn, QString::number(stats.callCount));
+        item->setText(totalColumn, QString::number(double(stats.totalNs) / 1.0e6, 'f', 3));
+        item->setText(meanColumn, stats.callCount ? QString::number(double(stats.totalNs) / double(stats.callCount) / 1.0e3, 'f', 3) : QString());
+        item->setText(maxColumn, QString::number(double(stats.maxNs) / 1.0e6, 'f', 3));
+    }
+    for (qsizetype i = 0; i < counterItems_.count(); ++i) {
+        counterItems_[i]->setText(callCountColumn, QString::number(Instrumentation::count(Instrumentation::Counter(i))));
+    }
+    this->refreshMemory();
+}
+
+
+//****************************************************************************************************************************************************
+/// The tree is only rebuilt when the list of components changes, so the refresh does not reset the scroll position and selection.
+//****************************************************************************************************************************************************
+void DiagnosticsDialog::refreshMemory() {
+    QList<std::pair<QString, MemoryUsage>> const usages = memoryUsageProvider_ ? memoryUsageProvider_() : QList<std::pair<QString, MemoryUsage>>();
+    QStringList names;
+    QList<qint64> byteCounts;
+    for (std::pair<QString, MemoryUsage> const &usage: usages) {
+        names.append(usage.first);
+        byteCounts.append(usage.second.total());
+        for (MemoryUsage::Component const &component: usage.second.components()) {
+            names.append(component.name);
+            byteCounts.append(component.byteCount);
+        }
+    }
+
+    if (names != memoryNames_) {
+        ui_.treeMemory->clear();
+        memoryItems_.clear();
+        for (std::pair<QString, MemoryUsage> const &usage: usages) {
+            auto *node = new QTreeWidgetItem(ui_.treeMemory, { usage.first });
+            node->setExpanded(true);
+            memoryItems_.append(node);
+            for (MemoryUsage::Component const &component: usage.second.components()) {
+                memoryItems_.append(new QTreeWidgetItem(node, { component.name }));
+            }
+        }
+        for (QTreeWidgetItem *item: memoryItems_) {
+            item->setTextAlignment(sizeColumn, Qt::AlignRight | Qt::AlignVCenter);
+        }
+        memoryNames_ = names;
+    }
+    for (qsizetype i = 0; i < memoryItems_.count(); ++i) {
+        memoryItems_[i]->setText(sizeColumn, MemoryUsage::formatByteCount(byteCounts[i]));
+    }
+}
@@ -0,0 +1,56 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of diagnostics dialog class.
+
+
+#ifndef ANALOG_DIAGNOSTICS_DIALOG_H
+#define ANALOG_DIAGNOSTICS_DIALOG_H
+
+
+#include "ui_DiagnosticsDialog.h"
+#include "MemoryUsage.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Diagnostics dialog class.
+///
+/// The dialog shows the instrumentation statistics of the load and filter pipeline, and the estimated memory usage of the application. Both
+/// are refreshed periodically while the dialog is open.
+//****************************************************************************************************************************************************
+class DiagnosticsDialog : public QDialog {
+    Q_OBJECT
+
+public: // data types
+    typedef std::function<QList<std::pair<QString, MemoryUsage>>()> MemoryUsageProvider; ///< Type definition for functions returning named memory usages.
+
+public: // member functions.
+    DiagnosticsDialog(QWidget *parent, MemoryUsageProvider memoryUsageProvider); ///< Default constructor.
+    DiagnosticsDialog(DiagnosticsDialog const &) = delete; ///< Disabled copy-constructor.
+    DiagnosticsDialog(DiagnosticsDialog &&) = delete; ///< Disabled assignment copy-constructor.
+    ~DiagnosticsDialog() override = default; ///< Destructor.
+    DiagnosticsDialog& operator=(DiagnosticsDialog const &) = delete; ///< Disabled assignment operator.
+    DiagnosticsDialog& operator=(DiagnosticsDialog &&) = delete; ///< Disabled move assignment operator.
+
+private slots:
+    void onEnabledToggled(bool checked); ///< Slot for the toggling of the 'Enabled' check box.
+    void onReset(); ///< Slot for the 'Reset' button.
+    void onSave(); ///< Slot for the 'Save' button.
+    void onBudgetChanged(int value); ///< Slot for the change of the memory budget.
+    void refresh(); ///< Refresh the statistics.
+
+private: // member functions.
+    void refreshMemory(); ///< Refresh the memory usage.
+
+private: // data members
+    Ui::DiagnosticsDialog ui_ {}; ///< The UI for the dialog.
+    QList<QTreeWidgetItem *> stageItems_; ///< The tree items for the stages.
+    QList<QTreeWidgetItem *> counterItems_; ///< The tree items for the counters.
+    MemoryUsageProvider memoryUsageProvider_; ///< The function returning the memory usages.
+    QStringList memoryNames_; ///< The names of the memory components currently in the memory tree.
+    QList<QTreeWidgetItem *> memoryItems_; ///< The tree items for the memory components, including the group items.
+    QTimer refreshTimer_; ///< The timer for the periodic refresh of the statistics.
+};
+
+
+#endif //ANALOG_DIAGNOSTICS_DIALOG_H
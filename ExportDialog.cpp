@@ -0,0 +1,154 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of export dialog class.
+
+
+#include "ExportDialog.h"
+
+
+namespace {
+std::array<QString, 3> const fileExtensions { "csv", "jsonl", "log" }; ///< The file extension for each export format.
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] parent The parent widget of the dialog.
+/// \param[in] log The log.
+/// \param[in] visibleRows The source rows of the filtered view, in view order.
+//****************************************************************************************************************************************************
+ExportDialog::ExportDialog(QWidget *parent, SPLog log, QList<qint32> visibleRows)
+    : QDialog(parent),
+      log_(std::move(log)),
+      visibleRows_(std::move(visibleRows)) {
+    ui_.setupUi(this);
+    ui_.radioFilteredView->setText(QString("%1 (%2 entries)").arg(ui_.radioFilteredView->text()).arg(visibleRows_.count()));
+    ui_.radioWholeLog->setText(QString("%1 (%2 entries)").arg(ui_.radioWholeLog->text()).arg(log_ ? log_->entries().count() : 0));
+    connect(ui_.buttonBrowse, &QPushButton::clicked, this, &ExportDialog::onBrowse);
+    connect(ui_.buttonExport, &QPushButton::clicked, this, &ExportDialog::onExport);
+    connect(ui_.buttonCancel, &QPushButton::clicked, this, &ExportDialog::onCancel);
+    connect(ui_.buttonClose, &QPushButton::clicked, this, &QDialog::accept);
+    connect(ui_.editPath, &QLineEdit::textChanged, this, &ExportDialog::updateGUI);
+    for (QRadioButton *radio: { ui_.radioCSV, ui_.radioJSONLines, ui_.radioLogfmt }) {
+        connect(radio, &QRadioButton::toggled, this, &ExportDialog::onFormatChanged);
+    }
+    connect(&exporter_, &LogExporter::progress, this, &ExportDialog::onProgress);
+    connect(&exporter_, &LogExporter::finished, this, &ExportDialog::onFinished);
+    this->updateGUI();
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void ExportDialog::onBrowse() {
+    QString const extension = fileExtensions[qsizetype(this->format())];
+    QString const path = QFileDialog::getSaveFileName(this, tr("Export Log"), ui_.editPath->text(),
+        tr("%1 files (*.%2);;All files (*.*)").arg(extension.toUpper(), extension));
+    if (!path.isEmpty()) {
+        ui_.editPath->setText(QDir::toNativeSeparators(path));
+    }
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void ExportDialog::onExport() {
+    QString const path = QDir::fromNativeSeparators(ui_.editPath->text().trimmed());
+    if (path.isEmpty()) {
+        return;
+    }
+    if (QFileInfo::exists(path) && (QMessageBox::question(this, tr("Export Log"), tr("The file already exists. Overwrite it?"))
+        != QMessageBox::Yes)) {
+        return;
+    }
+    std::optional<QList<qint32>> rows;
+    if (ui_.radioFilteredView->isChecked()) {
+        rows = visibleRows_;
+    }
+    ui_.progressBar->setValue(0);
+    ui_.labelStatus->clear();
+    timer_.start();
+    exporter_.start(log_, rows, path, this->format());
+    this->updateGUI();
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void ExportDialog::onCancel() {
+    exporter_.cancel();
+    ui_.progressBar->setValue(0);
+    ui_.labelStatus->setText(tr("Export cancelled."));
+    this->updateGUI();
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] exportedRowCount The number of rows exported so far.
+/// \param[in] rowCount The total number of rows to export.
+//****************************************************************************************************************************************************
+void ExportDialog::onProgress(qsizetype exportedRowCount, qsizetype rowCount) {
+    ui_.progressBar->setValue((rowCount > 0) ? int(exportedRowCount * 100 / rowCount) : 100);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] success Did the export succeed.
+/// \param[in] byteCount The number of bytes written.
+/// \param[in] error The error message, if the export failed.
+//****************************************************************************************************************************************************
+void ExportDialog::onFinished(bool success, qint64 byteCount, QString const &error) {
+    this->updateGUI();
+    if (!success) {
+        ui_.labelStatus->clear();
+        QMessageBox::critical(this, tr("Error"), error);
+        return;
+    }
+    qint64 const elapsedMs = qMax(qint64(1), timer_.elapsed());
+    ui_.progressBar->setValue(100);
+    ui_.labelStatus->setText(tr("%1 written in %2 ms (%3 MB/s).").arg(QLocale().formattedDataSize(byteCount)).arg(elapsedMs)
+        .arg(double(byteCount) / 1000.0 / double(elapsedMs), 0, 'f', 1));
+}
+
+
+//****************************************************************************************************************************************************
+/// The extension of the file path is updated to match the format.
+//****************************************************************************************************************************************************
+void ExportDialog::onFormatChanged() {
+    QString path = ui_.editPath->text();
+    if (path.isEmpty()) {
+        return;
+    }
+    QFileInfo const info(path);
+    if (std::ranges::find(fileExtensions, info.suffix().toLower()) != fileExtensions.end()) {
+        path.chop(info.suffix().size());
+        ui_.editPath->setText(path + fileExtensions[qsizetype(this->format())]);
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The selected export format.
+//****************************************************************************************************************************************************
+LogExporter::Format ExportDialog::format() const {
+    if (ui_.radioJSONLines->isChecked()) {
+        return LogExporter::Format::JSONLines;
+    }
+    return ui_.radioLogfmt->isChecked() ? LogExporter::Format::Logfmt : LogExporter::Format::CSV;
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void ExportDialog::updateGUI() {
+    bool const running = exporter_.isRunning();
+    for (QWidget *widget: std::initializer_list<QWidget *> { ui_.groupScope, ui_.groupFormat, ui_.editPath, ui_.buttonBrowse }) {
+        widget->setEnabled(!running);
+    }
+    ui_.buttonExport->setEnabled((!running) && log_ && (!ui_.editPath->text().trimmed().isEmpty()));
+    ui_.buttonCancel->setEnabled(running);
+}
@@ -0,0 +1,50 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of export dialog class.
+
+
+#ifndef ANALOG_EXPORT_DIALOG_H
+#define ANALOG_EXPORT_DIALOG_H
+
+
+#include "ui_ExportDialog.h"
+#include "LogExporter.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Export dialog class.
+//****************************************************************************************************************************************************
+class ExportDialog : public QDialog {
+    Q_OBJECT
+
+public: // member functions.
+    ExportDialog(QWidget *parent, SPLog log, QList<qint32> visibleRows); ///< Default constructor.
+    ExportDialog(ExportDialog const &) = delete; ///< Disabled copy-constructor.
+    ExportDialog(ExportDialog &&) = delete; ///< Disabled assignment copy-constructor.
+    ~ExportDialog() override = default; ///< Destructor.
+    ExportDialog& operator=(ExportDialog const &) = delete; ///< Disabled assignment operator.
+    ExportDialog& operator=(ExportDialog &&) = delete; ///< Disabled move assignment operator.
+
+private slots:
+    void onBrowse(); ///< Slot for the 'Browse' button.
+    void onExport(); ///< Slot for the 'Export' button.
+    void onCancel(); ///< Slot for the 'Cancel' button.
+    void onProgress(qsizetype exportedRowCount, qsizetype rowCount); ///< Slot for the progress of the export.
+    void onFinished(bool success, qint64 byteCount, QString const &error); ///< Slot for the completion of the export.
+    void onFormatChanged(); ///< Slot for the change of the export format.
+
+private: // member functions.
+    LogExporter::Format format() const; ///< Return the selected export format.
+    void updateGUI(); ///< Update the state of the controls.
+
+private: // data members
+    Ui::ExportDialog ui_ {}; ///< The UI for the dialog.
+    SPLog log_; ///< The log.
+    QList<qint32> visibleRows_; ///< The source rows of the filtered view, in view order.
+    LogExporter exporter_; ///< The exporter.
+    QElapsedTimer timer_; ///< The timer measuring the duration of the export.
+};
+
+
+#endif //ANALOG_EXPORT_DIALOG_H
@@ -0,0 +1,110 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of field facet index class.
+
+
+#include "FacetIndex.h"
+#include "MemoryUsage.h"
+
+
+//****************************************************************************************************************************************************
+/// \return true iff some values of the key were not indexed.
+//****************************************************************************************************************************************************
+bool FacetIndex::Facet::isCapped() const {
+    return unindexedRowCount > 0;
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void FacetIndex::clear() {
+    facets_.clear();
+}
+
+
+//****************************************************************************************************************************************************
+/// Entries must be added in increasing row order, so that posting lists are sorted. Keys and values are looked up without copy, and are only
+/// copied the first time they are encountered.
+///
+/// \param[in] row The row of the entry.
+/// \param[in] entry The entry.
+//****************************************************************************************************************************************************
+void FacetIndex::addEntry(qint32 row, LogEntry const &entry) {
+    for (qsizetype i = 0; i < entry.fieldCount(); ++i) {
+        QUtf8StringView const key = entry.fieldKeyUtf8(i);
+        auto facetIt = facets_.find(QByteArray::fromRawData(key.data(), key.size()));
+        if (facetIt == facets_.end()) {
+            facetIt = facets_.insert(QByteArray(key.data(), key.size()), {});
+        }
+        Facet &facet = facetIt.value();
+        ++facet.rowCount;
+        QUtf8StringView const valueUtf8 = entry.fieldValueUtf8(i);
+        if (valueUtf8.size() > maxValueLength) {
+            ++facet.unindexedRowCount;
+            continue;
+        }
+        QByteArray const value = QByteArray::fromRawData(valueUtf8.data(), valueUtf8.size()); // no copy is made for the lookup.
+        auto postingIt = facet.postings.find(value);
+        if (postingIt == facet.postings.end()) {
+            if (facet.postings.count() >= maxValuesPerKey) {
+                ++facet.unindexedRowCount;
+                continue;
+            }
+            postingIt = facet.postings.insert(QByteArray(valueUtf8.data(), valueUtf8.size()), {});
+        }
+        postingIt->append(row);
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The sorted list of keys in the index.
+//****************************************************************************************************************************************************
+QStringList FacetIndex::keys() const {
+    QStringList result;
+    result.reserve(facets_.size());
+    for (auto it = facets_.begin(); it != facets_.end(); ++it) {
+        result.append(QString::fromUtf8(it.key()));
+    }
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] key The key.
+/// \return The facet for the key.
+/// \return A null pointer if the key is not in the index.
+//****************************************************************************************************************************************************
+FacetIndex::Facet const *FacetIndex::facet(QString const &key) const {
+    auto const it = facets_.constFind(key.toUtf8());
+    return (it == facets_.constEnd()) ? nullptr : &it.value();
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] key The key.
+/// \param[in] value The value.
+/// \return The sorted list of rows where the key has the given value.
+//****************************************************************************************************************************************************
+QList<qint32> FacetIndex::rows(QString const &key, QString const &value) const {
+    Facet const *f = this->facet(key);
+    return f ? f->postings.value(value.toUtf8()) : QList<qint32> {};
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The estimated heap size of the index, in bytes.
+//****************************************************************************************************************************************************
+qint64 FacetIndex::byteCount() const {
+    qint64 result = MemoryUsage::mapByteCount(facets_);
+    for (auto it = facets_.begin(); it != facets_.end(); ++it) {
+        QHash<QByteArray, QList<qint32>> const &postings = it.value().postings;
+        result += MemoryUsage::byteArrayByteCount(it.key()) + MemoryUsage::hashByteCount(postings);
+        for (auto postingIt = postings.begin(); postingIt != postings.end(); ++postingIt) {
+            result += MemoryUsage::byteArrayByteCount(postingIt.key()) + MemoryUsage::listByteCount(postingIt.value());
+        }
+    }
+    return result;
+}
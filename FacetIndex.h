@@ -0,0 +1,54 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of field facet index class.
+
+
+#ifndef ANALOG_FACET_INDEX_H
+#define ANALOG_FACET_INDEX_H
+
+
+#include "LogEntry.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Field facet index class.
+///
+/// The index maps each field key to the rows where each of its values appear. Keys with a very high cardinality are capped: once the cap is
+/// reached, new values for the key are only counted, not indexed. Keys and values are stored as UTF-8, and are only converted to strings when
+/// they are displayed.
+//****************************************************************************************************************************************************
+class FacetIndex {
+public: // data types
+    struct Facet {
+        QHash<QByteArray, QList<qint32>> postings; ///< The sorted rows for each UTF-8 value of the key.
+        qsizetype rowCount { 0 }; ///< The number of rows that have the key.
+        qsizetype unindexedRowCount { 0 }; ///< The number of rows whose value was not indexed because the cap was reached.
+        bool isCapped() const; ///< Check if the cap was reached for the facet.
+    }; ///< Structure for the facet of a field key.
+
+public: // static members
+    static qsizetype constexpr maxValuesPerKey = 1000; ///< The maximum number of distinct values indexed for a key.
+    static qsizetype constexpr maxValueLength = 256; ///< Values longer than this, in bytes, are not indexed.
+
+public: // member functions.
+    FacetIndex() = default; ///< Default constructor.
+    FacetIndex(FacetIndex const &) = delete; ///< Disabled copy-constructor.
+    FacetIndex(FacetIndex &&) = delete; ///< Disabled assignment copy-constructor.
+    ~FacetIndex() = default; ///< Destructor.
+    FacetIndex& operator=(FacetIndex const &) = delete; ///< Disabled assignment operator.
+    FacetIndex& operator=(FacetIndex &&) = delete; ///< Disabled move assignment operator.
+
+    void clear(); ///< Clear the index.
+    void addEntry(qint32 row, LogEntry const &entry); ///< Add an entry to the index.
+    QStringList keys() const; ///< Return the sorted list of indexed keys.
+    Facet const *facet(QString const &key) const; ///< Return the facet for a key.
+    QList<qint32> rows(QString const &key, QString const &value) const; ///< Return the rows for a key/value pair.
+    qint64 byteCount() const; ///< Return the estimated heap size of the index.
+
+private: // data members
+    QMap<QByteArray, Facet> facets_; ///< The facets, by UTF-8 key.
+};
+
+
+#endif //ANALOG_FACET_INDEX_H
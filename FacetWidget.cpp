@@ -0,0 +1,183 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of field facet widget class.
+
+
+#include "FacetWidget.h"
+
+
+namespace {
+qsizetype constexpr maxDisplayedValues = 200; ///< The maximum number of values displayed for a key.
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] parent The parent widget.
+//****************************************************************************************************************************************************
+FacetWidget::FacetWidget(QWidget *parent)
+    : QTreeWidget(parent) {
+    this->setColumnCount(2);
+    this->setHeaderLabels({ tr("Field"), tr("Count") });
+    this->setUniformRowHeights(true);
+    connect(this, &QTreeWidget::itemExpanded, this, &FacetWidget::onItemExpanded);
+    connect(this, &QTreeWidget::itemClicked, this, &FacetWidget::onItemClicked);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] filter The filter model.
+//****************************************************************************************************************************************************
+void FacetWidget::setFilterModel(FilterModel *filter) {
+    filter_ = filter;
+    this->refresh();
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void FacetWidget::refresh() {
+    this->clear();
+    selectedItem_ = nullptr;
+    selectedKey_.clear();
+    selectedValue_.clear();
+    SPLog const log = filter_ ? filter_->log() : SPLog {};
+    if (!log) {
+        return;
+    }
+
+    FacetIndex const &index = log->facetIndex();
+    for (QString const &key: index.keys()) {
+        FacetIndex::Facet const *facet = index.facet(key);
+        auto *item = new QTreeWidgetItem(this);
+        item->setText(0, key);
+        item->setText(1, QString("%1%2").arg(facet->postings.count()).arg(facet->isCapped() ? "+" : ""));
+        item->setToolTip(1, tr("%1 distinct values in %2 entries").arg(item->text(1)).arg(facet->rowCount));
+        item->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
+    }
+    this->resizeColumnToContents(0);
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void FacetWidget::updateCounts() {
+    for (int i = 0; i < this->topLevelItemCount(); ++i) {
+        QTreeWidgetItem *item = this->topLevelItem(i);
+        if (item->isExpanded()) {
+            this->populateKeyItem(item);
+        }
+    }
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void FacetWidget::clearSelectedValue() {
+    this->setSelectedItem(nullptr);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] item The item.
+//****************************************************************************************************************************************************
+void FacetWidget::onItemExpanded(QTreeWidgetItem *item) {
+    if (!item->parent()) {
+        this->populateKeyItem(item);
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// Clicking a value restricts the view to the rows having this value. Clicking it again removes the restriction.
+///
+/// \param[in] item The item.
+//****************************************************************************************************************************************************
+void FacetWidget::onItemClicked(QTreeWidgetItem *item, int) {
+    if (!item->parent()) {
+        return;
+    }
+    if (item == selectedItem_) {
+        this->setSelectedItem(nullptr);
+        emit valueCleared();
+        return;
+    }
+    this->setSelectedItem(item);
+    emit valueSelected(selectedKey_, selectedValue_);
+}
+
+
+//****************************************************************************************************************************************************
+/// Counting is O(size of the posting lists of the key), no entry is scanned, and each row is tested in the accepted rows of the filter model.
+/// The values of the selected key are counted without the row restriction of the selected value, so the other values keep their count.
+///
+/// \param[in] item The key item.
+//****************************************************************************************************************************************************
+void FacetWidget::populateKeyItem(QTreeWidgetItem *item) {
+    SPLog const log = filter_ ? filter_->log() : SPLog {};
+    if (!log) {
+        return;
+    }
+    QString const key = item->text(0);
+    FacetIndex::Facet const *facet = log->facetIndex().facet(key);
+    if (!facet) {
+        return;
+    }
+
+    QList<bool> const &accepted = (selectedKey_ == key) ? filter_->unrestrictedRows() : filter_->acceptedRows();
+    QList<std::pair<QString, qsizetype>> counts;
+    counts.reserve(facet->postings.count());
+    for (auto it = facet->postings.begin(); it != facet->postings.end(); ++it) {
+        qsizetype const count = std::ranges::count_if(it.value(), [&accepted](qint32 row) -> bool {
+            return (row < accepted.count()) && accepted[row];
+        });
+        counts.append({ QString::fromUtf8(it.key()), count });
+    }
+    std::ranges::sort(counts, [](auto const &lhs, auto const &rhs) -> bool {
+        return (lhs.second != rhs.second) ? lhs.second > rhs.second : lhs.first < rhs.first;
+    });
+    if (counts.count() > maxDisplayedValues) {
+        counts.resize(maxDisplayedValues);
+    }
+
+    bool const isSelectedKey = (selectedKey_ == key);
+    if (isSelectedKey) {
+        selectedItem_ = nullptr;
+    }
+    qDeleteAll(item->takeChildren());
+    for (auto const &[value, count]: counts) {
+        auto *child = new QTreeWidgetItem(item);
+        child->setText(0, value);
+        child->setText(1, QString::number(count));
+        child->setToolTip(0, value);
+        if (isSelectedKey && (value == selectedValue_)) {
+            selectedItem_ = child;
+            QFont font = child->font(0);
+            font.setBold(true);
+            child->setFont(0, font);
+            child->setFont(1, font);
+        }
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] item The value item. May be null.
+//****************************************************************************************************************************************************
+void FacetWidget::setSelectedItem(QTreeWidgetItem *item) {
+    for (QTreeWidgetItem *it: { selectedItem_, item }) {
+        if (!it) {
+            continue;
+        }
+        QFont font = it->font(0);
+        font.setBold(it == item);
+        it->setFont(0, font);
+        it->setFont(1, font);
+    }
+    selectedItem_ = item;
+    selectedKey_ = item ? item->parent()->text(0) : QString();
+    selectedValue_ = item ? item->text(0) : QString();
+}
@@ -0,0 +1,58 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of field facet widget class.
+
+
+#ifndef ANALOG_FACET_WIDGET_H
+#define ANALOG_FACET_WIDGET_H
+
+
+#include "FilterModel.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Field facet widget class.
+///
+/// The widget lists the field keys of the log. Expanding a key lists its values, with the number of visible rows for each value. Values are
+/// only counted for expanded keys, and counts are updated when the filtering changes.
+//****************************************************************************************************************************************************
+class FacetWidget : public QTreeWidget {
+    Q_OBJECT
+
+public: // member functions.
+    explicit FacetWidget(QWidget *parent = nullptr); ///< Default constructor.
+    FacetWidget(FacetWidget const &) = delete; ///< Disabled copy-constructor.
+    FacetWidget(FacetWidget &&) = delete; ///< Disabled assignment copy-constructor.
+    ~FacetWidget() override = default; ///< Destructor.
+    FacetWidget& operator=(FacetWidget const &) = delete; ///< Disabled assignment operator.
+    FacetWidget& operator=(FacetWidget &&) = delete; ///< Disabled move assignment operator.
+
+    void setFilterModel(FilterModel *filter); ///< Set the filter model.
+    void clearSelectedValue(); ///< Clear the selected value.
+
+public slots:
+    void refresh(); ///< Rebuild the list of keys from the log of the filter model.
+    void updateCounts(); ///< Update the value counts of the expanded keys.
+
+signals:
+    void valueSelected(QString const &key, QString const &value); ///< Signal emitted when a facet value is selected.
+    void valueCleared(); ///< Signal emitted when the facet value selection is cleared.
+
+private slots:
+    void onItemExpanded(QTreeWidgetItem *item); ///< Slot for the expansion of an item.
+    void onItemClicked(QTreeWidgetItem *item, int column); ///< Slot for the click on an item.
+
+private: // member functions.
+    void populateKeyItem(QTreeWidgetItem *item); ///< Fill the value items of a key item.
+    void setSelectedItem(QTreeWidgetItem *item); ///< Set the selected value item.
+
+private: // data members.
+    FilterModel *filter_ { nullptr }; ///< The filter model.
+    QTreeWidgetItem *selectedItem_ { nullptr }; ///< The value item used to restrict the view, if any.
+    QString selectedKey_; ///< The key of the selected value.
+    QString selectedValue_; ///< The selected value.
+};
+
+
+#endif //ANALOG_FACET_WIDGET_H
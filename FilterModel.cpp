@@ -5,6 +5,40 @@
 
 
 #include "FilterModel.h"
+#include "Instrumentation.h"
+#include "Parallel.h"
+#include "SortKeys.h"
+#include "Tracer.h"
+
+
+namespace {
+qsizetype constexpr filterMinChunkSize = 16384; ///< The minimum number of rows filtered by a thread.
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] sortedRows The source rows in the sorted order, or an empty list for the log order.
+/// \param[in] accepted The result of the filters for each source row.
+/// \return The accepted source rows, in the sorted order.
+//****************************************************************************************************************************************************
+QList<qint32> acceptedRowsInOrder(QList<qint32> const &sortedRows, QList<bool> const &accepted) {
+    QList<qint32> result;
+    result.reserve(std::ranges::count(accepted, true));
+    if (sortedRows.isEmpty()) {
+        for (qsizetype row = 0; row < accepted.count(); ++row) {
+            if (accepted[row]) {
+                result.append(qint32(row));
+            }
+        }
+        return result;
+    }
+    for (qint32 const row: sortedRows) {
+        if ((row < accepted.count()) && accepted[row]) {
+            result.append(row);
+        }
+    }
+    return result;
+}
 
 
 //****************************************************************************************************************************************************
@@ -12,7 +46,28 @@
 //****************************************************************************************************************************************************
 FilterModel::FilterModel(SPLog const &log)
     : log_(log) {
-    this->QSortFilterProxyModel::setSourceModel(log_.get());
+    this->updateContentRows();
+    this->updateUnrestrictedRows();
+    this->updateAcceptedRows();
+    this->QAbstractProxyModel::setSourceModel(log_.get());
+    proxyRows_ = acceptedRowsInOrder(sortedRows_, acceptedRows_);
+    this->updateSourceToProxy();
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+FilterModel::~FilterModel() {
+    this->cancelSort();
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The log.
+//****************************************************************************************************************************************************
+SPLog FilterModel::log() const {
+    return log_;
 }
 
 
@@ -23,8 +78,26 @@ void FilterModel::setLog(SPLog const &log) {
     if (log == log_) {
         return;
     }
+    this->cancelSort();
+    this->beginResetModel();
+    sortedRows_.clear();
+    sortColumn_ = -1;
+    sortOrder_ = Qt::AscendingOrder;
     log_ = log;
-    this->setSourceModel(log.get());
+    hasRowRestriction_ = false;
+    rowRestriction_.clear();
+    this->updateTimeRangeRows();
+    this->updatePackageMatches();
+    this->updateContentRows();
+    this->updateUnrestrictedRows();
+    this->updateAcceptedRows();
+    {
+        Instrumentation::ScopedTimer const timer(Instrumentation::Stage::SourceModelChange);
+        this->QAbstractProxyModel::setSourceModel(log.get());
+        proxyRows_ = acceptedRowsInOrder(sortedRows_, acceptedRows_);
+        this->updateSourceToProxy();
+        this->endResetModel();
+    }
 
     if (log) {
         QStringList const errors = log->errors();
@@ -51,14 +124,80 @@ void FilterModel::setLevel(LogEntry::Level level) {
         return;
     }
     level_ = level;
-    this->invalidate();
+    this->refilter(FilterStage::Content);
 }
 
+//****************************************************************************************************************************************************
+/// \param[in] row The proxy row.
+/// \param[in] column The column.
+/// \param[in] parent The parent index.
+/// \return The index of the item.
+//****************************************************************************************************************************************************
+QModelIndex FilterModel::index(int row, int column, QModelIndex const &parent) const {
+    if (parent.isValid() || (row < 0) || (row >= proxyRows_.count()) || (column < 0) || (column >= this->columnCount())) {
+        return {};
+    }
+    return this->createIndex(row, column);
+}
+
+
+//****************************************************************************************************************************************************
+/// \return An invalid index, as the model is a table.
+//****************************************************************************************************************************************************
+QModelIndex FilterModel::parent(QModelIndex const &) const {
+    return {};
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] parent The parent index.
+/// \return The number of visible rows.
+//****************************************************************************************************************************************************
+int FilterModel::rowCount(QModelIndex const &parent) const {
+    return parent.isValid() ? 0 : int(proxyRows_.count());
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] parent The parent index.
+/// \return The number of columns.
+//****************************************************************************************************************************************************
+int FilterModel::columnCount(QModelIndex const &parent) const {
+    return (parent.isValid() || !log_) ? 0 : log_->columnCount(QModelIndex());
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] proxyIndex The proxy index.
+/// \return The source index.
+//****************************************************************************************************************************************************
+QModelIndex FilterModel::mapToSource(QModelIndex const &proxyIndex) const {
+    if ((!log_) || (!proxyIndex.isValid()) || (proxyIndex.row() >= proxyRows_.count())) {
+        return {};
+    }
+    return log_->index(proxyRows_[proxyIndex.row()], proxyIndex.column());
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] sourceIndex The source index.
+/// \return The proxy index.
+/// \return An invalid index if the source row is not visible.
+//****************************************************************************************************************************************************
+QModelIndex FilterModel::mapFromSource(QModelIndex const &sourceIndex) const {
+    if ((!sourceIndex.isValid()) || (sourceIndex.row() >= sourceToProxy_.count())) {
+        return {};
+    }
+    qint32 const row = sourceToProxy_[sourceIndex.row()];
+    return (row < 0) ? QModelIndex() : this->createIndex(row, sourceIndex.column());
+}
+
+
 //****************************************************************************************************************************************************
 /// \param[in] sourceRow The row index.
-/// \return true iff the row should be displayed.
+/// \return true iff the row passes the level, package and text filters.
 //****************************************************************************************************************************************************
-bool FilterModel::filterAcceptsRow(int sourceRow, QModelIndex const &) const {
+bool FilterModel::acceptsContent(qsizetype sourceRow) const {
     if (!log_) {
         return false;
     }
@@ -70,25 +209,11 @@ bool FilterModel::filterAcceptsRow(int sourceRow, QModelIndex const &) const {
         return false;
     }
 
-    if ((!packageFilter_.isEmpty()) && !entry.package().contains(packageFilter_, Qt::CaseInsensitive)) {
+    if ((!packageFilter_.isEmpty()) && !packageMatches_.testBit(log_->packageIds_[sourceRow])) {
         return false;
     }
 
-    if (textFilter_.isEmpty()) {
-        return true;
-    }
-
-    if (entry.message().contains(textFilter_, Qt::CaseInsensitive)) {
-        return true;
-    }
-    QMap<QString, QString> const &fields = entry.fields();
-    for (QMap<QString, QString>::const_iterator it = fields.begin(); it != fields.end(); ++it) {
-        if (it.key().contains(textFilter_, Qt::CaseInsensitive) || it.value().contains(textFilter_, Qt::CaseInsensitive)) {
-            return true;
-        }
-    }
-
-    return false;
+    return textFilter_.text.isEmpty() || entry.containsText(textFilter_);
 }
 
 
@@ -109,7 +234,7 @@ void FilterModel::setUseStrictLevelFilter(bool strict) {
     }
 
     useStrictLevelFilter_ = strict;
-    this->invalidate();
+    this->refilter(FilterStage::Content);
 }
 
 
@@ -129,7 +254,8 @@ void FilterModel::setPackageFilter(QString const &filter) {
         return;
     }
     packageFilter_ = filter;
-    this->invalidate();
+    this->updatePackageMatches();
+    this->refilter(FilterStage::Content);
 }
 
 
@@ -137,7 +263,7 @@ void FilterModel::setPackageFilter(QString const &filter) {
 /// \return The text filter.
 //****************************************************************************************************************************************************
 QString FilterModel::textFilter() {
-    return textFilter_;
+    return textFilter_.text;
 }
 
 
@@ -145,9 +271,432 @@ QString FilterModel::textFilter() {
 /// \param[in] filter The text filter.
 //****************************************************************************************************************************************************
 void FilterModel::setTextFilter(QString const &filter) {
-    if (textFilter_ == filter) {
+    if (textFilter_.text == filter) {
         return;
     }
-    textFilter_ = filter;
-    this->invalidate();
+    textFilter_ = LogEntry::TextQuery(filter);
+    this->refilter(FilterStage::Content);
+}
+
+
+//****************************************************************************************************************************************************
+/// \return true iff the filter has a time range restriction.
+//****************************************************************************************************************************************************
+bool FilterModel::hasTimeRange() const {
+    return hasTimeRange_;
+}
+
+
+//****************************************************************************************************************************************************
+/// The time range is converted once into a source row range using the time index of the log, and is intersected with the cached result of
+/// the content filters, so changing the time range does not run the level, package and text filters again.
+///
+/// \param[in] start The start of the time range.
+/// \param[in] end The end of the time range (inclusive).
+//****************************************************************************************************************************************************
+void FilterModel::setTimeRange(qint64 start, qint64 end) {
+    if (hasTimeRange_ && (start == timeRangeStart_) && (end == timeRangeEnd_)) {
+        return;
+    }
+    hasTimeRange_ = true;
+    timeRangeStart_ = start;
+    timeRangeEnd_ = end;
+    this->updateTimeRangeRows();
+    this->refilter(FilterStage::TimeRange);
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void FilterModel::clearTimeRange() {
+    if (!hasTimeRange_) {
+        return;
+    }
+    hasTimeRange_ = false;
+    this->refilter(FilterStage::TimeRange);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] sourceRow The row index.
+/// \return true iff the row is in the time range, or if there is no time range restriction.
+//****************************************************************************************************************************************************
+bool FilterModel::isInTimeRange(qsizetype sourceRow) const {
+    if (!hasTimeRange_) {
+        return true;
+    }
+    if ((sourceRow < timeRangeFirstRow_) || (sourceRow >= timeRangeLastRow_)) {
+        return false;
+    }
+    qint64 const ts = log_->timestamps_[sourceRow];
+    return (ts >= timeRangeStart_) && (ts <= timeRangeEnd_);
+}
+
+
+//****************************************************************************************************************************************************
+/// Each row is tested once, in parallel, and the result is cached, so the proxy model does not run the filters on the GUI thread, and the
+/// time range and row restriction can change without running the content filters again.
+//****************************************************************************************************************************************************
+void FilterModel::updateContentRows() {
+    Instrumentation::ScopedTimer const timer(Instrumentation::Stage::Filtering);
+    qsizetype const count = log_ ? log_->entries_.count() : 0;
+    Instrumentation::addCount(Instrumentation::Counter::FilterPasses);
+    Instrumentation::addCount(Instrumentation::Counter::FilteredRows, count);
+    contentRows_.resize(count);
+    bool *const accepted = contentRows_.data();
+    parallelFor(count, filterMinChunkSize, [this, accepted](qsizetype, qsizetype begin, qsizetype end) {
+        Tracer::Scope const chunkScope("filter chunk", "filter", "rows", end - begin);
+        for (qsizetype row = begin; row < end; ++row) {
+            accepted[row] = this->acceptsContent(row);
+        }
+    });
+}
+
+
+//****************************************************************************************************************************************************
+/// Only the rows in the row range of the time range are visited. Without time range, the result of the content filters is shared, not
+/// copied.
+//****************************************************************************************************************************************************
+void FilterModel::updateUnrestrictedRows() {
+    if (!hasTimeRange_) {
+        unrestrictedRows_ = contentRows_;
+        return;
+    }
+    qsizetype const count = contentRows_.count();
+    qsizetype const first = qMin(timeRangeFirstRow_, count);
+    qsizetype const last = qMin(timeRangeLastRow_, count);
+    unrestrictedRows_.fill(false, count);
+    bool const *const content = contentRows_.constData();
+    bool *const unrestricted = unrestrictedRows_.data();
+    parallelFor(last - first, filterMinChunkSize, [this, content, unrestricted, first](qsizetype, qsizetype begin, qsizetype end) {
+        for (qsizetype row = first + begin; row < first + end; ++row) {
+            unrestricted[row] = content[row] && this->isInTimeRange(row);
+        }
+    });
+}
+
+
+//****************************************************************************************************************************************************
+/// Only the rows of the restriction are visited, and tested against the cached result of the other filters. Without row restriction, the
+/// result of the other filters is shared, not copied.
+//****************************************************************************************************************************************************
+void FilterModel::updateAcceptedRows() {
+    if (!hasRowRestriction_) {
+        acceptedRows_ = unrestrictedRows_;
+        return;
+    }
+    acceptedRows_.fill(false, unrestrictedRows_.count());
+    for (qint32 const row: rowRestriction_) {
+        if (row < unrestrictedRows_.count()) {
+            acceptedRows_[row] = unrestrictedRows_[row];
+        }
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] stage The first stage of the filter to update. The following stages are always updated.
+//****************************************************************************************************************************************************
+void FilterModel::refilter(FilterStage stage) {
+    if (stage == FilterStage::Content) {
+        this->updateContentRows();
+    }
+    if (stage != FilterStage::RowRestriction) {
+        this->updateUnrestrictedRows();
+    }
+    this->updateAcceptedRows();
+    this->updateMapping();
+}
+
+
+//****************************************************************************************************************************************************
+/// The sorted order is computed once per sort, so the mapping is rebuilt by a linear scan, without comparing rows.
+//****************************************************************************************************************************************************
+void FilterModel::updateMapping() {
+    Instrumentation::ScopedTimer const timer(Instrumentation::Stage::ProxyInvalidation);
+    this->setProxyRows(acceptedRowsInOrder(sortedRows_, acceptedRows_));
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] proxyRows The source row of each proxy row.
+//****************************************************************************************************************************************************
+void FilterModel::setProxyRows(QList<qint32> const &proxyRows) {
+    emit layoutAboutToBeChanged();
+    QModelIndexList const persistentIndexes = this->persistentIndexList();
+    QModelIndexList sourceIndexes;
+    sourceIndexes.reserve(persistentIndexes.count());
+    for (QModelIndex const &index: persistentIndexes) {
+        sourceIndexes.append(this->mapToSource(index));
+    }
+
+    proxyRows_ = proxyRows;
+    this->updateSourceToProxy();
+
+    QModelIndexList newIndexes;
+    newIndexes.reserve(sourceIndexes.count());
+    for (QModelIndex const &index: sourceIndexes) {
+        newIndexes.append(this->mapFromSource(index));
+    }
+    this->changePersistentIndexList(persistentIndexes, newIndexes);
+    emit layoutChanged();
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void FilterModel::updateSourceToProxy() {
+    sourceToProxy_.fill(-1, log_ ? log_->entries_.count() : 0);
+    for (qsizetype row = 0; row < proxyRows_.count(); ++row) {
+        sourceToProxy_[proxyRows_[row]] = qint32(row);
+    }
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void FilterModel::updateTimeRangeRows() {
+    if (!log_) {
+        timeRangeFirstRow_ = timeRangeLastRow_ = 0;
+        return;
+    }
+    std::tie(timeRangeFirstRow_, timeRangeLastRow_) = log_->rowRangeForTimeRange(timeRangeStart_, timeRangeEnd_);
+}
+
+
+//****************************************************************************************************************************************************
+/// The package filter is matched once against each entry of the package dictionary of the log, so filtering a row is a bit lookup.
+//****************************************************************************************************************************************************
+void FilterModel::updatePackageMatches() {
+    if (!log_) {
+        packageMatches_.clear();
+        return;
+    }
+    QStringList const &packages = log_->packages();
+    packageMatches_.fill(false, packages.count());
+    for (qsizetype i = 0; i < packages.count(); ++i) {
+        if (packages[i].contains(packageFilter_, Qt::CaseInsensitive)) {
+            packageMatches_.setBit(i);
+        }
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// As long as the proxy is not sorted, or is sorted by ascending time, visible rows are in the same order as source rows, so the search is a
+/// binary search on the proxy rows. Otherwise, source rows are scanned from the first one reaching the timestamp, until a visible one is found.
+///
+/// \param[in] timestamp The timestamp.
+/// \return The first visible row whose source row is at or after the first source row reaching the timestamp.
+/// \return -1 if there is no such row.
+//****************************************************************************************************************************************************
+int FilterModel::proxyRowForTimestamp(qint64 timestamp) const {
+    if (!log_) {
+        return -1;
+    }
+    qsizetype const sourceRow = log_->firstRowAtOrAfter(timestamp);
+    bool const isInSourceOrder = (sortColumn_ < 0) || ((sortColumn_ == 0) && (sortOrder_ == Qt::AscendingOrder));
+    if (!isInSourceOrder) {
+        for (qsizetype row = sourceRow; row < sourceToProxy_.count(); ++row) {
+            if (sourceToProxy_[row] >= 0) {
+                return sourceToProxy_[row];
+            }
+        }
+        return -1;
+    }
+
+    auto const it = std::lower_bound(proxyRows_.begin(), proxyRows_.end(), sourceRow);
+    return (it == proxyRows_.end()) ? -1 : int(it - proxyRows_.begin());
+}
+
+
+//****************************************************************************************************************************************************
+/// \return true iff the filter is restricted to a set of source rows.
+//****************************************************************************************************************************************************
+bool FilterModel::hasRowRestriction() const {
+    return hasRowRestriction_;
+}
+
+
+//****************************************************************************************************************************************************
+/// The restriction is intersected with the cached result of the other filters, so no filter is run again, and only the rows of the
+/// restriction are visited.
+///
+/// \param[in] sourceRows The sorted source rows.
+//****************************************************************************************************************************************************
+void FilterModel::setRowRestriction(QList<qint32> const &sourceRows) {
+    if (!log_) {
+        return;
+    }
+    rowRestriction_ = sourceRows;
+    hasRowRestriction_ = true;
+    this->refilter(FilterStage::RowRestriction);
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void FilterModel::clearRowRestriction() {
+    if (!hasRowRestriction_) {
+        return;
+    }
+    hasRowRestriction_ = false;
+    rowRestriction_.clear();
+    this->refilter(FilterStage::RowRestriction);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] sourceRow The source row.
+/// \return true iff the source row is visible through the filter.
+//****************************************************************************************************************************************************
+bool FilterModel::isSourceRowVisible(int sourceRow) const {
+    return (sourceRow >= 0) && (sourceRow < sourceToProxy_.count()) && (sourceToProxy_[sourceRow] >= 0);
+}
+
+
+//****************************************************************************************************************************************************
+/// The list is updated whenever the filters change, so testing a row is a lookup.
+///
+/// \return The result of the filters for each source row.
+//****************************************************************************************************************************************************
+QList<bool> const &FilterModel::acceptedRows() const {
+    return acceptedRows_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The result of the level, package, text and time range filters for each source row.
+//****************************************************************************************************************************************************
+QList<bool> const &FilterModel::unrestrictedRows() const {
+    return unrestrictedRows_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The source rows visible through the filter, in the order of the view.
+//****************************************************************************************************************************************************
+QList<qint32> FilterModel::visibleSourceRows() const {
+    return proxyRows_;
+}
+
+
+//****************************************************************************************************************************************************
+/// The sorted order of the rows is computed on a worker thread with a radix sort, and intersected with the accepted rows, so the GUI thread
+/// only applies the resulting mapping. The sorted order is kept, so the sort is preserved when the filter changes without sorting again.
+/// Use a negative column to restore the order of the log.
+///
+/// \param[in] column The column.
+/// \param[in] order The sort order.
+//****************************************************************************************************************************************************
+void FilterModel::requestSort(int column, Qt::SortOrder order) {
+    this->cancelSort();
+    if ((!log_) || (column < 0)) {
+        sortedRows_.clear();
+        sortColumn_ = -1;
+        sortOrder_ = order;
+        this->updateMapping();
+        emit sortFinished();
+        return;
+    }
+    if ((column == sortColumn_) && (order == sortOrder_)) {
+        emit sortFinished();
+        return;
+    }
+
+    emit sortStarted();
+    quint64 const generation = sortGeneration_;
+    sortCancelled_ = std::make_shared<std::atomic_bool>(false);
+    sortThread_ = std::thread([this, log = log_, column, order, generation, accepted = acceptedRows_, cancelled = sortCancelled_]() {
+        QList<qint32> const sortedRows = SortKeys::computeOrder(*log, column, order, *cancelled);
+        if (*cancelled) {
+            return;
+        }
+        QList<qint32> const proxyRows = acceptedRowsInOrder(sortedRows, accepted);
+        QMetaObject::invokeMethod(this, [this, generation, column, order, sortedRows, accepted, proxyRows]() {
+            this->onSortOrderReady(generation, column, order, sortedRows, accepted, proxyRows);
+        }, Qt::QueuedConnection);
+    });
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The sort column, or -1 if the model is in log order.
+//****************************************************************************************************************************************************
+int FilterModel::sortColumn() const {
+    return sortColumn_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The sort order.
+//****************************************************************************************************************************************************
+Qt::SortOrder FilterModel::sortOrder() const {
+    return sortOrder_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The estimated memory usage of the filter model, by component.
+//****************************************************************************************************************************************************
+MemoryUsage FilterModel::memoryUsage() const {
+    MemoryUsage result;
+    result.add("contentRows", MemoryUsage::listByteCount(contentRows_));
+    result.add("unrestrictedRows", (unrestrictedRows_.constData() == contentRows_.constData()) ? 0 :
+        MemoryUsage::listByteCount(unrestrictedRows_));
+    result.add("acceptedRows", (acceptedRows_.constData() == unrestrictedRows_.constData()) ? 0 : MemoryUsage::listByteCount(acceptedRows_));
+    result.add("packageMatches", packageMatches_.size() / 8);
+    result.add("rowRestriction", MemoryUsage::listByteCount(rowRestriction_));
+    result.add("sortedRows", MemoryUsage::listByteCount(sortedRows_));
+    result.add("proxyMapping", MemoryUsage::listByteCount(proxyRows_) + MemoryUsage::listByteCount(sourceToProxy_));
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void FilterModel::cancelSort() {
+    if (sortCancelled_) {
+        *sortCancelled_ = true;
+    }
+    if (sortThread_.joinable()) {
+        sortThread_.join();
+    }
+    ++sortGeneration_;
+}
+
+
+//****************************************************************************************************************************************************
+/// The worker intersected the sorted order with the accepted rows when the sort was requested. If the filter changed since, the mapping is
+/// rebuilt from the sorted order, which is still a linear scan.
+///
+/// \param[in] generation The generation of the sort.
+/// \param[in] column The column.
+/// \param[in] order The sort order.
+/// \param[in] sortedRows The source rows in the sorted order.
+/// \param[in] acceptedRows The accepted rows the proxy rows were computed from.
+/// \param[in] proxyRows The accepted source rows in the sorted order.
+//****************************************************************************************************************************************************
+void FilterModel::onSortOrderReady(quint64 generation, int column, Qt::SortOrder order, QList<qint32> const &sortedRows,
+    QList<bool> const &acceptedRows, QList<qint32> const &proxyRows) {
+    if (generation != sortGeneration_) {
+        return;
+    }
+    if (sortThread_.joinable()) {
+        sortThread_.join();
+    }
+    sortedRows_ = sortedRows;
+    sortColumn_ = column;
+    sortOrder_ = order;
+    {
+        Instrumentation::ScopedTimer const timer(Instrumentation::Stage::ProxyInvalidation);
+        bool const isFilterUnchanged = acceptedRows.constData() == acceptedRows_.constData();
+        this->setProxyRows(isFilterUnchanged ? proxyRows : acceptedRowsInOrder(sortedRows_, acceptedRows_));
+    }
+    emit sortFinished();
 }
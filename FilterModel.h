@@ -13,17 +13,34 @@
 
 //****************************************************************************************************************************************************
 /// \brief The filter model for the log.
+///
+/// The model is a proxy that owns its row mapping: the filters produce a boolean per source row, and sorting produces the sorted order of
+/// the source rows on a worker thread, so the mapping is rebuilt by a linear scan of the sorted order, without comparing rows.
 //****************************************************************************************************************************************************
-class FilterModel : public QSortFilterProxyModel {
+class FilterModel : public QAbstractProxyModel {
     Q_OBJECT
 
+private: // data types
+    enum class FilterStage {
+        Content, ///< The level, package and text filters, that look at the content of the entries.
+        TimeRange, ///< The time range, that is intersected with the cached result of the content filters.
+        RowRestriction, ///< The row restriction, that is intersected with the cached result of the other filters.
+    }; ///< Enumeration for the stages of the filter, from the most to the least expensive to update.
+
 public: // member functions.
     explicit FilterModel(SPLog const& log = {}); ///< Default constructor.
     FilterModel(FilterModel const &) = delete; ///< Disabled copy-constructor.
     FilterModel(FilterModel &&) = delete; ///< Disabled assignment copy-constructor.
-    ~FilterModel() override = default; ///< Destructor.
+    ~FilterModel() override; ///< Destructor.
     FilterModel& operator=(FilterModel const &) = delete; ///< Disabled assignment operator.
     FilterModel& operator=(FilterModel &&) = delete; ///< Disabled move assignment operator.
+    QModelIndex index(int row, int column, QModelIndex const &parent = QModelIndex()) const override; ///< Return the index of an item.
+    QModelIndex parent(QModelIndex const &child) const override; ///< Return the parent of an item.
+    int rowCount(QModelIndex const &parent = QModelIndex()) const override; ///< Return the number of visible rows.
+    int columnCount(QModelIndex const &parent = QModelIndex()) const override; ///< Return the number of columns.
+    QModelIndex mapToSource(QModelIndex const &proxyIndex) const override; ///< Map a proxy index to the source model.
+    QModelIndex mapFromSource(QModelIndex const &sourceIndex) const override; ///< Map a source index to the proxy.
+    SPLog log() const; ///< Get the log.
     void setLog(SPLog const &log); ///< Set the log.
     LogEntry::Level level() const; ///< Get the level of the filer.
     void setLevel(LogEntry::Level); ///< Set the level of the filter.
@@ -33,19 +50,68 @@ public: // member functions.
     void setPackageFilter(QString const &filter); ///< Set the package filter string.
     QString textFilter(); ///< Get the text filter.
     void setTextFilter(QString const &filter); ///< Set The text filter.
+    bool hasTimeRange() const; ///< Check if the filter has a time range restriction.
+    void setTimeRange(qint64 start, qint64 end); ///< Restrict the filter to a time range.
+    void clearTimeRange(); ///< Remove the time range restriction.
+    int proxyRowForTimestamp(qint64 timestamp) const; ///< Return the first visible row at or after a timestamp.
+    bool hasRowRestriction() const; ///< Check if the filter is restricted to a set of source rows.
+    void setRowRestriction(QList<qint32> const &sourceRows); ///< Restrict the filter to a sorted list of source rows.
+    void clearRowRestriction(); ///< Remove the source row restriction.
+    bool isSourceRowVisible(int sourceRow) const; ///< Check if a source row is visible through the filter.
+    QList<bool> const &acceptedRows() const; ///< Return the result of the filters for each source row.
+    QList<bool> const &unrestrictedRows() const; ///< Return the result of the filters for each source row, ignoring the row restriction.
+    QList<qint32> visibleSourceRows() const; ///< Return the source rows visible through the filter, in view order.
+    void requestSort(int column, Qt::SortOrder order); ///< Sort the model on a worker thread.
+    int sortColumn() const; ///< Return the sort column, or -1 if the model is in log order.
+    Qt::SortOrder sortOrder() const; ///< Return the sort order.
+    MemoryUsage memoryUsage() const; ///< Returns the estimated memory usage of the filter model, by component, excluding the log.
 
 signals:
     void logErrorsOccurred(QStringList const& list); ///< Signal emitted when errors occured while opening a log.
+    void sortStarted(); ///< Signal emitted when the computation of sort keys starts.
+    void sortFinished(); ///< Signal emitted when the model has been sorted.
 
 private: // member functions.
-    bool filterAcceptsRow(int sourceRow, QModelIndex const &) const override; ///< check if a row show be accepted.
+    bool acceptsContent(qsizetype sourceRow) const; ///< Run the content filters on a source row.
+    bool isInTimeRange(qsizetype sourceRow) const; ///< Check if a source row is in the time range.
+    void updateContentRows(); ///< Run the content filters on every source row.
+    void updateUnrestrictedRows(); ///< Intersect the result of the content filters with the time range.
+    void updateAcceptedRows(); ///< Intersect the result of the other filters with the row restriction.
+    void refilter(FilterStage stage); ///< Update the filters from a stage and update the proxy.
+    void updateMapping(); ///< Rebuild the proxy mapping from the sort order and the accepted rows.
+    void setProxyRows(QList<qint32> const &proxyRows); ///< Apply a new proxy mapping, preserving persistent indexes.
+    void updateSourceToProxy(); ///< Rebuild the source to proxy part of the mapping.
+    void cancelSort(); ///< Cancel the sort in progress.
+    void onSortOrderReady(quint64 generation, int column, Qt::SortOrder order, QList<qint32> const &sortedRows,
+        QList<bool> const &acceptedRows, QList<qint32> const &proxyRows); ///< Apply a sort computed on the worker thread.
+    void updateTimeRangeRows(); ///< Update the row range matching the time range.
+    void updatePackageMatches(); ///< Update the set of packages matching the package filter.
 
 private: // data members.
     SPLog log_; ///< The log
     LogEntry::Level level_ { LogEntry::Level::Trace }; ///< The minimum level to show.
     bool useStrictLevelFilter_ { false }; ///< Set if the level_ filtering should exclude entries above the selected level.
     QString packageFilter_; ///< The filter to apply to the package.
-    QString textFilter_; ///< The text filter.
+    QBitArray packageMatches_; ///< The package dictionary entries matching the package filter.
+    LogEntry::TextQuery textFilter_; ///< The text filter.
+    bool hasTimeRange_ { false }; ///< Is the time range restriction active.
+    qint64 timeRangeStart_ { LogEntry::invalidTimestamp }; ///< The start of the time range.
+    qint64 timeRangeEnd_ { LogEntry::invalidTimestamp }; ///< The end of the time range (inclusive).
+    qsizetype timeRangeFirstRow_ { 0 }; ///< The first source row that can be in the time range.
+    qsizetype timeRangeLastRow_ { 0 }; ///< The source row past the last one that can be in the time range.
+    bool hasRowRestriction_ { false }; ///< Is the source row restriction active.
+    QList<qint32> rowRestriction_; ///< The sorted source rows allowed by the row restriction.
+    QList<bool> contentRows_; ///< The result of the content filters for each source row.
+    QList<bool> unrestrictedRows_; ///< The result of the content filters and time range for each source row.
+    QList<bool> acceptedRows_; ///< The result of the filters for each source row.
+    QList<qint32> proxyRows_; ///< The source row of each proxy row.
+    QList<qint32> sourceToProxy_; ///< The proxy row of each source row, or -1 if the source row is not visible.
+    QList<qint32> sortedRows_; ///< The source rows in the sorted order, or an empty list if the model is in log order.
+    int sortColumn_ { -1 }; ///< The sort column, or -1 if the model is in log order.
+    Qt::SortOrder sortOrder_ { Qt::AscendingOrder }; ///< The sort order.
+    std::thread sortThread_; ///< The thread sorting the rows.
+    std::shared_ptr<std::atomic_bool> sortCancelled_; ///< The cancellation flag of the sort.
+    quint64 sortGeneration_ { 0 }; ///< The generation of the sort, used to discard results of cancelled sorts.
 };
 
 
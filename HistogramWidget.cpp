@@ -0,0 +1,296 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of time histogram widget class.
+
+
+#include "HistogramWidget.h"
+#include "LogStyle.h"
+
+
+namespace {
+QColor const backgroundColor(0x2b2d30); ///< The background color of the widget.
+QColor const selectionColor(255, 255, 255, 40); ///< The color of the highlighted time range.
+int constexpr preferredHeight = 72; ///< The preferred height of the widget.
+qreal constexpr minBarWidth = 3.0; ///< The minimum width of a bar, in pixels.
+qreal constexpr zoomFactor = 1.25; ///< The zoom factor for a mouse wheel step.
+qreal constexpr dragThreshold = 4.0; ///< The distance in pixels the mouse must move for a press to become a drag.
+qint64 constexpr minViewSpan = 10 * 1000; ///< The minimum displayed time span, in milliseconds.
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] parent The parent widget.
+//****************************************************************************************************************************************************
+HistogramWidget::HistogramWidget(QWidget *parent)
+    : QWidget(parent) {
+    this->setMouseTracking(true);
+    this->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Fixed);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] log The log.
+//****************************************************************************************************************************************************
+void HistogramWidget::setLog(SPLog const &log) {
+    log_ = log;
+    hasSelectedRange_ = false;
+    this->resetView();
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] start The start of the time range.
+/// \param[in] end The end of the time range (inclusive).
+//****************************************************************************************************************************************************
+void HistogramWidget::setSelectedRange(qint64 start, qint64 end) {
+    hasSelectedRange_ = true;
+    selectedStart_ = start;
+    selectedEnd_ = end;
+    this->update();
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void HistogramWidget::clearSelectedRange() {
+    hasSelectedRange_ = false;
+    this->update();
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The size hint for the widget.
+//****************************************************************************************************************************************************
+QSize HistogramWidget::sizeHint() const {
+    return { QWidget::sizeHint().width(), preferredHeight };
+}
+
+
+//****************************************************************************************************************************************************
+/// Levels are stacked from the most severe at the bottom to the least severe at the top, so that errors remain visible in dense buckets.
+//****************************************************************************************************************************************************
+void HistogramWidget::paintEvent(QPaintEvent *) {
+    QPainter painter(this);
+    painter.fillRect(this->rect(), backgroundColor);
+    if ((!log_) || (viewEnd_ <= viewStart_)) {
+        return;
+    }
+
+    TimeHistogram const &histogram = log_->timeHistogram();
+    TimeHistogram::Resolution const resolution = this->resolution();
+    QList<TimeHistogram::Bucket> const &buckets = histogram.buckets(resolution);
+    auto const [first, last] = histogram.bucketRange(resolution, viewStart_, viewEnd_);
+    qint32 maxCount = 0;
+    for (qsizetype i = first; i < last; ++i) {
+        maxCount = qMax(maxCount, buckets[i].count);
+    }
+
+    qint64 const width = TimeHistogram::bucketWidth(resolution);
+    qreal const scale = maxCount > 0 ? qreal(this->height() - 1) / maxCount : 0.0;
+    for (qsizetype i = first; i < last; ++i) {
+        TimeHistogram::Bucket const &bucket = buckets[i];
+        qreal const x = this->timestampToX(bucket.index * width);
+        qreal const barWidth = qMax(1.0, this->timestampToX((bucket.index + 1) * width) - x - 1.0);
+        qreal y = this->height();
+        for (qsizetype level = LogEntry::levelCount - 1; level >= 0; --level) {
+            qint32 const count = bucket.levelCounts[level];
+            if (count == 0) {
+                continue;
+            }
+            qreal const barHeight = count * scale;
+            painter.fillRect(QRectF(x, y - barHeight, barWidth, barHeight), LogStyle::levelColor(LogEntry::Level(level)));
+            y -= barHeight;
+        }
+    }
+
+    if (hasSelectedRange_) {
+        qreal const x = this->timestampToX(selectedStart_);
+        painter.fillRect(QRectF(x, 0.0, qMax(1.0, this->timestampToX(selectedEnd_ + 1) - x), this->height()), selectionColor);
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// The zoom is centered on the mouse cursor.
+///
+/// \param[in] event The event.
+//****************************************************************************************************************************************************
+void HistogramWidget::wheelEvent(QWheelEvent *event) {
+    if ((!log_) || (viewEnd_ <= viewStart_)) {
+        return;
+    }
+    qreal const steps = event->angleDelta().y() / 120.0;
+    qint64 const span = viewEnd_ - viewStart_;
+    qint64 const newSpan = qMax(minViewSpan, qint64(span * std::pow(zoomFactor, -steps)));
+    qint64 const anchor = this->xToTimestamp(event->position().x());
+    qint64 const newStart = anchor - qint64(qreal(anchor - viewStart_) * newSpan / span);
+    this->setView(newStart, newStart + newSpan);
+    event->accept();
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] event The event.
+//****************************************************************************************************************************************************
+void HistogramWidget::mousePressEvent(QMouseEvent *event) {
+    if (event->button() != Qt::LeftButton) {
+        return;
+    }
+    pressPos_ = event->position();
+    pressViewStart_ = viewStart_;
+    dragging_ = false;
+}
+
+
+//****************************************************************************************************************************************************
+/// When the left button is down, the view is panned. Otherwise, the content of the bucket under the cursor is displayed as a tool tip.
+///
+/// \param[in] event The event.
+//****************************************************************************************************************************************************
+void HistogramWidget::mouseMoveEvent(QMouseEvent *event) {
+    if (pressPos_) {
+        qreal const dx = event->position().x() - pressPos_->x();
+        dragging_ = dragging_ || (qAbs(dx) > dragThreshold);
+        if (dragging_ && (this->width() > 0)) {
+            qint64 const span = viewEnd_ - viewStart_;
+            qint64 const start = pressViewStart_ - qint64(dx * span / this->width());
+            this->setView(start, start + span);
+        }
+        return;
+    }
+
+    TimeHistogram::Bucket const *bucket = this->bucketAt(event->position().x());
+    if (!bucket) {
+        QToolTip::hideText();
+        return;
+    }
+    TimeHistogram::Resolution const resolution = this->resolution();
+    QString text = LogEntry::timestampToString(bucket->index * TimeHistogram::bucketWidth(resolution));
+    text.chop((resolution == TimeHistogram::Resolution::Second) ? 4 : 7); // drop the milliseconds, and the seconds for coarser resolutions.
+    text += QString("\n%1 entries").arg(bucket->count);
+    for (qsizetype level = LogEntry::levelCount - 1; level >= 0; --level) {
+        if (bucket->levelCounts[level] > 0) {
+            text += QString("\n%1: %2").arg(LogEntry::levelToString(LogEntry::Level(level))).arg(bucket->levelCounts[level]);
+        }
+    }
+    QToolTip::showText(event->globalPosition().toPoint(), text, this);
+}
+
+
+//****************************************************************************************************************************************************
+/// If the mouse was not dragged since it was pressed, the time range of the bucket under the cursor is emitted.
+///
+/// \param[in] event The event.
+//****************************************************************************************************************************************************
+void HistogramWidget::mouseReleaseEvent(QMouseEvent *event) {
+    if ((event->button() != Qt::LeftButton) || (!pressPos_)) {
+        return;
+    }
+    pressPos_.reset();
+    if (dragging_) {
+        dragging_ = false;
+        return;
+    }
+    TimeHistogram::Bucket const *bucket = this->bucketAt(event->position().x());
+    if (!bucket) {
+        return;
+    }
+    qint64 const width = TimeHistogram::bucketWidth(this->resolution());
+    emit bucketClicked(bucket->index * width, (bucket->index + 1) * width - 1);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] event The event.
+//****************************************************************************************************************************************************
+void HistogramWidget::mouseDoubleClickEvent(QMouseEvent *event) {
+    if (event->button() == Qt::LeftButton) {
+        this->resetView();
+    }
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void HistogramWidget::resetView() {
+    bool const hasLog = log_ && !log_->isEmpty() && (log_->startTimestamp() >= 0);
+    viewStart_ = hasLog ? log_->startTimestamp() : 0;
+    viewEnd_ = hasLog ? log_->endTimestamp() + 1 : 0;
+    this->update();
+}
+
+
+//****************************************************************************************************************************************************
+/// The time span is clamped to the time span of the log.
+///
+/// \param[in] start The start of the time span.
+/// \param[in] end The end of the time span (exclusive).
+//****************************************************************************************************************************************************
+void HistogramWidget::setView(qint64 start, qint64 end) {
+    if ((!log_) || log_->isEmpty()) {
+        return;
+    }
+    qint64 const logStart = log_->startTimestamp();
+    qint64 const logEnd = log_->endTimestamp() + 1;
+    qint64 const span = end - start;
+    if (span >= logEnd - logStart) {
+        viewStart_ = logStart;
+        viewEnd_ = logEnd;
+    } else {
+        viewStart_ = qBound(logStart, start, logEnd - span);
+        viewEnd_ = viewStart_ + span;
+    }
+    this->update();
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The finest resolution for which the bars of the displayed time span are at least minBarWidth pixels wide.
+//****************************************************************************************************************************************************
+TimeHistogram::Resolution HistogramWidget::resolution() const {
+    return TimeHistogram::resolutionForSpan(viewEnd_ - viewStart_, qMax(qsizetype(1), qsizetype(this->width() / minBarWidth)));
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] x The x coordinate.
+/// \return The timestamp at the x coordinate.
+//****************************************************************************************************************************************************
+qint64 HistogramWidget::xToTimestamp(qreal x) const {
+    if (this->width() <= 0) {
+        return viewStart_;
+    }
+    return viewStart_ + qint64(x * qreal(viewEnd_ - viewStart_) / this->width());
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] timestamp The timestamp.
+/// \return The x coordinate of the timestamp.
+//****************************************************************************************************************************************************
+qreal HistogramWidget::timestampToX(qint64 timestamp) const {
+    if (viewEnd_ <= viewStart_) {
+        return 0.0;
+    }
+    return qreal(timestamp - viewStart_) * this->width() / qreal(viewEnd_ - viewStart_);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] x The x coordinate.
+/// \return The non-empty bucket at the x coordinate, or a null pointer if there is none.
+//****************************************************************************************************************************************************
+TimeHistogram::Bucket const *HistogramWidget::bucketAt(qreal x) const {
+    if ((!log_) || (viewEnd_ <= viewStart_)) {
+        return nullptr;
+    }
+    TimeHistogram const &histogram = log_->timeHistogram();
+    TimeHistogram::Resolution const resolution = this->resolution();
+    qint64 const width = TimeHistogram::bucketWidth(resolution);
+    qint64 const start = (this->xToTimestamp(x) / width) * width;
+    auto const [first, last] = histogram.bucketRange(resolution, start, start + 1);
+    return (first < last) ? &histogram.buckets(resolution)[first] : nullptr;
+}
@@ -0,0 +1,69 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of time histogram widget class.
+
+
+#ifndef ANALOG_HISTOGRAM_WIDGET_H
+#define ANALOG_HISTOGRAM_WIDGET_H
+
+
+#include "Log.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Time histogram widget class.
+///
+/// The widget draws the number of entries per time bucket, stacked by level, using the precomputed time histogram of the log. The resolution is
+/// picked according to the displayed time span. The mouse wheel zooms, dragging pans, double-clicking resets the zoom, and clicking a bucket
+/// emits its time range.
+//****************************************************************************************************************************************************
+class HistogramWidget : public QWidget {
+    Q_OBJECT
+
+public: // member functions.
+    explicit HistogramWidget(QWidget *parent = nullptr); ///< Default constructor.
+    HistogramWidget(HistogramWidget const &) = delete; ///< Disabled copy-constructor.
+    HistogramWidget(HistogramWidget &&) = delete; ///< Disabled assignment copy-constructor.
+    ~HistogramWidget() override = default; ///< Destructor.
+    HistogramWidget& operator=(HistogramWidget const &) = delete; ///< Disabled assignment operator.
+    HistogramWidget& operator=(HistogramWidget &&) = delete; ///< Disabled move assignment operator.
+
+    void setLog(SPLog const &log); ///< Set the log.
+    void setSelectedRange(qint64 start, qint64 end); ///< Set the highlighted time range.
+    void clearSelectedRange(); ///< Clear the highlighted time range.
+    QSize sizeHint() const override; ///< Return the size hint for the widget.
+
+signals:
+    void bucketClicked(qint64 start, qint64 end); ///< Signal emitted when a bucket is clicked.
+
+protected: // member functions.
+    void paintEvent(QPaintEvent *event) override; ///< Paint the widget.
+    void wheelEvent(QWheelEvent *event) override; ///< Handle mouse wheel events.
+    void mousePressEvent(QMouseEvent *event) override; ///< Handle mouse press events.
+    void mouseMoveEvent(QMouseEvent *event) override; ///< Handle mouse move events.
+    void mouseReleaseEvent(QMouseEvent *event) override; ///< Handle mouse release events.
+    void mouseDoubleClickEvent(QMouseEvent *event) override; ///< Handle mouse double-click events.
+
+private: // member functions.
+    void resetView(); ///< Show the whole time span of the log.
+    void setView(qint64 start, qint64 end); ///< Set the displayed time span.
+    TimeHistogram::Resolution resolution() const; ///< Return the resolution for the displayed time span.
+    qint64 xToTimestamp(qreal x) const; ///< Convert a widget x coordinate to a timestamp.
+    qreal timestampToX(qint64 timestamp) const; ///< Convert a timestamp to a widget x coordinate.
+    TimeHistogram::Bucket const *bucketAt(qreal x) const; ///< Return the bucket at a widget x coordinate.
+
+private: // data members
+    SPLog log_; ///< The log.
+    qint64 viewStart_ { 0 }; ///< The start of the displayed time span.
+    qint64 viewEnd_ { 0 }; ///< The end of the displayed time span (exclusive).
+    bool hasSelectedRange_ { false }; ///< Is a time range highlighted.
+    qint64 selectedStart_ { 0 }; ///< The start of the highlighted time range.
+    qint64 selectedEnd_ { 0 }; ///< The end of the highlighted time range (inclusive).
+    std::optional<QPointF> pressPos_; ///< The position of the last mouse press, if the button is still down.
+    qint64 pressViewStart_ { 0 }; ///< The start of the displayed time span when the mouse was pressed.
+    bool dragging_ { false }; ///< Is the view being dragged.
+};
+
+
+#endif //ANALOG_HISTOGRAM_WIDGET_H
@@ -0,0 +1,337 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of instrumentation class.
+
+
+#include "Instrumentation.h"
+#include "Exception.h"
+#include "Tracer.h"
+
+
+namespace {
+
+
+qsizetype constexpr stageCount = qsizetype(Instrumentation::Stage::Count); ///< The number of stages.
+qsizetype constexpr counterCount = qsizetype(Instrumentation::Counter::Count); ///< The number of counters.
+
+
+std::atomic_bool enabled { false }; ///< Is instrumentation enabled?
+std::array<std::atomic<qint64>, stageCount> callCounts {}; ///< The number of calls of each stage.
+std::array<std::atomic<qint64>, stageCount> totalNs {}; ///< The total duration of each stage, in nanoseconds.
+std::array<std::atomic<qint64>, stageCount> maxNs {}; ///< The longest call of each stage, in nanoseconds.
+std::array<std::atomic<qint64>, counterCount> counters {}; ///< The counters.
+
+
+//****************************************************************************************************************************************************
+/// \brief Thread-local statistics, flushed to the global statistics explicitly, or when the thread exits.
+//****************************************************************************************************************************************************
+struct ThreadStats {
+    std::array<qint64, stageCount> callCounts {}; ///< The number of calls of each stage.
+    std::array<qint64, stageCount> totalNs {}; ///< The total duration of each stage, in nanoseconds.
+    std::array<qint64, stageCount> maxNs {}; ///< The longest call of each stage, in nanoseconds.
+    bool dirty { false }; ///< Does the structure contain statistics that have not been flushed?
+
+    ~ThreadStats() { Instrumentation::flushThread(); } ///< Destructor.
+};
+
+
+thread_local ThreadStats threadStats; ///< The thread-local statistics.
+
+
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] value The atomic value.
+/// \param[in] candidate The candidate maximum.
+//****************************************************************************************************************************************************
+void updateMax(std::atomic<qint64> &value, qint64 candidate) {
+    qint64 current = value.load(std::memory_order_relaxed);
+    while ((candidate > current) && (!value.compare_exchange_weak(current, candidate, std::memory_order_relaxed))) {
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// The name is a string literal, so it can be used as the name of a trace event.
+///
+/// \param[in] stage The stage.
+/// \return The name of the stage.
+//****************************************************************************************************************************************************
+char const *stageLiteral(Instrumentation::Stage stage) {
+    using Stage = Instrumentation::Stage;
+    switch (stage) {
+    case Stage::LogOpen:
+        return "logOpen";
+    case Stage::FileRead:
+        return "fileRead";
+    case Stage::Parsing:
+        return "parsing";
+    case Stage::Tokenizing:
+        return "tokenizing";
+    case Stage::FieldMap:
+        return "fieldMap";
+    case Stage::EntryMerge:
+        return "entryMerge";
+    case Stage::IndexBuilding:
+        return "indexBuilding";
+    case Stage::ModelReset:
+        return "modelReset";
+    case Stage::Filtering:
+        return "filtering";
+    case Stage::ProxyInvalidation:
+        return "proxyInvalidation";
+    case Stage::SourceModelChange:
+        return "sourceModelChange";
+    case Stage::LogLoaded:
+        return "logLoaded";
+    case Stage::ColumnSizing:
+        return "columnSizing";
+    case Stage::Count:
+    default:
+        return "unknown";
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] stage The stage.
+//****************************************************************************************************************************************************
+Instrumentation::ScopedTimer::ScopedTimer(Stage stage)
+    : stage_(stage) {
+    if (Instrumentation::isEnabled()) {
+        timer_.start();
+    }
+    if (Tracer::isEnabled()) {
+        traceStartNs_ = Tracer::now();
+    }
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+Instrumentation::ScopedTimer::~ScopedTimer() {
+    if (timer_.isValid()) {
+        Instrumentation::addTime(stage_, timer_.nsecsElapsed());
+    }
+    if (traceStartNs_ >= 0) {
+        Tracer::addEvent(stageLiteral(stage_), "stage", traceStartNs_, Tracer::now());
+    }
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+Instrumentation::LapTimer::LapTimer() {
+    if (Instrumentation::isEnabled()) {
+        timer_.start();
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// The duration is recorded in thread-local storage, and reaches the global statistics when flushThread() is called.
+///
+/// \param[in] stage The stage.
+//****************************************************************************************************************************************************
+void Instrumentation::LapTimer::lap(Stage stage) {
+    if (!timer_.isValid()) {
+        return;
+    }
+    qint64 const now = timer_.nsecsElapsed();
+    qint64 const ns = now - lastNs_;
+    lastNs_ = now;
+    qsizetype const index = qsizetype(stage);
+    ++threadStats.callCounts[index];
+    threadStats.totalNs[index] += ns;
+    threadStats.maxNs[index] = qMax(threadStats.maxNs[index], ns);
+    threadStats.dirty = true;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return true iff instrumentation is enabled.
+//****************************************************************************************************************************************************
+bool Instrumentation::isEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] value Should instrumentation be enabled?
+//****************************************************************************************************************************************************
+void Instrumentation::setEnabled(bool value) {
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+
+//****************************************************************************************************************************************************
+/// Thread-local statistics that have not been flushed yet are not reset.
+//****************************************************************************************************************************************************
+void Instrumentation::reset() {
+    for (qsizetype i = 0; i < stageCount; ++i) {
+        callCounts[i].store(0, std::memory_order_relaxed);
+        totalNs[i].store(0, std::memory_order_relaxed);
+        maxNs[i].store(0, std::memory_order_relaxed);
+    }
+    for (std::atomic<qint64> &counter: counters) {
+        counter.store(0, std::memory_order_relaxed);
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// When several calls are added at once, the longest call is unknown, and the mean duration of the calls is used instead.
+///
+/// \param[in] stage The stage.
+/// \param[in] ns The duration, in nanoseconds.
+/// \param[in] callCount The number of calls the duration corresponds to.
+//****************************************************************************************************************************************************
+void Instrumentation::addTime(Stage stage, qint64 ns, qint64 callCount) {
+    if ((!isEnabled()) || (callCount <= 0)) {
+        return;
+    }
+    qsizetype const index = qsizetype(stage);
+    callCounts[index].fetch_add(callCount, std::memory_order_relaxed);
+    totalNs[index].fetch_add(ns, std::memory_order_relaxed);
+    updateMax(maxNs[index], ns / callCount);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] counter The counter.
+/// \param[in] value The value to add.
+//****************************************************************************************************************************************************
+void Instrumentation::addCount(Counter counter, qint64 value) {
+    if (isEnabled()) {
+        counters[qsizetype(counter)].fetch_add(value, std::memory_order_relaxed);
+    }
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void Instrumentation::flushThread() {
+    if (!threadStats.dirty) {
+        return;
+    }
+    for (qsizetype i = 0; i < stageCount; ++i) {
+        if (threadStats.callCounts[i] == 0) {
+            continue;
+        }
+        callCounts[i].fetch_add(threadStats.callCounts[i], std::memory_order_relaxed);
+        totalNs[i].fetch_add(threadStats.totalNs[i], std::memory_order_relaxed);
+        updateMax(maxNs[i], threadStats.maxNs[i]);
+        threadStats.callCounts[i] = threadStats.totalNs[i] = threadStats.maxNs[i] = 0;
+    }
+    threadStats.dirty = false;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] stage The stage.
+/// \return The statistics of the stage.
+//****************************************************************************************************************************************************
+Instrumentation::StageStats Instrumentation::stageStats(Stage stage) {
+    qsizetype const index = qsizetype(stage);
+    return {
+        callCounts[index].load(std::memory_order_relaxed),
+        totalNs[index].load(std::memory_order_relaxed),
+        maxNs[index].load(std::memory_order_relaxed),
+    };
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] counter The counter.
+/// \return The value of the counter.
+//****************************************************************************************************************************************************
+qint64 Instrumentation::count(Counter counter) {
+    return counters[qsizetype(counter)].load(std::memory_order_relaxed);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] stage The stage.
+/// \return The name of the stage.
+//****************************************************************************************************************************************************
+QString Instrumentation::stageName(Stage stage) {
+    return QString::fromLatin1(stageLiteral(stage));
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] counter The counter.
+/// \return The name of the counter.
+//****************************************************************************************************************************************************
+QString Instrumentation::counterName(Counter counter) {
+    switch (counter) {
+    case Counter::FilesRead:
+        return "filesRead";
+    case Counter::BytesRead:
+        return "bytesRead";
+    case Counter::LinesRead:
+        return "linesRead";
+    case Counter::ValidEntries:
+        return "validEntries";
+    case Counter::InvalidEntries:
+        return "invalidEntries";
+    case Counter::FilterPasses:
+        return "filterPasses";
+    case Counter::FilteredRows:
+        return "filteredRows";
+    case Counter::Count:
+    default:
+        return "unknown";
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// The statistics of the calling thread are flushed first.
+///
+/// \return The statistics and counters as JSON.
+//****************************************************************************************************************************************************
+QJsonObject Instrumentation::toJson() {
+    flushThread();
+    QJsonObject stages;
+    for (qsizetype i = 0; i < stageCount; ++i) {
+        StageStats const stats = stageStats(Stage(i));
+        stages.insert(stageName(Stage(i)), QJsonObject {
+            { "callCount", stats.callCount },
+            { "totalMs", double(stats.totalNs) / 1.0e6 },
+            { "meanUs", stats.callCount ? double(stats.totalNs) / double(stats.callCount) / 1.0e3 : 0.0 },
+            { "maxMs", double(stats.maxNs) / 1.0e6 },
+        });
+    }
+    QJsonObject counterObject;
+    for (qsizetype i = 0; i < counterCount; ++i) {
+        counterObject.insert(counterName(Counter(i)), count(Counter(i)));
+    }
+    return {
+        { "enabled", isEnabled() },
+        { "stages", stages },
+        { "counters", counterObject },
+    };
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] filePath The path of the file.
+/// \param[in] extra Additional members added to the root object.
+//****************************************************************************************************************************************************
+void Instrumentation::saveJson(QString const &filePath, QJsonObject const &extra) {
+    QJsonObject root = toJson();
+    for (auto it = extra.begin(); it != extra.end(); ++it) {
+        root.insert(it.key(), it.value());
+    }
+    QByteArray const json = QJsonDocument(root).toJson(QJsonDocument::Indented);
+    QFile file(filePath);
+    if ((!file.open(QIODevice::WriteOnly | QIODevice::Truncate)) || (file.write(json) != json.size())) {
+        throw Exception(QString("Could not write to '%1'.").arg(QDir::toNativeSeparators(filePath)));
+    }
+}
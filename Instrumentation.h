@@ -0,0 +1,107 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of instrumentation class.
+
+
+#ifndef ANALOG_INSTRUMENTATION_H
+#define ANALOG_INSTRUMENTATION_H
+
+
+//****************************************************************************************************************************************************
+/// \brief Instrumentation class.
+///
+/// The class accumulates the time spent in each stage of the load and filter pipeline, and a few counters. Instrumentation is disabled by
+/// default, and a disabled timer only costs a relaxed atomic load. Statistics are stored in atomics, so they can be recorded from any
+/// thread. Per-line stages, like tokenizing, are accumulated in thread-local storage and flushed once per chunk of lines.
+//****************************************************************************************************************************************************
+class Instrumentation {
+public: // data types
+    enum class Stage {
+        LogOpen = 0, ///< Opening a log, from the first file read to the model reset.
+        FileRead, ///< Reading lines from log files.
+        Parsing, ///< Parsing a block of lines in parallel.
+        Tokenizing, ///< Tokenizing bridge entries. The time is summed over all threads.
+        FieldMap, ///< Building the field map of bridge entries. The time is summed over all threads.
+        EntryMerge, ///< Appending the parsed entries and errors to the log.
+        IndexBuilding, ///< Building the indices of the log.
+        ModelReset, ///< Resetting the log model.
+        Filtering, ///< Computing the rows accepted by the filter model.
+        ProxyInvalidation, ///< Rebuilding the proxy mapping of the filter model.
+        SourceModelChange, ///< Changing the log of the filter model, including the update of the views.
+        LogLoaded, ///< Updating the session widget after a log is loaded.
+        ColumnSizing, ///< Estimating the width of the columns.
+        Count, ///< The number of stages.
+    }; ///< Enumeration for stages.
+
+    enum class Counter {
+        FilesRead = 0, ///< The number of files read.
+        BytesRead, ///< The number of bytes read.
+        LinesRead, ///< The number of lines read.
+        ValidEntries, ///< The number of valid entries.
+        InvalidEntries, ///< The number of invalid entries.
+        FilterPasses, ///< The number of filter passes.
+        FilteredRows, ///< The number of rows tested by the filter.
+        Count, ///< The number of counters.
+    }; ///< Enumeration for counters.
+
+    struct StageStats {
+        qint64 callCount { 0 }; ///< The number of calls.
+        qint64 totalNs { 0 }; ///< The total duration, in nanoseconds.
+        qint64 maxNs { 0 }; ///< The longest duration of a call, in nanoseconds.
+    }; ///< Structure for stage statistics.
+
+    //************************************************************************************************************************************************
+    /// \brief Scoped timer class, that adds the duration of its scope to a stage, and records it as a trace event if tracing is enabled.
+    //************************************************************************************************************************************************
+    class ScopedTimer {
+    public: // member functions.
+        explicit ScopedTimer(Stage stage); ///< Default constructor.
+        ScopedTimer(ScopedTimer const &) = delete; ///< Disabled copy-constructor.
+        ScopedTimer(ScopedTimer &&) = delete; ///< Disabled assignment copy-constructor.
+        ~ScopedTimer(); ///< Destructor.
+        ScopedTimer& operator=(ScopedTimer const &) = delete; ///< Disabled assignment operator.
+        ScopedTimer& operator=(ScopedTimer &&) = delete; ///< Disabled move assignment operator.
+
+    private: // data members
+        Stage stage_; ///< The stage.
+        QElapsedTimer timer_; ///< The timer, only started if instrumentation is enabled.
+        qint64 traceStartNs_ { -1 }; ///< The start of the trace event, or -1 if tracing is disabled.
+    };
+
+    //************************************************************************************************************************************************
+    /// \brief Lap timer class, that adds the time elapsed since the previous lap to a stage, in thread-local storage.
+    //************************************************************************************************************************************************
+    class LapTimer {
+    public: // member functions.
+        LapTimer(); ///< Default constructor.
+        LapTimer(LapTimer const &) = delete; ///< Disabled copy-constructor.
+        LapTimer(LapTimer &&) = delete; ///< Disabled assignment copy-constructor.
+        ~LapTimer() = default; ///< Destructor.
+        LapTimer& operator=(LapTimer const &) = delete; ///< Disabled assignment operator.
+        LapTimer& operator=(LapTimer &&) = delete; ///< Disabled move assignment operator.
+
+        void lap(Stage stage); ///< Add the time elapsed since the previous lap to a stage.
+
+    private: // data members
+        QElapsedTimer timer_; ///< The timer, only started if instrumentation is enabled.
+        qint64 lastNs_ { 0 }; ///< The elapsed time at the previous lap, in nanoseconds.
+    };
+
+public: // static member functions.
+    static bool isEnabled(); ///< Check whether instrumentation is enabled.
+    static void setEnabled(bool enabled); ///< Enable or disable instrumentation.
+    static void reset(); ///< Reset all statistics and counters.
+    static void addTime(Stage stage, qint64 ns, qint64 callCount = 1); ///< Add a duration to a stage.
+    static void addCount(Counter counter, qint64 value = 1); ///< Add a value to a counter.
+    static void flushThread(); ///< Flush the thread-local statistics of the calling thread.
+    static StageStats stageStats(Stage stage); ///< Return the statistics of a stage.
+    static qint64 count(Counter counter); ///< Return the value of a counter.
+    static QString stageName(Stage stage); ///< Return the name of a stage.
+    static QString counterName(Counter counter); ///< Return the name of a counter.
+    static QJsonObject toJson(); ///< Return the statistics and counters as JSON.
+    static void saveJson(QString const &filePath, QJsonObject const &extra = {}); ///< Save the statistics and counters as a JSON file.
+};
+
+
+#endif //ANALOG_INSTRUMENTATION_H
@@ -6,6 +6,54 @@
 
 #include "Log.h"
 #include "Exception.h"
+#include "Instrumentation.h"
+#include "Parallel.h"
+#include "ReportEngine.h"
+#include "Tracer.h"
+
+
+namespace {
+qsizetype constexpr displayCacheSize = 8192; ///< The number of slots in the display cache. Must be larger than the number of visible rows.
+qsizetype constexpr parseBlockLineCount = 262144; ///< The number of lines read before they are parsed in parallel.
+qsizetype constexpr parseMinChunkSize = 8192; ///< The minimum number of lines parsed by a thread.
+qsizetype constexpr byteCountMinChunkSize = 65536; ///< The minimum number of entries whose heap size is computed by a thread.
+qint64 constexpr noTimestamp = std::numeric_limits<qint64>::max(); ///< The running minimum for rows that have no valid timestamp at or after them.
+qsizetype constexpr cancellationCheckInterval = 4096; ///< The number of lines read, parsed or indexed between two checks of the cancellation flag.
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The variant for the background color of the cells.
+//****************************************************************************************************************************************************
+QVariant &backgroundColorVariant() {
+    static QVariant color;
+    return color;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The variants for the foreground color of each level.
+//****************************************************************************************************************************************************
+std::array<QVariant, LogEntry::levelCount> &levelColorVariants() {
+    static std::array<QVariant, LogEntry::levelCount> colors;
+    return colors;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] level The level.
+/// \return The variant for the string of a level.
+//****************************************************************************************************************************************************
+QVariant const &levelStringVariant(LogEntry::Level level) {
+    static std::array<QVariant, LogEntry::levelCount> const strings = []() {
+        std::array<QVariant, LogEntry::levelCount> result;
+        for (qsizetype i = 0; i < LogEntry::levelCount; ++i) {
+            result[i] = LogEntry::levelToString(LogEntry::Level(i));
+        }
+        return result;
+    }();
+    return strings[qsizetype(level)];
+}
 
 
 //****************************************************************************************************************************************************
@@ -31,8 +79,22 @@ void Log::clear(bool resetModel) {
     }
 
     entries_.clear();
+    timestamps_.clear();
+    timeIndexMax_.clear();
+    timeIndexMin_.clear();
+    timeHistogram_.clear();
+    packages_.clear();
+    packageCounts_.clear();
+    packageIds_.clear();
+    facetIndex_.clear();
+    templateMiner_.clear();
+    templateIds_.clear();
+    anomalies_.clear();
+    displayCache_.clear();
     errors_.clear();
     format_ = LogEntry::Format::Unknown;
+    entriesHeapByteCount_ = 0;
+    compact_ = false;
 
     if (resetModel) {
         this->endResetModel();
@@ -53,16 +115,48 @@ void Log::open(QString const &filePath) {
 /// \param[in] filePaths The ordered list of files forming the log.
 //****************************************************************************************************************************************************
 void Log::open(QStringList const &filePaths) {
+    std::atomic_bool const cancelled { false };
+    this->open(filePaths, cancelled);
+}
+
+
+//****************************************************************************************************************************************************
+/// The cancellation flag is checked regularly while reading, parsing and indexing, so cancelling the opening of a large log on another
+/// thread takes effect within milliseconds. A cancelled log is left empty, and does not report errors.
+///
+/// \param[in] filePaths The ordered list of files forming the log.
+/// \param[in] cancelled A flag that is set if the opening should be cancelled.
+//****************************************************************************************************************************************************
+void Log::open(QStringList const &filePaths, std::atomic_bool const &cancelled) {
+    Instrumentation::ScopedTimer const timer(Instrumentation::Stage::LogOpen);
     this->clear();
     this->beginResetModel();
     try {
         for (QString const &filePath: filePaths) {
-            this->appendFileContent(filePath);
+            if (cancelled) {
+                break;
+            }
+            this->appendFileContent(filePath, cancelled);
         }
     } catch (Exception const &e) {
         errors_ = { e.message() };
     }
-    this->endResetModel();
+    {
+        Instrumentation::ScopedTimer const indexTimer(Instrumentation::Stage::IndexBuilding);
+        this->buildIndices(cancelled);
+    }
+    if (!cancelled) {
+        this->computeEntriesHeapByteCount(cancelled);
+    }
+    if (cancelled) {
+        this->clear(false);
+        this->endResetModel();
+        return;
+    }
+    {
+        Instrumentation::ScopedTimer const resetTimer(Instrumentation::Stage::ModelReset);
+        this->endResetModel();
+    }
 
     if (!errors_.isEmpty()) {
         emit logErrorsOccurred(errors_);
@@ -92,30 +186,31 @@ int Log::columnCount(QModelIndex const &) const {
 /// \return The data for a given role at a model index.
 //****************************************************************************************************************************************************
 QVariant Log::data(QModelIndex const &index, int role) const {
-    LogEntry const &entry = entries_[index.row()];
-    if (role == Qt::DisplayRole) {
+    Tracer::countBurstCall("Log::data", "paint");
+    int const row = index.row();
+    switch (role) {
+    case Qt::DisplayRole:
         switch (index.column()) {
         case 0:
-            return entry.dateTime().toString("yyyy-MM-dd HH:mm:ss.zzz");
+            return this->displayCacheSlot(row).time;
         case 1:
-            return LogEntry::levelToString(entry.level());
+            return levelStringVariant(entries_[row].level());
         case 2:
-            return entry.package();
+            return packages_[packageIds_[row]];
         case 3:
-            return entry.message();
+            return this->displayCacheSlot(row).message;
         case 4:
-            return entry.fieldsString();
+            return this->displayCacheSlot(row).fields;
         default:
             return {};
         }
+    case Qt::ForegroundRole:
+        return levelColorVariants()[qsizetype(entries_[row].level())];
+    case Qt::BackgroundRole:
+        return backgroundColorVariant();
+    default:
+        return {};
     }
-    if (role == Qt::ForegroundRole) {
-        return LogEntry::levelColor(entry.level());
-    }
-    if (role == Qt::BackgroundRole) {
-        return QColor("#2b2d30");
-    }
-    return {};
 }
 
 //****************************************************************************************************************************************************
@@ -163,17 +258,10 @@ bool Log::isEmpty() const {
 
 //****************************************************************************************************************************************************
 /// \return the report.
+/// \throw Exception if the log is empty.
 //****************************************************************************************************************************************************
 Report Log::generateReport() const {
-    if (entries_.isEmpty()) {
-        throw Exception("Empty log");
-    }
-
-    Report report;
-    report.startDate = entries_.front().dateTime();
-    report.endDate = entries_.back().dateTime();
-
-    return report;
+    return ReportEngine::generate(*this);
 }
 
 
@@ -193,6 +281,207 @@ QStringList Log::errors() const {
 }
 
 
+//****************************************************************************************************************************************************
+/// \return The format of the log, or LogEntry::Format::Unknown if no log is loaded.
+//****************************************************************************************************************************************************
+LogEntry::Format Log::format() const {
+    return format_;
+}
+
+
+//****************************************************************************************************************************************************
+/// The timestamp of an entry whose time could not be parsed is the timestamp of the previous valid entry, so it can be used for searching and
+/// sorting, but not for display. Use LogEntry::timestamp() to display the time of an entry.
+///
+/// \param[in] row The row.
+/// \return The timestamp of the entry at the given row.
+//****************************************************************************************************************************************************
+qint64 Log::timestamp(qsizetype row) const {
+    return timestamps_[row];
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The smallest valid timestamp in the log.
+/// \return LogEntry::invalidTimestamp if the log contains no valid timestamp.
+//****************************************************************************************************************************************************
+qint64 Log::startTimestamp() const {
+    return (timeIndexMin_.isEmpty() || (timeIndexMin_.front() == noTimestamp)) ? LogEntry::invalidTimestamp : timeIndexMin_.front();
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The largest timestamp in the log.
+/// \return LogEntry::invalidTimestamp if the log contains no valid timestamp.
+//****************************************************************************************************************************************************
+qint64 Log::endTimestamp() const {
+    return timeIndexMax_.isEmpty() ? LogEntry::invalidTimestamp : timeIndexMax_.back();
+}
+
+
+//****************************************************************************************************************************************************
+/// Entries are expected to be in chronological order, but small out-of-order runs are tolerated: the search is performed on the running maximum
+/// of the timestamps, so the returned row is the first one at which the log reached the given time. The search is O(log n).
+///
+/// \param[in] timestamp The timestamp.
+/// \return The first row whose timestamp is greater or equal to timestamp.
+/// \return The number of rows if there is no such row.
+//****************************************************************************************************************************************************
+qsizetype Log::firstRowAtOrAfter(qint64 timestamp) const {
+    return std::lower_bound(timeIndexMax_.begin(), timeIndexMax_.end(), timestamp) - timeIndexMax_.begin();
+}
+
+
+//****************************************************************************************************************************************************
+/// The returned range [first, last) is guaranteed to contain all the rows whose timestamp is within [start, end], even in case of local
+/// out-of-order runs, but it may also contain a few rows that are outside the time range. The search is O(log n).
+///
+/// \param[in] start The start of the time range.
+/// \param[in] end The end of the time range (inclusive).
+/// \return The row range.
+//****************************************************************************************************************************************************
+std::pair<qsizetype, qsizetype> Log::rowRangeForTimeRange(qint64 start, qint64 end) const {
+    qsizetype const first = this->firstRowAtOrAfter(start);
+    qsizetype const last = std::upper_bound(timeIndexMin_.begin(), timeIndexMin_.end(), end) - timeIndexMin_.begin();
+    return { first, qMax(first, last) };
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The list of distinct packages in the log.
+//****************************************************************************************************************************************************
+QStringList const &Log::packages() const {
+    return packages_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The number of entries for each package, in the same order as packages().
+//****************************************************************************************************************************************************
+QList<qsizetype> const &Log::packageCounts() const {
+    return packageCounts_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return A constant reference to the field facet index.
+//****************************************************************************************************************************************************
+FacetIndex const &Log::facetIndex() const {
+    return facetIndex_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return A constant reference to the message template miner.
+//****************************************************************************************************************************************************
+TemplateMiner const &Log::templateMiner() const {
+    return templateMiner_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return A constant reference to the template identifiers of the entries.
+//****************************************************************************************************************************************************
+QList<qint32> const &Log::templateIds() const {
+    return templateIds_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The time histogram.
+//****************************************************************************************************************************************************
+TimeHistogram const &Log::timeHistogram() const {
+    return timeHistogram_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The detected anomalies, sorted by start time.
+//****************************************************************************************************************************************************
+QList<BurstDetector::Anomaly> const &Log::anomalies() const {
+    return anomalies_;
+}
+
+
+//****************************************************************************************************************************************************
+/// The heap size of the entries is computed when the log is opened, so this function does not iterate over the entries.
+///
+/// \return The estimated memory usage of the log, by component.
+//****************************************************************************************************************************************************
+MemoryUsage Log::memoryUsage() const {
+    MemoryUsage result;
+    result.add("entries", MemoryUsage::listByteCount(entries_) + entriesHeapByteCount_);
+    result.add("errors", MemoryUsage::stringListByteCount(errors_));
+    result.add("timeIndex", MemoryUsage::listByteCount(timestamps_) + MemoryUsage::listByteCount(timeIndexMax_)
+        + MemoryUsage::listByteCount(timeIndexMin_));
+    result.add("timeHistogram", timeHistogram_.byteCount());
+    result.add("packages", MemoryUsage::stringListByteCount(packages_) + MemoryUsage::listByteCount(packageCounts_)
+        + MemoryUsage::listByteCount(packageIds_));
+    result.add("facetIndex", facetIndex_.byteCount());
+    result.add("templates", templateMiner_.byteCount() + MemoryUsage::listByteCount(templateIds_));
+    qint64 anomalyByteCount = MemoryUsage::listByteCount(anomalies_);
+    for (BurstDetector::Anomaly const &anomaly: anomalies_) {
+        anomalyByteCount += MemoryUsage::stringByteCount(anomaly.label);
+    }
+    result.add("anomalies", anomalyByteCount);
+    qint64 displayCacheByteCount = MemoryUsage::listByteCount(displayCache_);
+    for (DisplayCacheSlot const &slot: displayCache_) {
+        displayCacheByteCount += MemoryUsage::stringByteCount(slot.time) + MemoryUsage::stringByteCount(slot.message)
+            + MemoryUsage::stringByteCount(slot.fields);
+    }
+    result.add("displayCache", displayCacheByteCount);
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// In compact mode, the timestamp column, the time index, the time histogram and the facet index are released, as they can be rebuilt from
+/// the entries, as well as the display cache and the template cache, and the unused capacity of the remaining lists. A compact log must not
+/// be displayed, searched or sorted until expand() is called. The entries of the log are not modified.
+//****************************************************************************************************************************************************
+void Log::compact() {
+    if (compact_) {
+        return;
+    }
+    entries_.squeeze();
+    errors_.squeeze();
+    timestamps_ = QList<qint64>();
+    timeIndexMax_ = QList<qint64>();
+    timeIndexMin_ = QList<qint64>();
+    timeHistogram_.clear();
+    facetIndex_.clear();
+    packageIds_.squeeze();
+    templateIds_.squeeze();
+    templateMiner_.releaseCache();
+    displayCache_ = QList<DisplayCacheSlot>();
+    compact_ = true;
+}
+
+
+//****************************************************************************************************************************************************
+/// The indices are rebuilt on the calling thread. The template cache is not rebuilt, as it is only used while mining templates, and the
+/// display cache fills up again as rows are displayed.
+//****************************************************************************************************************************************************
+void Log::expand() {
+    if (!compact_) {
+        return;
+    }
+    std::atomic_bool const cancelled { false };
+    this->buildTimeIndex(cancelled);
+    this->buildTimeHistogram(cancelled);
+    this->buildFacetIndex(cancelled);
+    compact_ = false;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return true iff the log is in compact mode.
+//****************************************************************************************************************************************************
+bool Log::isCompact() const {
+    return compact_;
+}
+
+
 //****************************************************************************************************************************************************
 /// \param[in] line A log line
 //****************************************************************************************************************************************************
@@ -209,10 +498,25 @@ LogEntry::Format Log::getLogFormat(QString const &line) {
 }
 
 
+//****************************************************************************************************************************************************
+/// The colors are provided by the GUI, so the log does not depend on Qt GUI. Until this function is called, no color is returned for the
+/// foreground and background roles.
+///
+/// \param[in] levelColors The foreground color of each level.
+/// \param[in] backgroundColor The background color.
+//****************************************************************************************************************************************************
+void Log::setDisplayColors(std::array<QVariant, LogEntry::levelCount> const &levelColors, QVariant const &backgroundColor) {
+    levelColorVariants() = levelColors;
+    backgroundColorVariant() = backgroundColor;
+}
+
+
 //****************************************************************************************************************************************************
 /// \param[in] filePath The path of the file.
+/// \param[in] cancelled A flag that is set if the reading should be cancelled.
 //****************************************************************************************************************************************************
-void Log::appendFileContent(QString const &filePath) {
+void Log::appendFileContent(QString const &filePath, std::atomic_bool const &cancelled) {
+    Tracer::Scope const fileScope("Log::appendFileContent", "io");
     try {
         QFile file(filePath);
         if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
@@ -223,8 +527,8 @@ void Log::appendFileContent(QString const &filePath) {
             throw Exception(QString("The file '%1' is empty.").arg(QDir::toNativeSeparators(filePath)));
         }
 
-        QString const line = QString::fromUtf8(file.readLine());
-        LogEntry::Format const format = Log::getLogFormat(line);
+        QByteArray const line = file.readLine();
+        LogEntry::Format const format = Log::getLogFormat(QString::fromUtf8(line));
         if (format == LogEntry::Format::Unknown) {
             throw Exception(QString("The file '%1' is not of a known log format.").arg(QDir::toNativeSeparators(filePath)));
         }
@@ -233,22 +537,273 @@ void Log::appendFileContent(QString const &filePath) {
         }
         format_ = format;
 
-        LogEntry entry(line, format_);
+        // When instrumentation is enabled, reading is timed line by line, and the duration is recorded once per block. Lines are kept in UTF-8.
+        bool const instrumented = Instrumentation::isEnabled();
+        Instrumentation::addCount(Instrumentation::Counter::FilesRead);
+        Instrumentation::addCount(Instrumentation::Counter::BytesRead, file.size());
+        QElapsedTimer lineTimer;
+        qint64 readNs = 0;
+        bool const traced = Tracer::isEnabled();
+        qint64 readStartNs = traced ? Tracer::now() : 0;
+
+        // Lines are read by blocks, and the lines of a block are parsed in parallel, each thread producing the entries of a contiguous chunk.
+        QByteArrayList lines { line };
+        lines.reserve(parseBlockLineCount);
         int errCount = 0;
-        do {
-            if (entry.isValid()) {
-                entries_.append(entry);
-            } else {
-                errors_.append(
-                    QString("%1: Invalid log entry at line %2: %3").arg(
-                        QFileInfo(filePath).fileName()).arg(entries_.count() + errCount + 1).arg(entry.error()
-                    )
-                );
-                ++errCount;
+        while (true) {
+            if ((lines.count() % cancellationCheckInterval == 0) && cancelled) {
+                return;
+            }
+            bool const atEnd = file.atEnd();
+            if ((!atEnd) && instrumented) {
+                lineTimer.start();
+                lines.append(file.readLine());
+                readNs += lineTimer.nsecsElapsed();
+            } else if (!atEnd) {
+                lines.append(file.readLine());
+            }
+            if ((!atEnd) && (lines.count() < parseBlockLineCount)) {
+                continue;
             }
-            entry = LogEntry(QString::fromUtf8(file.readLine()), format_);
-        } while (!file.atEnd());
+
+            Instrumentation::addTime(Instrumentation::Stage::FileRead, readNs, lines.count());
+            Instrumentation::addCount(Instrumentation::Counter::LinesRead, lines.count());
+            readNs = 0;
+            if (traced) {
+                Tracer::addEvent("read lines", "io", readStartNs, Tracer::now(), "lines", lines.count());
+            }
+
+            std::vector<QList<LogEntry>> chunks(parallelChunkCount(lines.count(), parseMinChunkSize));
+            QByteArray *const lineData = lines.data(); // the lines are moved to the entries, each thread accessing its own chunk.
+            {
+                Instrumentation::ScopedTimer const parseTimer(Instrumentation::Stage::Parsing);
+                parallelFor(lines.count(), parseMinChunkSize, [&](qsizetype chunkIndex, qsizetype begin, qsizetype end) {
+                    Tracer::Scope const chunkScope("parse chunk", "parse", "lines", end - begin);
+                    QList<LogEntry> &chunk = chunks[chunkIndex];
+                    chunk.reserve(end - begin);
+                    for (qsizetype i = begin; i < end; ++i) {
+                        if (((i - begin) % cancellationCheckInterval == 0) && cancelled) {
+                            break;
+                        }
+                        chunk.append(LogEntry(std::move(lineData[i]), format_));
+                    }
+                    Instrumentation::flushThread();
+                });
+            }
+            lines.clear();
+            if (cancelled) {
+                return;
+            }
+            Instrumentation::ScopedTimer const mergeTimer(Instrumentation::Stage::EntryMerge);
+            qsizetype const previousEntryCount = entries_.count();
+            int const previousErrCount = errCount;
+            for (QList<LogEntry> &chunk: chunks) {
+                for (LogEntry &entry: chunk) {
+                    if (entry.isValid()) {
+                        entries_.append(std::move(entry));
+                    } else {
+                        errors_.append(
+                            QString("%1: Invalid log entry at line %2: %3").arg(
+                                QFileInfo(filePath).fileName()).arg(entries_.count() + errCount + 1).arg(entry.error()
+                            )
+                        );
+                        ++errCount;
+                    }
+                }
+            }
+            Instrumentation::addCount(Instrumentation::Counter::ValidEntries, entries_.count() - previousEntryCount);
+            Instrumentation::addCount(Instrumentation::Counter::InvalidEntries, errCount - previousErrCount);
+            if (atEnd) {
+                break;
+            }
+            if (traced) {
+                readStartNs = Tracer::now();
+            }
+        }
     } catch (Exception const &e) {
         errors_.append(e.message());
     }
 }
+
+
+//****************************************************************************************************************************************************
+/// \param[in] cancelled A flag that is set if the indexing should be cancelled. It is checked between indices, and regularly while each index
+/// is built. Indices left incomplete are discarded, as a cancelled log is cleared.
+//****************************************************************************************************************************************************
+void Log::buildIndices(std::atomic_bool const &cancelled) {
+    for (void (Log::*build)(std::atomic_bool const &): { &Log::buildTimeIndex, &Log::buildTimeHistogram, &Log::buildPackageDictionary,
+        &Log::buildFacetIndex, &Log::buildTemplates, &Log::buildAnomalies }) {
+        if (cancelled) {
+            return;
+        }
+        (this->*build)(cancelled);
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// Entries whose time cannot be parsed are given the timestamp of the previous entry. Entries before the first valid timestamp keep an invalid
+/// timestamp, and are left out of the running minimum, so they do not hide the start of the log.
+///
+/// \param[in] cancelled A flag that is set if the indexing should be cancelled.
+//****************************************************************************************************************************************************
+void Log::buildTimeIndex(std::atomic_bool const &cancelled) {
+    qsizetype const count = entries_.count();
+    timestamps_.resize(count);
+    timeIndexMax_.resize(count);
+    timeIndexMin_.resize(count);
+
+    qint64 previous = LogEntry::invalidTimestamp;
+    qint64 runningMax = LogEntry::invalidTimestamp;
+    for (qsizetype i = 0; i < count; ++i) {
+        if ((i % cancellationCheckInterval == 0) && cancelled) {
+            return;
+        }
+        qint64 const ts = entries_[i].timestamp();
+        previous = (ts == LogEntry::invalidTimestamp) ? previous : ts;
+        timestamps_[i] = previous;
+        runningMax = qMax(runningMax, previous);
+        timeIndexMax_[i] = runningMax;
+    }
+
+    qint64 runningMin = noTimestamp;
+    for (qsizetype i = count - 1; i >= 0; --i) {
+        if ((i % cancellationCheckInterval == 0) && cancelled) {
+            return;
+        }
+        qint64 const ts = timestamps_[i];
+        runningMin = (ts == LogEntry::invalidTimestamp) ? runningMin : qMin(runningMin, ts);
+        timeIndexMin_[i] = runningMin;
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// A Bridge log only has a few dozen distinct packages, so the lookup table stays tiny. The lookup is performed on the UTF-8 packages, and a
+/// package is only converted to a string the first time it is encountered.
+///
+/// \param[in] cancelled A flag that is set if the indexing should be cancelled.
+//****************************************************************************************************************************************************
+void Log::buildPackageDictionary(std::atomic_bool const &cancelled) {
+    QHash<QByteArrayView, qint32> lookup; // the keys are views on the entries, that are not modified while the dictionary is built.
+    packageIds_.resize(entries_.count());
+    for (qsizetype i = 0; i < entries_.count(); ++i) {
+        if ((i % cancellationCheckInterval == 0) && cancelled) {
+            return;
+        }
+        QUtf8StringView const package = entries_[i].packageUtf8();
+        QByteArrayView const key(package.data(), package.size());
+        auto it = lookup.constFind(key);
+        if (it == lookup.constEnd()) {
+            it = lookup.insert(key, qint32(packages_.count()));
+            packages_.append(package.toString());
+            packageCounts_.append(0);
+        }
+        packageIds_[i] = it.value();
+        ++packageCounts_[it.value()];
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] cancelled A flag that is set if the indexing should be cancelled.
+//****************************************************************************************************************************************************
+void Log::buildFacetIndex(std::atomic_bool const &cancelled) {
+    for (qsizetype i = 0; i < entries_.count(); ++i) {
+        if ((i % cancellationCheckInterval == 0) && cancelled) {
+            return;
+        }
+        facetIndex_.addEntry(qint32(i), entries_[i]);
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// This function relies on the timestamp column, and must be called after buildTimeIndex().
+///
+/// \param[in] cancelled A flag that is set if the indexing should be cancelled.
+//****************************************************************************************************************************************************
+void Log::buildTimeHistogram(std::atomic_bool const &cancelled) {
+    timeHistogram_.build(entries_, timestamps_, cancelled);
+}
+
+
+//****************************************************************************************************************************************************
+/// This function relies on the timestamp column, and must be called after buildTimeIndex().
+///
+/// \param[in] cancelled A flag that is set if the indexing should be cancelled.
+//****************************************************************************************************************************************************
+void Log::buildTemplates(std::atomic_bool const &cancelled) {
+    templateIds_.resize(entries_.count());
+    for (qsizetype i = 0; i < entries_.count(); ++i) {
+        if ((i % cancellationCheckInterval == 0) && cancelled) {
+            return;
+        }
+        templateIds_[i] = templateMiner_.addEntry(entries_[i], timestamps_[i]);
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// This function relies on the timestamp column, the package dictionary and the message templates, and must be called after buildTimeIndex(),
+/// buildPackageDictionary() and buildTemplates().
+///
+/// \param[in] cancelled A flag that is set if the indexing should be cancelled.
+//****************************************************************************************************************************************************
+void Log::buildAnomalies(std::atomic_bool const &cancelled) {
+    QStringList templates;
+    for (TemplateMiner::Template const &tmpl: templateMiner_.templates()) {
+        templates.append(tmpl.text());
+    }
+    BurstDetector detector(packages_, templates);
+    for (qsizetype i = 0; i < entries_.count(); ++i) {
+        if ((i % cancellationCheckInterval == 0) && cancelled) {
+            return;
+        }
+        detector.addEntry(timestamps_[i], entries_[i].level(), packageIds_[i], templateIds_[i]);
+    }
+    anomalies_ = detector.anomalies();
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] cancelled A flag that is set if the computation should be cancelled. The byte count is meaningless if it is.
+//****************************************************************************************************************************************************
+void Log::computeEntriesHeapByteCount(std::atomic_bool const &cancelled) {
+    QList<LogEntry> const &entries = entries_;
+    std::vector<qint64> chunkByteCounts(parallelChunkCount(entries.count(), byteCountMinChunkSize), 0);
+    parallelFor(entries.count(), byteCountMinChunkSize, [&](qsizetype chunkIndex, qsizetype begin, qsizetype end) {
+        qint64 byteCount = 0;
+        for (qsizetype i = begin; i < end; ++i) {
+            if (((i - begin) % cancellationCheckInterval == 0) && cancelled) {
+                return;
+            }
+            byteCount += entries[i].heapByteCount();
+        }
+        chunkByteCounts[chunkIndex] = byteCount;
+    });
+    entriesHeapByteCount_ = std::accumulate(chunkByteCounts.begin(), chunkByteCounts.end(), qint64(0));
+}
+
+
+//****************************************************************************************************************************************************
+/// The cache is direct-mapped: a row can only be stored in the slot row % displayCacheSize. As visible rows are contiguous, scrolling and
+/// repainting do not cause any formatting or allocation once the visible rows are cached.
+///
+/// \param[in] row The row.
+/// \return The display cache slot for the row.
+//****************************************************************************************************************************************************
+Log::DisplayCacheSlot const &Log::displayCacheSlot(int row) const {
+    if (displayCache_.isEmpty()) {
+        displayCache_.resize(displayCacheSize);
+    }
+    DisplayCacheSlot &slot = displayCache_[row % displayCacheSize];
+    if (slot.row != row) {
+        slot.row = row;
+        slot.time = LogEntry::timestampToString(entries_[row].timestamp()); // not timestamps_, so invalid times are displayed empty.
+        slot.message = entries_[row].message();
+        slot.fields = entries_[row].fieldsString();
+    }
+    return slot;
+}
+
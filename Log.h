@@ -8,9 +8,14 @@
 #define ANALOG_LOG_H
 
 
+#include "BurstDetector.h"
+#include "FacetIndex.h"
 #include "FilenameInfo.h"
 #include "LogEntry.h"
+#include "MemoryUsage.h"
 #include "Report.h"
+#include "TemplateMiner.h"
+#include "TimeHistogram.h"
 
 
 //****************************************************************************************************************************************************
@@ -31,6 +36,7 @@ public: // member functions.
     void clear(bool resetModel = true); ///< Clear the content of the log.
     void open(QString const &filePath); ///< Open a log from file.
     void open(QStringList const &filePaths); ///< Open a log from an ordered list of files.
+    void open(QStringList const &filePaths, std::atomic_bool const &cancelled); ///< Open a log from an ordered list of files, unless cancelled.
     int rowCount(QModelIndex const &parent) const override; ///< Get the number of rows in the model.
     int columnCount(QModelIndex const &parent) const override; ///< Get the number of columns in the model.
     QVariant data(QModelIndex const &index, int role) const override; ///< Get the data at an index in the model.
@@ -41,20 +47,70 @@ public: // member functions.
     Report generateReport() const; ///< Generates a report from the log.
     bool hasErrors() const; ///< Returns true iff errors where encountered while parsing the log.
     QStringList errors() const; ///< Returns the error encountered while parsing the log.
+    LogEntry::Format format() const; ///< Returns the format of the log.
+    qint64 timestamp(qsizetype row) const; ///< Returns the timestamp of the entry at a given row, for searching and sorting.
+    qint64 startTimestamp() const; ///< Returns the smallest timestamp in the log.
+    qint64 endTimestamp() const; ///< Returns the largest timestamp in the log.
+    qsizetype firstRowAtOrAfter(qint64 timestamp) const; ///< Returns the first row whose timestamp is greater or equal to a timestamp.
+    std::pair<qsizetype, qsizetype> rowRangeForTimeRange(qint64 start, qint64 end) const; ///< Returns the row range containing a time range.
+    QStringList const &packages() const; ///< Returns the distinct packages of the log.
+    QList<qsizetype> const &packageCounts() const; ///< Returns the number of entries for each package.
+    FacetIndex const &facetIndex() const; ///< Returns the field facet index.
+    TemplateMiner const &templateMiner() const; ///< Returns the message template miner.
+    QList<qint32> const &templateIds() const; ///< Returns the message template identifier of each entry.
+    TimeHistogram const &timeHistogram() const; ///< Returns the time histogram.
+    QList<BurstDetector::Anomaly> const &anomalies() const; ///< Returns the detected anomalies.
+    MemoryUsage memoryUsage() const; ///< Returns the estimated memory usage of the log, by component.
+    void compact(); ///< Release the memory of the indices that can be rebuilt from the entries.
+    void expand(); ///< Rebuild the indices released by compact().
+    bool isCompact() const; ///< Check if the log is in compact mode.
+
+public: // static member functions.
+    static LogEntry::Format getLogFormat(QString const &file); ///< Determines the log file format.
+    static void setDisplayColors(std::array<QVariant, LogEntry::levelCount> const &levelColors,
+        QVariant const &backgroundColor); ///< Set the colors returned for the foreground and background roles.
 
 signals:
     void logErrorsOccurred(QStringList const& list); ///< Signal emitted when errors occured while opening a log.
 
-private: // static member functions.
-    static LogEntry::Format getLogFormat(QString const &file); ///< Determines the log file format.
+private: // data types
+    struct DisplayCacheSlot {
+        qint32 row { -1 }; ///< The row cached in the slot, or -1 if the slot is empty.
+        QString time; ///< The formatted time.
+        QString message; ///< The message, converted from UTF-8.
+        QString fields; ///< The formatted fields.
+    }; ///< Structure for a slot of the display cache.
 
 private: // member functions.
-    void appendFileContent(QString const &filePath); ///< Append the content of a file to the log.
+    void appendFileContent(QString const &filePath, std::atomic_bool const &cancelled); ///< Append the content of a file to the log.
+    void buildIndices(std::atomic_bool const &cancelled); ///< Build the indices of the log.
+    DisplayCacheSlot const &displayCacheSlot(int row) const; ///< Return the display cache slot for a row, formatting it if needed.
+    void buildTimeIndex(std::atomic_bool const &cancelled); ///< Build the timestamp column and the time index.
+    void buildTimeHistogram(std::atomic_bool const &cancelled); ///< Build the time histogram.
+    void buildPackageDictionary(std::atomic_bool const &cancelled); ///< Build the package dictionary.
+    void buildFacetIndex(std::atomic_bool const &cancelled); ///< Build the field facet index.
+    void buildTemplates(std::atomic_bool const &cancelled); ///< Assign a message template to each entry.
+    void buildAnomalies(std::atomic_bool const &cancelled); ///< Detect bursts and anomalies.
+    void computeEntriesHeapByteCount(std::atomic_bool const &cancelled); ///< Compute the estimated heap size of the entries.
 
 public: // data members
     LogEntry::Format format_ { LogEntry::Format::Unknown }; ///< The log format.
     QStringList errors_; ///< The errors encountered while passing the log.
     QList<LogEntry> entries_; ///< The log entries.
+    QList<qint64> timestamps_; ///< The timestamps of the entries. Invalid timestamps are replaced by the previous valid one.
+    QList<qint64> timeIndexMax_; ///< The running maximum of the timestamps, in row order.
+    QList<qint64> timeIndexMin_; ///< The running minimum of the valid timestamps, in reverse row order.
+    TimeHistogram timeHistogram_; ///< The time histogram.
+    QStringList packages_; ///< The package dictionary, i.e. the distinct packages in order of first appearance.
+    QList<qsizetype> packageCounts_; ///< The number of entries for each package in the dictionary.
+    QList<qint32> packageIds_; ///< The index in the package dictionary of the package of each entry.
+    FacetIndex facetIndex_; ///< The field facet index.
+    TemplateMiner templateMiner_; ///< The message template miner.
+    QList<qint32> templateIds_; ///< The message template identifier of each entry.
+    QList<BurstDetector::Anomaly> anomalies_; ///< The detected anomalies, sorted by start time.
+    mutable QList<DisplayCacheSlot> displayCache_; ///< The direct-mapped cache of formatted display strings.
+    qint64 entriesHeapByteCount_ { 0 }; ///< The estimated heap size of the entries, computed once the log is opened.
+    bool compact_ { false }; ///< Is the log in compact mode?
 };
 
 
@@ -0,0 +1,197 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of log cache class.
+
+
+#include "LogCache.h"
+
+
+namespace {
+
+
+//****************************************************************************************************************************************************
+/// \brief Structure for cached logs.
+//****************************************************************************************************************************************************
+struct CachedLog {
+    QStringList filePaths; ///< The files of the log.
+    SPLog log; ///< The log.
+    qint64 byteCount { 0 }; ///< The estimated memory usage of the log, in bytes.
+};
+
+
+QList<CachedLog> cachedLogs; ///< The cached logs, from the least to the most recently used.
+qint64 memoryBudget = LogCache::defaultBudget; ///< The memory budget, in bytes.
+
+
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The total estimated memory usage of the cached logs, in bytes.
+//****************************************************************************************************************************************************
+qint64 cachedByteCount() {
+    return std::accumulate(cachedLogs.begin(), cachedLogs.end(), qint64(0), [](qint64 acc, CachedLog const &cached) -> qint64 {
+        return acc + cached.byteCount;
+    });
+}
+
+
+//****************************************************************************************************************************************************
+/// The least recently used logs are compacted first, as a compact log is restored much faster than an evicted log is parsed again. Logs are
+/// only evicted if compacting all of them is not enough.
+///
+/// Logs that are referenced outside the cache, e.g. by a view, cannot be evicted, as evicting them would not release any memory. They are
+/// not compacted either, as compaction releases the indices of the log, that worker threads holding a reference, like a search, a sort
+/// or an export, may be reading. Their compaction is deferred to the next enforcement of the budget after the last reference is released.
+//****************************************************************************************************************************************************
+void enforceBudget() {
+    for (CachedLog &cached: cachedLogs) {
+        cached.byteCount = cached.log->memoryUsage().total();
+    }
+    qint64 byteCount = cachedByteCount();
+    for (CachedLog &cached: cachedLogs) {
+        if (byteCount <= memoryBudget) {
+            return;
+        }
+        if ((cached.log.use_count() == 1) && (!cached.log->isCompact())) {
+            cached.log->compact();
+            qint64 const compactByteCount = cached.log->memoryUsage().total();
+            byteCount -= cached.byteCount - compactByteCount;
+            cached.byteCount = compactByteCount;
+        }
+    }
+    for (qsizetype i = 0; (i < cachedLogs.count()) && (byteCount > memoryBudget);) {
+        if (cachedLogs[i].log.use_count() > 1) {
+            ++i;
+            continue;
+        }
+        byteCount -= cachedLogs[i].byteCount;
+        cachedLogs.removeAt(i);
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] filePaths The ordered list of files forming the log.
+/// \return The index of the log in the cache, or -1 if the log is not in the cache.
+//****************************************************************************************************************************************************
+qsizetype cachedLogIndex(QStringList const &filePaths) {
+    for (qsizetype i = 0; i < cachedLogs.count(); ++i) {
+        if (cachedLogs[i].filePaths == filePaths) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+
+//****************************************************************************************************************************************************
+/// The log is opened on the calling thread if it is not in the cache.
+///
+/// \param[in] filePaths The ordered list of files forming the log.
+/// \return The log.
+//****************************************************************************************************************************************************
+SPLog LogCache::log(QStringList const &filePaths) {
+    SPLog log = LogCache::find(filePaths);
+    if (!log) {
+        log = std::make_shared<Log>(filePaths);
+        LogCache::insert(filePaths, log);
+    }
+    return log;
+}
+
+
+//****************************************************************************************************************************************************
+/// The log becomes the most recently used one. If the log is compact, its indices are rebuilt before it is returned, and the budget is
+/// enforced again, as the log now uses more memory.
+///
+/// \param[in] filePaths The ordered list of files forming the log.
+/// \return The log.
+/// \return A null pointer if the log is not in the cache.
+//****************************************************************************************************************************************************
+SPLog LogCache::find(QStringList const &filePaths) {
+    qsizetype const index = cachedLogIndex(filePaths);
+    if (index < 0) {
+        return {};
+    }
+    cachedLogs.move(index, cachedLogs.count() - 1);
+    SPLog const log = cachedLogs.back().log;
+    if (log->isCompact()) {
+        log->expand();
+        enforceBudget();
+    }
+    return log;
+}
+
+
+//****************************************************************************************************************************************************
+/// If a log is already cached for the files, it is replaced. The budget is enforced after the log is inserted, so other logs can be evicted
+/// to make room for it.
+///
+/// \param[in] filePaths The ordered list of files forming the log.
+/// \param[in] log The log.
+//****************************************************************************************************************************************************
+void LogCache::insert(QStringList const &filePaths, SPLog const &log) {
+    qsizetype const index = cachedLogIndex(filePaths);
+    if (index >= 0) {
+        cachedLogs.removeAt(index);
+    }
+    cachedLogs.append({ filePaths, log, 0 });
+    enforceBudget();
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] filePaths The ordered list of files forming the log.
+/// \return true iff the log is in the cache.
+//****************************************************************************************************************************************************
+bool LogCache::contains(QStringList const &filePaths) {
+    return cachedLogIndex(filePaths) >= 0;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The memory budget, in bytes.
+//****************************************************************************************************************************************************
+qint64 LogCache::budget() {
+    return memoryBudget;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] byteCount The memory budget, in bytes.
+//****************************************************************************************************************************************************
+void LogCache::setBudget(qint64 byteCount) {
+    memoryBudget = qMax(qint64(0), byteCount);
+    enforceBudget();
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The part of the memory budget that is not used by the cached logs, in bytes.
+//****************************************************************************************************************************************************
+qint64 LogCache::availableByteCount() {
+    return qMax(qint64(0), memoryBudget - cachedByteCount());
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The estimated memory usage of the cached logs, with one component per log, named after its first file.
+//****************************************************************************************************************************************************
+MemoryUsage LogCache::memoryUsage() {
+    MemoryUsage result;
+    for (CachedLog const &cached: cachedLogs) {
+        QString const name = cached.filePaths.isEmpty() ? QString() : QFileInfo(cached.filePaths.front()).fileName();
+        result.add(cached.log->isCompact() ? name + " (compact)" : name, cached.log->memoryUsage().total());
+    }
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void LogCache::clear() {
+    cachedLogs.clear();
+}
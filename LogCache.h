@@ -0,0 +1,39 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of log cache class.
+
+
+#ifndef ANALOG_LOG_CACHE_H
+#define ANALOG_LOG_CACHE_H
+
+
+#include "Log.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Log cache class.
+///
+/// The cache keeps the logs that were opened, so switching back to a log does not parse it again. The estimated memory usage of the cached
+/// logs is kept under a global budget: when the budget is exceeded, the least recently used logs that are not referenced outside the cache
+/// are switched to compact mode, and if this is not enough, they are evicted. Compact logs are expanded when they are retrieved from the
+/// cache. The cache must only be used from the GUI thread.
+//****************************************************************************************************************************************************
+class LogCache {
+public: // static members
+    static qint64 constexpr defaultBudget = qint64(2) * 1024 * 1024 * 1024; ///< The default memory budget, in bytes.
+
+public: // static member functions.
+    static SPLog log(QStringList const &filePaths); ///< Return the log for a list of files, opening it if it is not in the cache.
+    static SPLog find(QStringList const &filePaths); ///< Return the log for a list of files if it is in the cache.
+    static void insert(QStringList const &filePaths, SPLog const &log); ///< Insert a log opened elsewhere into the cache.
+    static bool contains(QStringList const &filePaths); ///< Check if the log for a list of files is in the cache.
+    static qint64 budget(); ///< Return the memory budget.
+    static void setBudget(qint64 byteCount); ///< Set the memory budget.
+    static qint64 availableByteCount(); ///< Return the part of the memory budget that is not used by the cached logs.
+    static MemoryUsage memoryUsage(); ///< Return the estimated memory usage of the cached logs, by log.
+    static void clear(); ///< Remove all logs from the cache.
+};
+
+
+#endif //ANALOG_LOG_CACHE_H
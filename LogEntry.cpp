@@ -6,85 +6,189 @@
 
 #include "LogEntry.h"
 #include "Exception.h"
+#include "Instrumentation.h"
+#include "MemoryUsage.h"
 
 
 namespace {
-QChar constexpr doubleQuote('"'); ///< The double quote character.
-QChar constexpr backslash('\\'); ///< The backslash character.
-QChar constexpr equal('='); ///< The equal sign character.
-QChar constexpr space(' '); ///< The space character.
-QString const keyTime = "time"; ///< The field name for time.
-QString const keyLevel = "level"; ///< The field name for level.
-QString const keyPackage = "pkg"; ///< The field name for package.
-QString const keyService = "service"; ///< the field name for service.
-QString const keyMessage = "msg"; ///< The field name for message.
-QString const traceColor("#fffffc"); ///< The color for the trace log level.
-QString const debugColor("#9bf6ff"); ///< The color for the debug log level.
-QString const infoColor("#caffbf"); ///< The color for the info log level.
-QString const warnColor("#fdd6a5"); ///< The color for the warn log level.
-QString const errorColor("#ffadad"); ///< The color for the error log level.
-QString const fatalColor("#a0c4ff"); ///< The color for the fatal log level.
-QString const panicColor("#bdb2ff"); ///< The color for the panic log level.
+char constexpr doubleQuote('"'); ///< The double quote character.
+char constexpr backslash('\\'); ///< The backslash character.
+char constexpr equal('='); ///< The equal sign character.
+char constexpr space(' '); ///< The space character.
+QByteArrayView constexpr keyTime = "time"; ///< The field name for time.
+QByteArrayView constexpr keyLevel = "level"; ///< The field name for level.
+QByteArrayView constexpr keyPackage = "pkg"; ///< The field name for package.
+QByteArrayView constexpr keyService = "service"; ///< the field name for service.
+QByteArrayView constexpr keyMessage = "msg"; ///< The field name for message.
+QByteArrayView constexpr keyMessageUpdated = "message updated"; ///< The field name that logrus writes with a space, see parseBridge34Entry().
+std::array<QByteArrayView, 7> constexpr bridgeGUILevelTags = { "PANI", "FATA", "ERRO", "WARN", "INFO", "DEBU", "TRAC" }; ///< The level tags.
+qsizetype constexpr bridgeGUITimeLength = 19; ///< The number of characters of the time in bridge-gui entries.
 QString const yearStr = QDate::currentDate().toString("yyyy "); // Why is the year not in the log timestamps? We ignore year change for now...
+int const currentYear = QDate::currentDate().year(); ///< The year used for timestamps, see yearStr.
+qint64 constexpr msecsPerDay = 24 * 60 * 60 * 1000; ///< The number of milliseconds in a day.
+QByteArrayView constexpr kelvinSignUtf8 = "\xe2\x84\xaa"; ///< The Kelvin sign (U+212A) in UTF-8. It folds to 'k'.
+QByteArrayView constexpr longSUtf8 = "\xc5\xbf"; ///< The Latin small letter long s (U+017F) in UTF-8. It folds to 's'.
+std::array<char const *, 12> const monthNames = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" }; ///< The month names.
 }
 
 
 //****************************************************************************************************************************************************
-//
+/// \param[in] str The string.
+/// \param[in] pos The position of the first digit.
+/// \param[in] count The number of digits.
+/// \return The value of the digits, or -1 if a non-digit character was found.
+//****************************************************************************************************************************************************
+int parseDigits(QUtf8StringView str, qsizetype pos, qsizetype count) {
+    int result = 0;
+    for (qsizetype i = pos; i < pos + count; ++i) {
+        char const c = char(str[i]);
+        if ((c < '0') || (c > '9')) {
+            return -1;
+        }
+        result = result * 10 + (c - '0');
+    }
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] c A byte.
+/// \return true iff the byte is an ASCII whitespace character.
+//****************************************************************************************************************************************************
+bool isAsciiSpace(char c) {
+    return (c == ' ') || ((c >= '\t') && (c <= '\r'));
+}
+
+
+//****************************************************************************************************************************************************
+/// Non-ASCII whitespace characters, like the no-break space, are decoded, so the result matches QChar::isSpace().
+///
+/// \param[in] str A UTF-8 string.
+/// \param[in] pos The position of a byte in the string.
+/// \return The number of bytes of the whitespace character at the position.
+/// \return 0 if there is no whitespace character at the position.
+//****************************************************************************************************************************************************
+qsizetype whitespaceLength(QByteArrayView str, qsizetype pos) {
+    auto const byte = [&str](qsizetype i) -> uchar { return uchar(str[i]); };
+    uchar const lead = byte(pos);
+    if (lead < 0x80) {
+        return isAsciiSpace(char(lead)) ? 1 : 0;
+    }
+    auto const isContinuation = [&](qsizetype i) -> bool { return (i < str.size()) && ((byte(i) & 0xc0) == 0x80); };
+    // All non-ASCII whitespace characters are in the BMP, so 4-byte sequences are not decoded.
+    if (((lead & 0xe0) == 0xc0) && isContinuation(pos + 1)) {
+        return QChar::isSpace(char32_t(((lead & 0x1f) << 6) | (byte(pos + 1) & 0x3f))) ? 2 : 0;
+    }
+    if (((lead & 0xf0) == 0xe0) && isContinuation(pos + 1) && isContinuation(pos + 2)) {
+        return QChar::isSpace(char32_t(((lead & 0x0f) << 12) | ((byte(pos + 1) & 0x3f) << 6) | (byte(pos + 2) & 0x3f))) ? 3 : 0;
+    }
+    return 0;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] token A token.
+/// \return true iff the token is an equal sign.
+//****************************************************************************************************************************************************
+bool isEqualSign(QByteArrayView token) {
+    return (token.size() == 1) && (token.front() == equal);
+}
+
+
 //****************************************************************************************************************************************************
-QStringList tokenizeBridge34Entry(QString const &str) {
-    QStringList result;
+/// The tokens are views on the string, except for empty values, that are null views.
+///
+/// \param[in] str The UTF-8 string.
+/// \return The tokens.
+//****************************************************************************************************************************************************
+QList<QByteArrayView> tokenizeBridge34Entry(QByteArrayView str) {
+    QList<QByteArrayView> result;
     if (str.isEmpty()) {
         return result;
     }
-    QChar prevChar(0);
+    char prevChar = 0;
     bool inQuotes = false;
-    QString acc;
-    for (QChar c: str) {
+    qsizetype accStart = -1; // The characters of a token are always contiguous, so the accumulator is the range [accStart, i).
+    qsizetype i = 0;
+    auto const flush = [&]() {
+        if (accStart >= 0) {
+            result.append(str.sliced(accStart, i - accStart));
+            accStart = -1;
+        }
+    };
+    while (i < str.size()) {
+        char const c = str[i];
         if ((c == doubleQuote) && (prevChar != backslash)) {
-            if (!acc.isEmpty()) {
-                result.append(acc);
-                acc = QString();
-            }
+            flush();
             inQuotes = !inQuotes;
             prevChar = c;
+            ++i;
             continue;
         }
 
-        if ((c == space) && (!inQuotes) && (acc.isEmpty()) && (!result.isEmpty()) && (result.back() == equal)) {
-            result.push_back(QString());
+        if ((c == space) && (!inQuotes) && (accStart < 0) && (!result.isEmpty()) && isEqualSign(result.back())) {
+            result.push_back(QByteArrayView());
             prevChar = c;
+            ++i;
             continue;
         }
 
         if ((c == equal) && (!inQuotes)) {
-            if (!acc.isEmpty()) {
-                result.push_back(acc);
-                acc = QString();
-            }
-            result.push_back(c);
+            flush();
+            result.push_back(str.sliced(i, 1));
             prevChar = c;
+            ++i;
             continue;
         }
 
-        if (c.isSpace() && !inQuotes) {
-            if (!acc.isEmpty()) {
-                result.append(acc);
-                acc = QString();
-            }
-            prevChar = c;
+        qsizetype const spaceLength = inQuotes ? 0 : whitespaceLength(str, i);
+        if (spaceLength > 0) {
+            flush();
+            i += spaceLength;
+            prevChar = str[i - 1];
             continue;
         }
 
-        acc.append(c);
+        if (accStart < 0) {
+            accStart = i;
+        }
         prevChar = c;
+        ++i;
     }
+    flush();
 
-    if (!acc.isEmpty()) {
-        result.append(acc);
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] text The text.
+//****************************************************************************************************************************************************
+LogEntry::TextQuery::TextQuery(QString const &text)
+    : text(text),
+      isAscii(std::ranges::all_of(text, [](QChar c) -> bool { return c.unicode() < 0x80; })) {
+    if (isAscii) {
+        latin1 = text.toLatin1();
+        hasFoldedLetters = std::ranges::any_of(latin1, [](char c) -> bool { return (c == 'k') || (c == 'K') || (c == 's') || (c == 'S'); });
     }
+}
 
-    return result;
+
+//****************************************************************************************************************************************************
+/// End-of-line characters are removed from the line.
+///
+/// \param[in] line The UTF-8 line.
+/// \param[in] format The log file format.
+//****************************************************************************************************************************************************
+LogEntry::LogEntry(QByteArray line, Format format)
+    : line_(std::move(line)) {
+    while (line_.endsWith('\n') || line_.endsWith('\r')) {
+        line_.chop(1);
+    }
+    this->parse(format);
+    if (line_.capacity() > line_.size()) {
+        line_.squeeze(); // QIODevice::readLine() over-allocates.
+    }
 }
 
 
@@ -92,8 +196,8 @@ QStringList tokenizeBridge34Entry(QString const &str) {
 /// \param[in] str The log entry string.
 /// \param[in] format The log file format.
 //****************************************************************************************************************************************************
-LogEntry::LogEntry(QString const &str, Format format) {
-    this->parse(str, format);
+LogEntry::LogEntry(QString const &str, Format format)
+    : LogEntry(str.toUtf8(), format) {
 }
 
 
@@ -109,9 +213,27 @@ bool LogEntry::isValid() const {
 /// \return The entry time.
 //****************************************************************************************************************************************************
 QString LogEntry::time() const {
-    return time_;
+    return this->timeUtf8().toString();
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The entry time, in UTF-8.
+//****************************************************************************************************************************************************
+QUtf8StringView LogEntry::timeUtf8() const {
+    return this->utf8(time_);
 }
 
+
+//****************************************************************************************************************************************************
+/// \return The entry timestamp.
+/// \return LogEntry::invalidTimestamp if the entry time could not be parsed.
+//****************************************************************************************************************************************************
+qint64 LogEntry::timestamp() const {
+    return parseTimestamp(this->timeUtf8());
+}
+
+
 //****************************************************************************************************************************************************
 /// \return The entry level.
 //****************************************************************************************************************************************************
@@ -124,7 +246,15 @@ LogEntry::Level LogEntry::level() const {
 /// \return The entry package.
 //****************************************************************************************************************************************************
 QString LogEntry::package() const {
-    return package_;
+    return this->packageUtf8().toString();
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The entry package, in UTF-8.
+//****************************************************************************************************************************************************
+QUtf8StringView LogEntry::packageUtf8() const {
+    return this->utf8(package_);
 }
 
 
@@ -132,7 +262,15 @@ QString LogEntry::package() const {
 /// \return The entry message.
 //****************************************************************************************************************************************************
 QString LogEntry::message() const {
-    return message_;
+    return this->messageUtf8().toString();
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The entry message, in UTF-8.
+//****************************************************************************************************************************************************
+QUtf8StringView LogEntry::messageUtf8() const {
+    return this->utf8(message_);
 }
 
 
@@ -145,35 +283,152 @@ QString LogEntry::error() const {
 
 
 //****************************************************************************************************************************************************
-/// \return a constant reference to the entry fields.
+/// The fields are converted to strings on every call. Functions called for every entry should use fieldKeyUtf8() and fieldValueUtf8().
+///
+/// \return The entry fields.
+//****************************************************************************************************************************************************
+QMap<QString, QString> LogEntry::fields() const {
+    QMap<QString, QString> result;
+    for (Field const &field: fields_) {
+        result.insert(this->utf8(field.key).toString(), this->utf8(field.value).toString());
+    }
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The number of fields of the entry.
+//****************************************************************************************************************************************************
+qsizetype LogEntry::fieldCount() const {
+    return fields_.count();
+}
+
+
+//****************************************************************************************************************************************************
+/// Fields are sorted by key.
+///
+/// \param[in] index The index of the field.
+/// \return The key of the field, in UTF-8.
 //****************************************************************************************************************************************************
-QMap<QString, QString> const& LogEntry::fields() const {
-    return fields_;
+QUtf8StringView LogEntry::fieldKeyUtf8(qsizetype index) const {
+    return this->utf8(fields_[index].key);
 }
 
+
+//****************************************************************************************************************************************************
+/// \param[in] index The index of the field.
+/// \return The value of the field, in UTF-8.
+//****************************************************************************************************************************************************
+QUtf8StringView LogEntry::fieldValueUtf8(qsizetype index) const {
+    return this->utf8(fields_[index].value);
+}
+
+
 //****************************************************************************************************************************************************
 /// \return The log entry fieldsString.
 //****************************************************************************************************************************************************
 QString LogEntry::fieldsString() const {
-    QStringList result;
-    for (auto it = fields_.begin(); it != fields_.end(); ++it) {
-        result.append(QString(R"(%1=%2)").arg(it.key(), it.value()));
+    QByteArray result;
+    this->fieldsUtf8(result);
+    return QString::fromUtf8(result);
+}
+
+
+//****************************************************************************************************************************************************
+/// The previous content of the buffer is discarded, but its memory is reused, so a single buffer can be used for many entries without
+/// allocation.
+///
+/// \param[out] buffer The buffer that receives the fields string of the entry, in UTF-8.
+//****************************************************************************************************************************************************
+void LogEntry::fieldsUtf8(QByteArray &buffer) const {
+    buffer.truncate(0);
+    for (qsizetype i = 0; i < fields_.count(); ++i) {
+        if (i > 0) {
+            buffer.append(" - ");
+        }
+        buffer.append(this->bytes(fields_[i].key)).append(equal).append(this->bytes(fields_[i].value));
     }
-    return result.join(" - ");
 }
 
 
 //****************************************************************************************************************************************************
-/// \param[in] str The string.
+/// The search is case-insensitive, and is performed on the message, and on the keys and values of the fields.
+///
+/// ASCII texts are searched directly in the UTF-8 buffer: the bytes of multibyte UTF-8 sequences are never ASCII, and the only non-ASCII
+/// characters that fold to ASCII letters are the Kelvin sign (U+212A) and the long s (U+017F). A Latin-1 case-insensitive search therefore
+/// gives the same result as a search on the decoded strings, except when the text contains 'k' or 's' and the searched string contains one
+/// of these two characters. In that case, and for non-ASCII texts, the message and fields are converted to strings.
+///
+/// \param[in] query The text query.
+/// \return true iff the entry contains the text.
+//****************************************************************************************************************************************************
+bool LogEntry::containsText(TextQuery const &query) const {
+    auto const contains = [&](Span span) -> bool {
+        QByteArrayView const str = this->bytes(span);
+        if (query.isAscii) {
+            if (QLatin1StringView(str.data(), str.size()).contains(QLatin1StringView(query.latin1), Qt::CaseInsensitive)) {
+                return true;
+            }
+            if ((!query.hasFoldedLetters) || !(str.contains(kelvinSignUtf8) || str.contains(longSUtf8))) {
+                return false;
+            }
+        }
+        return QString::fromUtf8(str).contains(query.text, Qt::CaseInsensitive);
+    };
+    if (contains(message_)) {
+        return true;
+    }
+    return std::ranges::any_of(fields_, [&contains](Field const &field) -> bool { return contains(field.key) || contains(field.value); });
+}
+
+
+//****************************************************************************************************************************************************
+/// The size of the entry itself is not included, as it is stored in the list of entries of the log.
+///
+/// \return The estimated size of the heap data of the entry, in bytes.
+//****************************************************************************************************************************************************
+qint64 LogEntry::heapByteCount() const {
+    return MemoryUsage::byteArrayByteCount(line_) + MemoryUsage::listByteCount(fields_) + MemoryUsage::stringByteCount(error_);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] span The location of the text.
+/// \return The text.
+//****************************************************************************************************************************************************
+QUtf8StringView LogEntry::utf8(Span span) const {
+    return { line_.constData() + span.offset, span.size };
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] span The location of the text.
+/// \return The UTF-8 bytes of the text.
+//****************************************************************************************************************************************************
+QByteArrayView LogEntry::bytes(Span span) const {
+    return { line_.constData() + span.offset, span.size };
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] str A view on the line buffer, or a null view.
+/// \return The location of the view in the line buffer.
+//****************************************************************************************************************************************************
+LogEntry::Span LogEntry::spanOf(QByteArrayView str) const {
+    return str.isEmpty() ? Span {} : Span { qint32(str.data() - line_.constData()), qint32(str.size()) };
+}
+
+
+//****************************************************************************************************************************************************
 /// \param[in] format The log format.
 //****************************************************************************************************************************************************
-void LogEntry::parse(QString const &str, Format format) {
+void LogEntry::parse(Format format) {
     switch (format) {
     case Format::BridgeGUI_3_4_0:
-        this->parseBridgeGUI34Entry(str);
+        this->parseBridgeGUI34Entry();
         break;
     case Format::Bridge_3_4_0:
-        this->parseBridge34Entry(str);
+        this->parseBridge34Entry();
         break;
     case Format::Unknown:
         throw Exception("Failed parsing of log entry of unknown format.");
@@ -182,18 +437,34 @@ void LogEntry::parse(QString const &str, Format format) {
 
 
 //****************************************************************************************************************************************************
-/// \param[in] str The string.
+/// The entry is parsed by hand, with the same result as the regular expression
+/// '^(PANI|FATA|ERRO|WARN|INFO|DEBU|TRAC)\[(.{19})]\s+(.*)$'. The time is 19 characters long, not 19 bytes.
 //****************************************************************************************************************************************************
-void LogEntry::parseBridgeGUI34Entry(QString const &str) {
+void LogEntry::parseBridgeGUI34Entry() {
     try {
-        QRegularExpression const rx(R"(^(?<level>PANI|FATA|ERRO|WARN|INFO|DEBU|TRAC)\[(?<time>.{19})]\s+(?<message>.*)$)");
-        QRegularExpressionMatch const match = rx.match(str);
-        if (!match.hasMatch()) {
+        QByteArrayView const str(line_);
+        if ((str.size() < 5) || (str[4] != '[') || (std::ranges::find(bridgeGUILevelTags, str.first(4)) == bridgeGUILevelTags.end())) {
             throw Exception("Invalid log entry");
         }
-        level_ = levelFromBridgeGUI34String(match.captured("level"));
-        time_ = match.captured("time");
-        message_ = match.captured("message");
+        qsizetype pos = 5;
+        for (qsizetype i = 0; i < bridgeGUITimeLength; ++i) {
+            if (pos >= str.size()) {
+                throw Exception("Invalid log entry");
+            }
+            do {
+                ++pos;
+            } while ((pos < str.size()) && ((uchar(str[pos]) & 0xc0) == 0x80));
+        }
+        if ((pos + 1 >= str.size()) || (str[pos] != ']') || (!isAsciiSpace(str[pos + 1]))) {
+            throw Exception("Invalid log entry");
+        }
+        level_ = levelFromBridgeGUI34String(str.first(4));
+        time_ = { 5, qint32(pos - 5) };
+        ++pos;
+        while ((pos < str.size()) && isAsciiSpace(str[pos])) {
+            ++pos;
+        }
+        message_ = { qint32(pos), qint32(str.size() - pos) };
     } catch (Exception const &e) {
         error_ = e.message();
     }
@@ -201,59 +472,78 @@ void LogEntry::parseBridgeGUI34Entry(QString const &str) {
 
 
 //****************************************************************************************************************************************************
-/// \param[in] str The string.
+//
 //****************************************************************************************************************************************************
-void LogEntry::parseBridge34Entry(QString const &str) {
+void LogEntry::parseBridge34Entry() {
+    Instrumentation::LapTimer timer;
     try {
-        QStringList tokens = tokenizeBridge34Entry(str);
+        QList<QByteArrayView> const tokens = tokenizeBridge34Entry(line_);
+        timer.lap(Instrumentation::Stage::Tokenizing);
         qsizetype count = tokens.size();
+        QList<Span> spans;
+        spans.reserve(count);
+        for (QByteArrayView const &token: tokens) {
+            spans.append(this->spanOf(token));
+        }
         if (count % 3 != 0) {
             // fix for issue where a logrus field key contains a space.
-            if ((count % 3 == 1) && (tokens[9] == "message") && (tokens[10] == "updated")) {
-                tokens[9] = "message updated";
-                tokens.removeAt(10);
+            if ((count % 3 == 1) && (count > 10) && (tokens[9] == "message") && (tokens[10] == "updated")) {
+                qint32 const mergedSize = spans[10].offset + spans[10].size - spans[9].offset;
+                if (QByteArrayView(line_).sliced(spans[9].offset, mergedSize) == keyMessageUpdated) {
+                    spans[9].size = mergedSize;
+                } else {
+                    // the key is not written verbatim in the line, so it is appended to the line buffer.
+                    spans[9] = { qint32(line_.size()), qint32(keyMessageUpdated.size()) };
+                    line_.append(keyMessageUpdated);
+                }
+                spans.removeAt(10);
                 --count;
             } else {
                 throw Exception("Invalid number of elements after tokenization.");
             }
         }
         for (int i = 0; i < count; i += 3) {
-            QString const &expectedEqual = tokens[i + 1];
-            if (expectedEqual != equal) {
-                throw Exception(QString("expected equal sign but encountered '%1'")
-                    .arg(expectedEqual.size() < 10 ? expectedEqual : expectedEqual.left(10) + "..."));
+            QByteArrayView const expectedEqual = this->bytes(spans[i + 1]);
+            if (!isEqualSign(expectedEqual)) {
+                QString const str = QString::fromUtf8(expectedEqual);
+                throw Exception(QString("expected equal sign but encountered '%1'").arg(str.size() < 10 ? str : str.left(10) + "..."));
             }
-            QString const &key = tokens[i];
-            QString const &value = tokens[i + 2];
-            if (fields_.contains(key)) {
-                throw Exception(QString("Duplicate field \"%1\"").arg(key));
+            Span const key = spans[i];
+            Span const value = spans[i + 2];
+            QByteArrayView const keyStr = this->bytes(key);
+            if (std::ranges::any_of(fields_, [&](Field const &field) -> bool { return this->bytes(field.key) == keyStr; })) {
+                throw Exception(QString("Duplicate field \"%1\"").arg(QString::fromUtf8(keyStr)));
             }
-            if (key == keyTime) {
+            if (keyStr == keyTime) {
                 time_ = value;
                 continue;
             }
-            if (key == keyLevel) {
-                level_ = LogEntry::levelFromBridge34String(value);
+            if (keyStr == keyLevel) {
+                level_ = LogEntry::levelFromBridge34String(this->bytes(value));
                 continue;
             }
 
-            if ((key == keyPackage) || (key == keyService)) {
+            if ((keyStr == keyPackage) || (keyStr == keyService)) {
                 package_ = value;
                 continue;
             }
 
-            if (key == keyMessage) {
+            if (keyStr == keyMessage) {
                 message_ = value;
                 continue;
             }
 
-            fields_[key] = value;
+            fields_.append({ key, value });
         }
+        std::ranges::sort(fields_, [this](Field const &lhs, Field const &rhs) -> bool {
+            return this->bytes(lhs.key) < this->bytes(rhs.key);
+        });
     } catch (Exception const &e) {
         QString const msg = e.message();
         error_ = msg.isEmpty() ? "Unknown error" : msg;
         fields_.clear();
     }
+    timer.lap(Instrumentation::Stage::FieldMap);
 }
 
 
@@ -261,22 +551,23 @@ void LogEntry::parseBridge34Entry(QString const &str) {
 /// \param[in] str The string.
 /// \return The level parsed from the string
 //****************************************************************************************************************************************************
-LogEntry::Level LogEntry::levelFromBridge34String(QString const &str) {
-    if (str.compare("trace", Qt::CaseInsensitive) == 0)
+LogEntry::Level LogEntry::levelFromBridge34String(QByteArrayView str) {
+    QLatin1StringView const latin1(str.data(), str.size());
+    if (latin1.compare(QLatin1StringView("trace"), Qt::CaseInsensitive) == 0)
         return Level::Trace;
-    if (str.compare("debug", Qt::CaseInsensitive) == 0)
+    if (latin1.compare(QLatin1StringView("debug"), Qt::CaseInsensitive) == 0)
         return Level::Debug;
-    if (str.compare("info", Qt::CaseInsensitive) == 0)
+    if (latin1.compare(QLatin1StringView("info"), Qt::CaseInsensitive) == 0)
         return Level::Info;
-    if (str.compare("warning", Qt::CaseInsensitive) == 0)
+    if (latin1.compare(QLatin1StringView("warning"), Qt::CaseInsensitive) == 0)
         return Level::Warn;
-    if (str.compare("error", Qt::CaseInsensitive) == 0)
+    if (latin1.compare(QLatin1StringView("error"), Qt::CaseInsensitive) == 0)
         return Level::Error;
-    if (str.compare("fatal", Qt::CaseInsensitive) == 0)
+    if (latin1.compare(QLatin1StringView("fatal"), Qt::CaseInsensitive) == 0)
         return Level::Fatal;
-    if (str.compare("panic", Qt::CaseInsensitive) == 0)
+    if (latin1.compare(QLatin1StringView("panic"), Qt::CaseInsensitive) == 0)
         return Level::Panic;
-    qCritical() << QString("Unknown log level '%1'").arg(str);
+    qCritical() << QString("Unknown log level '%1'").arg(QString::fromUtf8(str));
     return Level::Trace;
 }
 
@@ -284,23 +575,24 @@ LogEntry::Level LogEntry::levelFromBridge34String(QString const &str) {
 //****************************************************************************************************************************************************
 /// \param[in] str The string.
 /// \return The level parsed from the string
-//****************************************************************************************************************************************************LogEntry::Level LogEntry::levelFromBridge34String(QString const &str) {
-LogEntry::Level LogEntry::levelFromBridgeGUI34String(QString const &str) {
-    if (str.compare("TRAC", Qt::CaseInsensitive) == 0)
+//****************************************************************************************************************************************************
+LogEntry::Level LogEntry::levelFromBridgeGUI34String(QByteArrayView str) {
+    QLatin1StringView const latin1(str.data(), str.size());
+    if (latin1.compare(QLatin1StringView("TRAC"), Qt::CaseInsensitive) == 0)
         return Level::Trace;
-    if (str.compare("DEBU", Qt::CaseInsensitive) == 0)
+    if (latin1.compare(QLatin1StringView("DEBU"), Qt::CaseInsensitive) == 0)
         return Level::Debug;
-    if (str.compare("INFO", Qt::CaseInsensitive) == 0)
+    if (latin1.compare(QLatin1StringView("INFO"), Qt::CaseInsensitive) == 0)
         return Level::Info;
-    if (str.compare("WARN", Qt::CaseInsensitive) == 0)
+    if (latin1.compare(QLatin1StringView("WARN"), Qt::CaseInsensitive) == 0)
         return Level::Warn;
-    if (str.compare("ERRO", Qt::CaseInsensitive) == 0)
+    if (latin1.compare(QLatin1StringView("ERRO"), Qt::CaseInsensitive) == 0)
         return Level::Error;
-    if (str.compare("FATA", Qt::CaseInsensitive) == 0)
+    if (latin1.compare(QLatin1StringView("FATA"), Qt::CaseInsensitive) == 0)
         return Level::Fatal;
-    if (str.compare("PANI", Qt::CaseInsensitive) == 0)
+    if (latin1.compare(QLatin1StringView("PANI"), Qt::CaseInsensitive) == 0)
         return Level::Panic;
-    qCritical() << QString("Unknown log level '%1'").arg(str);
+    qCritical() << QString("Unknown log level '%1'").arg(QString::fromUtf8(str));
     return Level::Trace;
 }
 
@@ -333,35 +625,92 @@ QString LogEntry::levelToString(LogEntry::Level level) {
 
 
 //****************************************************************************************************************************************************
-/// \param[in] level The level.
-/// \return The color associated with a level.
+/// \return The date/time for the entry.
 //****************************************************************************************************************************************************
-QColor LogEntry::levelColor(LogEntry::Level level) {
-    switch (level) {
-    case Level::Trace:
-        return traceColor;
-    case Level::Debug:
-        return debugColor;
-    case Level::Info:
-        return infoColor;
-    case Level::Warn:
-        return warnColor;
-    case Level::Error:
-        return errorColor;
-    case Level::Fatal:
-        return fatalColor;
-    case Level::Panic:
-        return panicColor;
-    default:
-        qCritical() << QString("Unknown log level '%1'").arg(static_cast<qint64>(level));
-        return traceColor;
+QDateTime LogEntry::dateTime() const {
+    return QDateTime::fromString(yearStr + this->time(), "yyyy MMM dd HH:mm:ss.zzz");
+}
+
+
+//****************************************************************************************************************************************************
+/// Timestamps are the number of milliseconds since the start of the Julian day 0, in local time. Contrary to dateTime(), parsing does not rely on
+/// QDateTime::fromString(), and is cheap enough to be performed for every entry of a log.
+///
+/// \param[in] str The time string, in the 'MMM dd HH:mm:ss.zzz' format.
+/// \return The timestamp.
+/// \return LogEntry::invalidTimestamp if the string could not be parsed.
+//****************************************************************************************************************************************************
+qint64 LogEntry::parseTimestamp(QUtf8StringView str) {
+    if ((str.size() != 19) || (str[3] != space) || (str[6] != space) || (str[9] != ':') || (str[12] != ':') || (str[15] != '.')) {
+        return invalidTimestamp;
     }
+
+    QLatin1StringView const monthStr(str.data(), 3);
+    qsizetype const monthIndex = std::ranges::find_if(monthNames, [&monthStr](char const *name) -> bool {
+        return monthStr.compare(QLatin1StringView(name), Qt::CaseInsensitive) == 0;
+    }) - monthNames.begin();
+    if (monthIndex >= qsizetype(monthNames.size())) {
+        return invalidTimestamp;
+    }
+
+    int const day = (str[4] == space) ? parseDigits(str, 5, 1) : parseDigits(str, 4, 2);
+    int const hours = parseDigits(str, 7, 2);
+    int const minutes = parseDigits(str, 10, 2);
+    int const seconds = parseDigits(str, 13, 2);
+    int const msecs = parseDigits(str, 16, 3);
+    if ((day < 0) || (hours < 0) || (minutes < 0) || (seconds < 0) || (msecs < 0)) {
+        return invalidTimestamp;
+    }
+
+    QDate const date(currentYear, int(monthIndex) + 1, day);
+    if (!date.isValid()) {
+        return invalidTimestamp;
+    }
+
+    return date.toJulianDay() * msecsPerDay + ((hours * 60 + minutes) * 60 + seconds) * 1000 + msecs;
 }
 
 
 //****************************************************************************************************************************************************
-/// \return The date/time for the entry.
+/// The function does not rely on QDateTime::toString(), and is cheap enough to be called for every entry displayed.
+///
+/// \param[in] timestamp The timestamp.
+/// \return The timestamp as a string, in the 'yyyy-MM-dd HH:mm:ss.zzz' format.
+/// \return An empty string if the timestamp is invalid.
 //****************************************************************************************************************************************************
-QDateTime LogEntry::dateTime() const {
-    return QDateTime::fromString(yearStr + time_, "yyyy MMM dd HH:mm:ss.zzz");
+QString LogEntry::timestampToString(qint64 timestamp) {
+    if (timestamp < 0) {
+        return {};
+    }
+    int year = 0, month = 0, day = 0;
+    QDate::fromJulianDay(timestamp / msecsPerDay).getDate(&year, &month, &day);
+    int const msecs = int(timestamp % msecsPerDay);
+    return QString::asprintf("%04d-%02d-%02d %02d:%02d:%02d.%03d", year, month, day, msecs / 3600000, (msecs / 60000) % 60, (msecs / 1000) % 60,
+        msecs % 1000);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] dateTime The date/time.
+/// \return The timestamp for the date time.
+/// \return LogEntry::invalidTimestamp if the date/time is invalid.
+//****************************************************************************************************************************************************
+qint64 LogEntry::dateTimeToTimestamp(QDateTime const &dateTime) {
+    if (!dateTime.isValid()) {
+        return invalidTimestamp;
+    }
+    return dateTime.date().toJulianDay() * msecsPerDay + dateTime.time().msecsSinceStartOfDay();
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] timestamp The timestamp.
+/// \return The date/time for the timestamp.
+/// \return An invalid date/time if the timestamp is invalid.
+//****************************************************************************************************************************************************
+QDateTime LogEntry::timestampToDateTime(qint64 timestamp) {
+    if (timestamp < 0) {
+        return {};
+    }
+    return QDateTime(QDate::fromJulianDay(timestamp / msecsPerDay), QTime::fromMSecsSinceStartOfDay(int(timestamp % msecsPerDay)));
 }
@@ -10,6 +10,9 @@
 
 //****************************************************************************************************************************************************
 /// \brief Log entry class.
+///
+/// The entry keeps its line in UTF-8, and its time, package, message and fields are locations in this buffer. They are only converted to
+/// strings when requested, e.g. when a cell is displayed.
 //****************************************************************************************************************************************************
 class LogEntry {
 public: // data types
@@ -23,6 +26,8 @@ public: // data types
         Panic = 6,
     }; ///< Log levels
 
+    static qsizetype constexpr levelCount = 7; ///< The number of log levels.
+
     enum class Format {
         BridgeGUI_3_4_0,
         ///< bridge-gui version 3.4.0 and above.
@@ -31,7 +36,16 @@ public: // data types
         Unknown ///< Unknown format
     }; ///< Enumeration for log file formats.
 
+    struct TextQuery {
+        explicit TextQuery(QString const &text = QString()); ///< Constructor for a query searching the given text.
+        QString text; ///< The text.
+        QByteArray latin1; ///< The text in Latin-1, if it only contains ASCII characters.
+        bool isAscii { true }; ///< Does the text only contain ASCII characters?
+        bool hasFoldedLetters { false }; ///< Does the text contain a letter that a non-ASCII character folds to, i.e. 'k' or 's'?
+    }; ///< Structure for texts searched in entries, prepared once for all entries.
+
 public: // member functions.
+    explicit LogEntry(QByteArray line, Format format); ///< Constructor for a log entry from a UTF-8 line.
     explicit LogEntry(QString const &str, Format format); ///< Default constructor for log entry from string
     LogEntry(LogEntry const &) = default; ///< Disabled copy-constructor.
     LogEntry(LogEntry &&) = default; ///< Disabled assignment copy-constructor.
@@ -41,33 +55,65 @@ public: // member functions.
 
     bool isValid() const; ///< Return true iff the log entry is valid.
     QString time() const; ///< Return the entry time.
+    QUtf8StringView timeUtf8() const; ///< Return the entry time, in UTF-8.
     QDateTime dateTime() const; ///< Return the date/time of the entry.
+    qint64 timestamp() const; ///< Return the entry timestamp as an integer.
     Level level() const; ///< Return the entry level.
     QString package() const; ///< Return the entry package.
+    QUtf8StringView packageUtf8() const; ///< Return the entry package, in UTF-8.
     QString message() const; ///< Return the entry message.
-    QMap<QString, QString> const& fields() const; ///< Returns a reference to the entry fields.
+    QUtf8StringView messageUtf8() const; ///< Return the entry message, in UTF-8.
+    QMap<QString, QString> fields() const; ///< Return the entry fields.
+    qsizetype fieldCount() const; ///< Return the number of fields of the entry.
+    QUtf8StringView fieldKeyUtf8(qsizetype index) const; ///< Return the key of a field, in UTF-8.
+    QUtf8StringView fieldValueUtf8(qsizetype index) const; ///< Return the value of a field, in UTF-8.
     QString fieldsString() const; ///< Return the log entry as a string.
+    void fieldsUtf8(QByteArray &buffer) const; ///< Write the fields string of the entry to a buffer, in UTF-8.
     QString error() const; ///< Return the description of the problem encountered while parsing the entry.
+    bool containsText(TextQuery const &query) const; ///< Check if the message or a field of the entry contains a text.
+    qint64 heapByteCount() const; ///< Return the estimated heap size of the entry.
 
 public: // static members
-    static Level levelFromBridge34String(QString const &str); ///< convert a string from a bridge 3.4 log to a log level.
-    static Level levelFromBridgeGUI34String(QString const &str); ///< convert a string from a bridge-gui 3.4 log to a log level.
+    static qint64 constexpr invalidTimestamp = -1; ///< The value for invalid timestamps.
+    static qint64 parseTimestamp(QUtf8StringView str); ///< Parse a log time string into a timestamp.
+    static qint64 dateTimeToTimestamp(QDateTime const &dateTime); ///< Convert a date/time to a timestamp.
+    static QDateTime timestampToDateTime(qint64 timestamp); ///< Convert a timestamp to a date/time.
+    static QString timestampToString(qint64 timestamp); ///< Convert a timestamp to a string.
+    static Level levelFromBridge34String(QByteArrayView str); ///< convert a string from a bridge 3.4 log to a log level.
+    static Level levelFromBridgeGUI34String(QByteArrayView str); ///< convert a string from a bridge-gui 3.4 log to a log level.
     static QString levelToString(Level level); ///< Return the string for a level.
-    static QColor levelColor(Level level); ///< Return the color for a level.
+
+private: // data types
+    struct Span {
+        qint32 offset { 0 }; ///< The offset of the text in the line buffer, in bytes.
+        qint32 size { 0 }; ///< The size of the text, in bytes.
+    }; ///< Structure for the location of a text in the line buffer.
+
+    struct Field {
+        Span key; ///< The key of the field.
+        Span value; ///< The value of the field.
+    }; ///< Structure for entry fields.
 
 private: // member functions
-    void parse(QString const &str, Format format); ///< Parse the log entry from a string.
-    void parseBridgeGUI34Entry(QString const &str); ///< Parse a log entry in bridge-gui 3.4 format.
-    void parseBridge34Entry(QString const &str); ///< Parse a log entry in bridge 3.4 format.
+    void parse(Format format); ///< Parse the log entry from the line buffer.
+    void parseBridgeGUI34Entry(); ///< Parse a log entry in bridge-gui 3.4 format.
+    void parseBridge34Entry(); ///< Parse a log entry in bridge 3.4 format.
+    QUtf8StringView utf8(Span span) const; ///< Return the text at a location of the line buffer.
+    QByteArrayView bytes(Span span) const; ///< Return the UTF-8 bytes at a location of the line buffer.
+    Span spanOf(QByteArrayView str) const; ///< Return the location of a view on the line buffer.
 
 private: // member functions
-    QString time_; ///< The entry date/time.
+    QByteArray line_; ///< The line buffer, i.e. the UTF-8 line, possibly followed by texts that do not appear verbatim in the line.
+    Span time_; ///< The entry date/time.
     Level level_ { Level::Trace }; ///< The entry level.
-    QString package_; ///< The entry package.
-    QString message_; ///< The entry message.
-    QMap<QString, QString> fields_; ///< The other entry fieldsString.
+    Span package_; ///< The entry package.
+    Span message_; ///< The entry message.
+    QList<Field> fields_; ///< The other entry fields, sorted by key.
     QString error_; ///< The error that make the line invalid.
 };
 
 
+QList<QByteArrayView> tokenizeBridge34Entry(QByteArrayView str); ///< Split a UTF-8 bridge 3.4 log entry into keys, equal signs and values.
+
+
 #endif //ANALOG_LOG_ENTRY_H
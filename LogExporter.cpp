@@ -0,0 +1,394 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of log exporter class.
+
+
+#include "LogExporter.h"
+#include "BufferedWriter.h"
+#include "Exception.h"
+
+
+namespace {
+qsizetype constexpr progressInterval = 65536; ///< The number of rows exported between two progress notifications.
+QByteArrayView const csvHeader = "time,level,package,message,fields\n"; ///< The header line of CSV files.
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] str The UTF-8 string.
+/// \return The bytes of the string.
+//****************************************************************************************************************************************************
+QByteArrayView utf8Bytes(QUtf8StringView str) {
+    return QByteArrayView(str.data(), str.size());
+}
+
+
+//****************************************************************************************************************************************************
+/// Bytes for which the escape function returns a replacement are replaced, runs of other bytes are written unchanged. All escaped characters
+/// are ASCII, and the bytes of multibyte UTF-8 sequences are never ASCII, so the string is escaped without being decoded.
+///
+/// \param[in] writer The writer.
+/// \param[in] str The UTF-8 string.
+/// \param[in] escape The escape function. It receives the string and the index of a byte, and returns the replacement for the byte, or a
+/// null pointer if the byte must not be replaced.
+//****************************************************************************************************************************************************
+template <typename Escape>
+void appendEscaped(BufferedWriter &writer, QByteArrayView str, Escape const &escape) {
+    qsizetype runStart = 0;
+    for (qsizetype i = 0; i < str.size(); ++i) {
+        char const *replacement = escape(str, i);
+        if (!replacement) {
+            continue;
+        }
+        if (i > runStart) {
+            writer.append(str.sliced(runStart, i - runStart));
+        }
+        writer.append(QByteArrayView(replacement));
+        runStart = i + 1;
+    }
+    if (runStart < str.size()) {
+        writer.append(str.sliced(runStart));
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] str The UTF-8 string.
+/// \param[in] i The index of the byte.
+/// \return The CSV replacement for the byte, or a null pointer if the byte does not need escaping in a quoted field.
+//****************************************************************************************************************************************************
+char const *csvEscape(QByteArrayView str, qsizetype i) {
+    return (str[i] == '"') ? "\"\"" : nullptr;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] str The UTF-8 string.
+/// \param[in] i The index of the byte.
+/// \return The JSON replacement for the byte, or a null pointer if the byte does not need escaping in a JSON string.
+//****************************************************************************************************************************************************
+char const *jsonEscape(QByteArrayView str, qsizetype i) {
+    static std::array<std::array<char, 7>, 32> const controlEscapes = []() {
+        std::array<std::array<char, 7>, 32> result {};
+        for (int c = 0; c < 32; ++c) {
+            qsnprintf(result[c].data(), result[c].size(), "\\u%04x", c);
+        }
+        return result;
+    }();
+
+    auto const c = static_cast<unsigned char>(str[i]);
+    switch (c) {
+    case '"':
+        return "\\\"";
+    case '\\':
+        return "\\\\";
+    case '\n':
+        return "\\n";
+    case '\r':
+        return "\\r";
+    case '\t':
+        return "\\t";
+    default:
+        return (c < 32) ? controlEscapes[c].data() : nullptr;
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] str The UTF-8 string.
+/// \param[in] i The index of the byte.
+/// \return The logfmt replacement for the byte, or a null pointer if the byte does not need escaping in a quoted value.
+//****************************************************************************************************************************************************
+char const *logfmtEscape(QByteArrayView str, qsizetype i) {
+    switch (str[i]) {
+    case '"':
+        return "\\\"";
+    case '\\':
+        return "\\\\";
+    case '\n':
+        return "\\n";
+    default:
+        return nullptr;
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// Values read from Bridge logs keep the escaping of the original file, so backslashes and quotes that are already escaped are left
+/// untouched.
+///
+/// \param[in] str The UTF-8 string, in escaped form.
+/// \param[in] i The index of the byte.
+/// \return The logfmt replacement for the byte, or a null pointer if the byte does not need escaping in a quoted value.
+//****************************************************************************************************************************************************
+char const *escapedLogfmtEscape(QByteArrayView str, qsizetype i) {
+    switch (str[i]) {
+    case '"':
+        return ((i > 0) && (str[i - 1] == '\\')) ? nullptr : "\\\"";
+    case '\n':
+        return "\\n";
+    default:
+        return nullptr;
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] writer The writer.
+/// \param[in] value The UTF-8 value.
+/// \param[in] isEscaped Is the value in the escaped form of Bridge logs?
+//****************************************************************************************************************************************************
+void appendLogfmtValue(BufferedWriter &writer, QByteArrayView value, bool isEscaped) {
+    bool const needsQuotes = value.isEmpty() || std::ranges::any_of(value, [](char c) -> bool {
+        return (c == ' ') || (c == '=') || (c == '"') || (c == '\\') || (c == '\n');
+    });
+    if (!needsQuotes) {
+        writer.append(value);
+        return;
+    }
+    writer.append('"');
+    if (isEscaped) {
+        appendEscaped(writer, value, escapedLogfmtEscape);
+    } else {
+        appendEscaped(writer, value, logfmtEscape);
+    }
+    writer.append('"');
+}
+
+
+//****************************************************************************************************************************************************
+/// The export is cancelled as soon as possible when the cancellation flag is set. In that case, the partially written file is removed.
+///
+/// \param[in] log The log.
+/// \param[in] rows The rows to export, in export order. If not set, all the entries of the log are exported.
+/// \param[in] filePath The path of the destination file.
+/// \param[in] format The export format.
+/// \param[in] progress The progress callback, called regularly with the number of rows exported so far.
+/// \param[in] cancelled The cancellation flag.
+/// \return The number of bytes written, or -1 if the export was cancelled.
+/// \throw Exception if the file cannot be written. The partially written file is removed.
+//****************************************************************************************************************************************************
+qint64 LogExporter::exportRows(Log const &log, std::optional<QList<qint32>> const &rows, QString const &filePath, Format format,
+    ProgressCallback const &progress, std::atomic_bool const &cancelled) {
+    QList<LogEntry> const &entries = log.entries();
+    qsizetype const count = rows ? rows->count() : entries.count();
+    bool const isEscaped = log.format() == LogEntry::Format::Bridge_3_4_0;
+    BufferedWriter writer(filePath);
+    try {
+        if (format == Format::CSV) {
+            writer.append(csvHeader);
+        }
+
+        for (qsizetype i = 0; i < count; ++i) {
+            if ((i % progressInterval == 0) && (i > 0)) {
+                if (cancelled) {
+                    writer.discard();
+                    QFile::remove(filePath);
+                    return -1;
+                }
+                if (progress) {
+                    progress(i);
+                }
+            }
+            LogEntry const &entry = entries[rows ? (*rows)[i] : i];
+            switch (format) {
+            case Format::CSV:
+                writeCSVEntry(writer, entry);
+                break;
+            case Format::JSONLines:
+                writeJSONEntry(writer, entry);
+                break;
+            case Format::Logfmt:
+                writeLogfmtEntry(writer, entry, isEscaped);
+                break;
+            }
+        }
+        writer.close();
+    } catch (Exception const &) {
+        writer.discard();
+        QFile::remove(filePath);
+        throw;
+    }
+    if (progress) {
+        progress(count);
+    }
+    return writer.bytesWritten();
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+LogExporter::~LogExporter() {
+    this->cancel();
+}
+
+
+//****************************************************************************************************************************************************
+/// Any export in progress is cancelled.
+///
+/// \param[in] log The log.
+/// \param[in] rows The rows to export, in export order. If not set, all the entries of the log are exported.
+/// \param[in] filePath The path of the destination file.
+/// \param[in] format The export format.
+//****************************************************************************************************************************************************
+void LogExporter::start(SPLog const &log, std::optional<QList<qint32>> rows, QString const &filePath, Format format) {
+    this->cancel();
+    if (!log) {
+        emit finished(false, 0, "There is no log to export.");
+        return;
+    }
+
+    running_ = true;
+    quint64 const generation = generation_;
+    qsizetype const rowCount = rows ? rows->count() : log->entries().count();
+    cancelled_ = std::make_shared<std::atomic_bool>(false);
+    thread_ = std::thread([this, log, rows = std::move(rows), filePath, format, generation, rowCount, cancelled = cancelled_]() {
+        ProgressCallback const progressCallback = [&](qsizetype exportedRowCount) {
+            QMetaObject::invokeMethod(this, [this, generation, exportedRowCount, rowCount]() {
+                if (generation == generation_) {
+                    emit progress(exportedRowCount, rowCount);
+                }
+            }, Qt::QueuedConnection);
+        };
+        bool success = false;
+        qint64 byteCount = 0;
+        QString error;
+        try {
+            byteCount = exportRows(*log, rows, filePath, format, progressCallback, *cancelled);
+            success = byteCount >= 0;
+        } catch (Exception const &e) {
+            error = e.message();
+        }
+        if (*cancelled) {
+            return;
+        }
+        QMetaObject::invokeMethod(this, [this, generation, success, byteCount, error]() {
+            this->onWorkerFinished(generation, success, byteCount, error);
+        }, Qt::QueuedConnection);
+    });
+}
+
+
+//****************************************************************************************************************************************************
+/// The worker thread checks for cancellation regularly, so this function returns quickly. No finished() signal is emitted for a cancelled
+/// export.
+//****************************************************************************************************************************************************
+void LogExporter::cancel() {
+    if (cancelled_) {
+        *cancelled_ = true;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    ++generation_;
+    running_ = false;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return true iff an export is in progress.
+//****************************************************************************************************************************************************
+bool LogExporter::isRunning() const {
+    return running_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] writer The writer.
+/// \param[in] entry The entry.
+//****************************************************************************************************************************************************
+void LogExporter::writeCSVEntry(BufferedWriter &writer, LogEntry const &entry) {
+    writer.append('"');
+    appendEscaped(writer, utf8Bytes(entry.timeUtf8()), csvEscape);
+    writer.append(QByteArrayView("\","));
+    writer.append(LogEntry::levelToString(entry.level()));
+    writer.append(QByteArrayView(",\""));
+    appendEscaped(writer, utf8Bytes(entry.packageUtf8()), csvEscape);
+    writer.append(QByteArrayView("\",\""));
+    appendEscaped(writer, utf8Bytes(entry.messageUtf8()), csvEscape);
+    writer.append(QByteArrayView("\",\""));
+    for (qsizetype i = 0; i < entry.fieldCount(); ++i) {
+        if (i > 0) {
+            writer.append(' ');
+        }
+        appendEscaped(writer, utf8Bytes(entry.fieldKeyUtf8(i)), csvEscape);
+        writer.append('=');
+        appendEscaped(writer, utf8Bytes(entry.fieldValueUtf8(i)), csvEscape);
+    }
+    writer.append(QByteArrayView("\"\n"));
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] writer The writer.
+/// \param[in] entry The entry.
+//****************************************************************************************************************************************************
+void LogExporter::writeJSONEntry(BufferedWriter &writer, LogEntry const &entry) {
+    writer.append(QByteArrayView("{\"time\":\""));
+    appendEscaped(writer, utf8Bytes(entry.timeUtf8()), jsonEscape);
+    writer.append(QByteArrayView("\",\"level\":\""));
+    writer.append(LogEntry::levelToString(entry.level()));
+    writer.append(QByteArrayView("\",\"package\":\""));
+    appendEscaped(writer, utf8Bytes(entry.packageUtf8()), jsonEscape);
+    writer.append(QByteArrayView("\",\"msg\":\""));
+    appendEscaped(writer, utf8Bytes(entry.messageUtf8()), jsonEscape);
+    writer.append(QByteArrayView("\",\"fields\":{"));
+    for (qsizetype i = 0; i < entry.fieldCount(); ++i) {
+        writer.append(QByteArrayView((i == 0) ? "\"" : ",\""));
+        appendEscaped(writer, utf8Bytes(entry.fieldKeyUtf8(i)), jsonEscape);
+        writer.append(QByteArrayView("\":\""));
+        appendEscaped(writer, utf8Bytes(entry.fieldValueUtf8(i)), jsonEscape);
+        writer.append('"');
+    }
+    writer.append(QByteArrayView("}}\n"));
+}
+
+
+//****************************************************************************************************************************************************
+/// Entries are written in the format of Bridge logs, whatever the format of the original log. Values read from Bridge logs are already in
+/// escaped form, other values are escaped.
+///
+/// \param[in] writer The writer.
+/// \param[in] entry The entry.
+/// \param[in] isEscaped Are the values of the entry in the escaped form of Bridge logs?
+//****************************************************************************************************************************************************
+void LogExporter::writeLogfmtEntry(BufferedWriter &writer, LogEntry const &entry, bool isEscaped) {
+    writer.append(QByteArrayView("time=\""));
+    appendEscaped(writer, utf8Bytes(entry.timeUtf8()), isEscaped ? escapedLogfmtEscape : logfmtEscape);
+    writer.append(QByteArrayView("\" level="));
+    writer.append(LogEntry::levelToString(entry.level()));
+    QByteArrayView const package = utf8Bytes(entry.packageUtf8());
+    if (!package.isEmpty()) {
+        writer.append(QByteArrayView(" pkg="));
+        appendLogfmtValue(writer, package, isEscaped);
+    }
+    writer.append(QByteArrayView(" msg="));
+    appendLogfmtValue(writer, utf8Bytes(entry.messageUtf8()), isEscaped);
+    for (qsizetype i = 0; i < entry.fieldCount(); ++i) {
+        writer.append(' ');
+        writer.append(utf8Bytes(entry.fieldKeyUtf8(i)));
+        writer.append('=');
+        appendLogfmtValue(writer, utf8Bytes(entry.fieldValueUtf8(i)), isEscaped);
+    }
+    writer.append('\n');
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] generation The generation of the export.
+/// \param[in] success Did the export succeed.
+/// \param[in] byteCount The number of bytes written.
+/// \param[in] error The error message, if the export failed.
+//****************************************************************************************************************************************************
+void LogExporter::onWorkerFinished(quint64 generation, bool success, qint64 byteCount, QString const &error) {
+    if (generation != generation_) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    running_ = false;
+    emit finished(success, byteCount, error);
+}
@@ -0,0 +1,71 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of log exporter class.
+
+
+#ifndef ANALOG_LOG_EXPORTER_H
+#define ANALOG_LOG_EXPORTER_H
+
+
+#include "Log.h"
+
+
+class BufferedWriter;
+
+
+//****************************************************************************************************************************************************
+/// \brief Log exporter class.
+///
+/// The exporter writes a set of rows of a log to a file on a background thread. Entries are formatted directly from the log entry storage
+/// into a buffered writer. Progress is reported while the export runs.
+//****************************************************************************************************************************************************
+class LogExporter : public QObject {
+    Q_OBJECT
+
+public: // data types
+    enum class Format {
+        CSV = 0,
+        JSONLines = 1,
+        Logfmt = 2,
+    }; ///< Enumeration for export formats.
+
+    typedef std::function<void(qsizetype exportedRowCount)> ProgressCallback; ///< Type definition for progress callback functions.
+
+public: // static member functions.
+    static qint64 exportRows(Log const &log, std::optional<QList<qint32>> const &rows, QString const &filePath, Format format,
+        ProgressCallback const &progress, std::atomic_bool const &cancelled); ///< Export rows of a log to a file.
+
+public: // member functions.
+    LogExporter() = default; ///< Default constructor.
+    LogExporter(LogExporter const &) = delete; ///< Disabled copy-constructor.
+    LogExporter(LogExporter &&) = delete; ///< Disabled assignment copy-constructor.
+    ~LogExporter() override; ///< Destructor.
+    LogExporter& operator=(LogExporter const &) = delete; ///< Disabled assignment operator.
+    LogExporter& operator=(LogExporter &&) = delete; ///< Disabled move assignment operator.
+
+    void start(SPLog const &log, std::optional<QList<qint32>> rows, QString const &filePath, Format format); ///< Start an export.
+    void cancel(); ///< Cancel the current export.
+    bool isRunning() const; ///< Check if an export is in progress.
+
+signals:
+    void progress(qsizetype exportedRowCount, qsizetype rowCount); ///< Signal emitted regularly while an export runs.
+    void finished(bool success, qint64 byteCount, QString const &error); ///< Signal emitted when the export is complete.
+
+private: // static member functions.
+    static void writeCSVEntry(BufferedWriter &writer, LogEntry const &entry); ///< Write an entry in CSV format.
+    static void writeJSONEntry(BufferedWriter &writer, LogEntry const &entry); ///< Write an entry in JSON Lines format.
+    static void writeLogfmtEntry(BufferedWriter &writer, LogEntry const &entry, bool isEscaped); ///< Write an entry in logfmt format.
+
+private: // member functions.
+    void onWorkerFinished(quint64 generation, bool success, qint64 byteCount, QString const &error); ///< Handle the end of the worker thread.
+
+private: // data members.
+    std::thread thread_; ///< The worker thread.
+    std::shared_ptr<std::atomic_bool> cancelled_; ///< The cancellation flag of the current export.
+    quint64 generation_ { 0 }; ///< The generation of the current export, used to discard notifications of cancelled exports.
+    bool running_ { false }; ///< Is an export in progress.
+};
+
+
+#endif //ANALOG_LOG_EXPORTER_H
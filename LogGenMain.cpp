@@ -0,0 +1,179 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of the log generator tool entry-point.
+
+
+#include "Exception.h"
+#include "LogGenerator.h"
+
+
+namespace {
+qint64 constexpr mebibyte = 1024 * 1024; ///< The number of bytes in a mebibyte.
+QString const optSessions = "sessions"; ///< The name of the session count option.
+QString const optBridgeSize = "bridge-size"; ///< The name of the bridge log size option.
+QString const optGUISize = "gui-size"; ///< The name of the bridge-gui log size option.
+QString const optMaxFileSize = "max-file-size"; ///< The name of the maximum file size option.
+QString const optInterval = "interval"; ///< The name of the mean interval option.
+QString const optLevels = "levels"; ///< The name of the level weights option.
+QString const optCardinality = "cardinality"; ///< The name of the field cardinality option.
+QString const optMaxFields = "max-fields"; ///< The name of the maximum field count option.
+QString const optQuoted = "quoted"; ///< The name of the quoted value ratio option.
+QString const optEscaped = "escaped"; ///< The name of the escaped value ratio option.
+QString const optBase64 = "base64"; ///< The name of the base64 value ratio option.
+QString const optBase64Length = "base64-length"; ///< The name of the base64 length option.
+QString const optMessageUpdated = "message-updated"; ///< The name of the 'message updated' ratio option.
+QString const optInvalid = "invalid"; ///< The name of the invalid line ratio option.
+QString const optSeed = "seed"; ///< The name of the seed option.
+QString const optStart = "start"; ///< The name of the start option.
+QString const optAppVersion = "app-version"; ///< The name of the version option.
+QString const optTag = "tag"; ///< The name of the tag option.
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] parser The command-line parser.
+/// \param[in] name The name of the option.
+/// \return The value of the option, as an integer.
+//****************************************************************************************************************************************************
+qint64 intValue(QCommandLineParser const &parser, QString const &name) {
+    bool ok = false;
+    qint64 const result = parser.value(name).toLongLong(&ok);
+    if ((!ok) || (result < 0)) {
+        throw Exception(QString("Invalid value for --%1: '%2'.").arg(name, parser.value(name)));
+    }
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] parser The command-line parser.
+/// \param[in] name The name of the option.
+/// \return The value of the option, as a ratio.
+//****************************************************************************************************************************************************
+double ratioValue(QCommandLineParser const &parser, QString const &name) {
+    bool ok = false;
+    double const result = parser.value(name).toDouble(&ok);
+    if ((!ok) || (result < 0.0) || (result > 1.0)) {
+        throw Exception(QString("Invalid value for --%1: '%2'. A value between 0 and 1 is expected.").arg(name, parser.value(name)));
+    }
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] str The comma-separated list of weights, from trace to panic.
+/// \return The level weights.
+//****************************************************************************************************************************************************
+std::array<double, LogEntry::levelCount> parseLevelWeights(QString const &str) {
+    QStringList const values = str.split(',');
+    if (values.count() != LogEntry::levelCount) {
+        throw Exception(QString("Invalid level weights '%1'. %2 comma-separated values are expected.").arg(str).arg(LogEntry::levelCount));
+    }
+    std::array<double, LogEntry::levelCount> result {};
+    for (qsizetype i = 0; i < LogEntry::levelCount; ++i) {
+        bool ok = false;
+        result[i] = values[i].trimmed().toDouble(&ok);
+        if ((!ok) || (result[i] < 0.0)) {
+            throw Exception(QString("Invalid level weight '%1'.").arg(values[i]));
+        }
+    }
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] argc The number of command-line arguments.
+/// \param[in] argv The list of command-line arguments.
+//****************************************************************************************************************************************************
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("analog-loggen");
+    QCoreApplication::setApplicationVersion(QString("%1").arg(ANALOG_VERSION));
+
+    LogGenerator::Config const defaults;
+    QStringList defaultWeights;
+    for (double const weight: defaults.levelWeights) {
+        defaultWeights.append(QString::number(weight));
+    }
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Generate synthetic Bridge and bridge-gui session logs.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addOptions({
+        { optSessions, "The number of sessions.", "count", QString::number(defaults.sessionCount) },
+        { optBridgeSize, "The size of the bridge log of each session, in MiB.", "MiB", QString::number(defaults.bridgeByteCount / mebibyte) },
+        { optGUISize, "The size of the bridge-gui log of each session, in MiB.", "MiB", QString::number(defaults.guiByteCount / mebibyte) },
+        { optMaxFileSize, "The maximum size of a log file, in MiB. Larger logs are split.", "MiB",
+            QString::number(defaults.maxFileByteCount / mebibyte) },
+        { optInterval, "The mean interval between two entries, in milliseconds.", "ms", QString::number(defaults.meanIntervalMs) },
+        { optLevels, "The relative frequency of each level, from trace to panic.", "weights", defaultWeights.join(',') },
+        { optCardinality, "The number of distinct values of each field.", "count", QString::number(defaults.fieldCardinality) },
+        { optMaxFields, "The maximum number of fields of a bridge entry.", "count", QString::number(defaults.maxFieldCount) },
+        { optQuoted, "The ratio of quoted field values.", "ratio", QString::number(defaults.quotedRatio) },
+        { optEscaped, "The ratio of field values containing escaped quotes.", "ratio", QString::number(defaults.escapedRatio) },
+        { optBase64, "The ratio of long base64 field values.", "ratio", QString::number(defaults.base64Ratio) },
+        { optBase64Length, "The number of random bytes encoded in base64 values.", "count", QString::number(defaults.base64Length) },
+        { optMessageUpdated, "The ratio of bridge entries with a 'message updated' field key.", "ratio",
+            QString::number(defaults.messageUpdatedRatio) },
+        { optInvalid, "The ratio of lines that are not valid log entries.", "ratio", QString::number(defaults.invalidRatio) },
+        { optSeed, "The seed of the random generator.", "seed", QString::number(defaults.seed) },
+        { optStart, "The start of the first session, as 'yyyy-MM-dd HH:mm:ss'. The default is January 1st of this year at 08:00.", "date" },
+        { optAppVersion, "The version in the file names.", "version", defaults.version },
+        { optTag, "The tag in the file names.", "tag", defaults.tag },
+    });
+    parser.addPositionalArgument("folder", "The folder the logs are written to.");
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    try {
+        QStringList const args = parser.positionalArguments();
+        if (args.count() != 1) {
+            parser.showHelp(EXIT_FAILURE);
+        }
+
+        LogGenerator::Config config;
+        config.sessionCount = intValue(parser, optSessions);
+        config.bridgeByteCount = intValue(parser, optBridgeSize) * mebibyte;
+        config.guiByteCount = intValue(parser, optGUISize) * mebibyte;
+        config.maxFileByteCount = qMax(qint64(1), intValue(parser, optMaxFileSize)) * mebibyte;
+        config.meanIntervalMs = intValue(parser, optInterval);
+        config.levelWeights = parseLevelWeights(parser.value(optLevels));
+        config.fieldCardinality = qMax(qint64(1), intValue(parser, optCardinality));
+        config.maxFieldCount = intValue(parser, optMaxFields);
+        config.quotedRatio = ratioValue(parser, optQuoted);
+        config.escapedRatio = ratioValue(parser, optEscaped);
+        config.base64Ratio = ratioValue(parser, optBase64);
+        config.base64Length = intValue(parser, optBase64Length);
+        config.messageUpdatedRatio = ratioValue(parser, optMessageUpdated);
+        config.invalidRatio = ratioValue(parser, optInvalid);
+        config.seed = quint32(intValue(parser, optSeed));
+        config.version = parser.value(optAppVersion);
+        config.tag = parser.value(optTag);
+        if (parser.isSet(optStart)) {
+            config.start = QDateTime::fromString(parser.value(optStart), "yyyy-MM-dd HH:mm:ss");
+            if (!config.start.isValid()) {
+                throw Exception(QString("Invalid start date '%1'.").arg(parser.value(optStart)));
+            }
+        }
+
+        LogGenerator generator(config);
+        QStringList const files = generator.generate(args.front(), [&err](qint64 byteCount) {
+            err << QString("%1 MiB written\n").arg(byteCount / mebibyte);
+            err.flush();
+        });
+        for (QString const &file: files) {
+            out << QDir::toNativeSeparators(file) << '\n';
+        }
+        return EXIT_SUCCESS;
+    } catch (Exception const &e) {
+        err << e.message() << '\n';
+    } catch (std::exception const &e) {
+        err << e.what() << '\n';
+    } catch (...) {
+        err << "A fatal error occurred.\n";
+    }
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,294 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of synthetic log generator class.
+
+
+#include "LogGenerator.h"
+#include "BufferedWriter.h"
+#include "Exception.h"
+
+
+namespace {
+
+
+qint64 constexpr msecsPerDay = 24 * 60 * 60 * 1000; ///< The number of milliseconds in a day.
+qint64 constexpr progressInterval = 64 * 1024 * 1024; ///< The number of bytes written between two progress notifications.
+std::array<char const *, 12> const monthNames = { "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec" }; ///< The month names.
+std::array<char const *, LogEntry::levelCount> const bridgeLevelNames = { "trace", "debug", "info", "warning", "error", "fatal",
+    "panic" }; ///< The level names in the bridge format.
+std::array<char const *, LogEntry::levelCount> const guiLevelNames = { "TRAC", "DEBU", "INFO", "WARN", "ERRO", "FATA",
+    "PANI" }; ///< The level names in the bridge-gui format.
+std::array<char const *, 10> const packages = { "bridge", "imap/service", "smtp", "sync", "gluon/imap", "vault", "user", "events",
+    "frontend/grpc", "updater" }; ///< The packages of bridge entries.
+std::array<char const *, 10> const fieldKeys = { "userID", "session", "attempt", "messageID", "address", "duration", "count", "error",
+    "mailbox", "remote" }; ///< The keys of the fields of bridge entries.
+std::array<char const *, 10> const bridgeMessages = { "Sync progress %1/%2", "Fetching message %1", "Received event %1",
+    "IMAP command completed in %1 ms", "Connection closed", "Failed to fetch event", "Uploading attachment", "Starting sync",
+    "Applying update %1", "Checking for updates" }; ///< The message templates of bridge entries.
+std::array<char const *, 6> const guiMessages = { "Main window shown", "Connecting to gRPC service on 127.0.0.1:%1",
+    "gRPC call failed: Deadline Exceeded", "Received %1 notifications", "Could not load the tray icon theme",
+    "Loading QML component %1" }; ///< The message templates of bridge-gui entries.
+
+
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] line The line.
+/// \param[in] value The value.
+/// \param[in] width The minimum number of digits.
+//****************************************************************************************************************************************************
+void appendNumber(QByteArray &line, qint64 value, int width) {
+    QByteArray const digits = QByteArray::number(value);
+    for (qsizetype i = digits.size(); i < width; ++i) {
+        line.append('0');
+    }
+    line.append(digits);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] line The line.
+/// \param[in] timestamp The timestamp.
+//****************************************************************************************************************************************************
+void appendTime(QByteArray &line, qint64 timestamp) {
+    QDate const date = QDate::fromJulianDay(timestamp / msecsPerDay);
+    qint64 const msecs = timestamp % msecsPerDay;
+    line.append(monthNames[date.month() - 1]);
+    line.append(' ');
+    appendNumber(line, date.day(), 2);
+    line.append(' ');
+    appendNumber(line, msecs / 3600000, 2);
+    line.append(':');
+    appendNumber(line, (msecs / 60000) % 60, 2);
+    line.append(':');
+    appendNumber(line, (msecs / 1000) % 60, 2);
+    line.append('.');
+    appendNumber(line, msecs % 1000, 3);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] tmpl The message template.
+/// \param[in] rng The random generator.
+/// \return The message, with its placeholders replaced by random numbers.
+//****************************************************************************************************************************************************
+QByteArray fillMessage(char const *tmpl, QRandomGenerator &rng) {
+    QByteArray result(tmpl);
+    result.replace("%1", QByteArray::number(rng.bounded(100000)));
+    result.replace("%2", QByteArray::number(100000));
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] config The configuration.
+//****************************************************************************************************************************************************
+LogGenerator::LogGenerator(Config config)
+    : config_(std::move(config)),
+      rng_(config_.seed) {
+    double const total = std::accumulate(config_.levelWeights.begin(), config_.levelWeights.end(), 0.0);
+    if (total <= 0.0) {
+        throw Exception("The level weights must not all be zero.");
+    }
+    double sum = 0.0;
+    for (qsizetype i = 0; i < LogEntry::levelCount; ++i) {
+        sum += qMax(0.0, config_.levelWeights[i]);
+        cumulativeWeights_[i] = sum / total;
+    }
+    if (!config_.start.isValid()) {
+        config_.start = QDateTime(QDate(QDate::currentDate().year(), 1, 1), QTime(8, 0));
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] dirPath The path of the folder. It is created if it does not exist.
+/// \param[in] progress An optional progress callback, called regularly with the number of bytes written so far.
+/// \return The paths of the generated files.
+//****************************************************************************************************************************************************
+QStringList LogGenerator::generate(QString const &dirPath, ProgressCallback const &progress) {
+    QDir const dir(dirPath);
+    if (!dir.mkpath(".")) {
+        throw Exception(QString("The folder '%1' could not be created.").arg(QDir::toNativeSeparators(dirPath)));
+    }
+
+    QStringList result;
+    bytesWritten_ = 0;
+    qint64 sessionStart = LogEntry::dateTimeToTimestamp(config_.start);
+    for (qsizetype session = 0; session < config_.sessionCount; ++session) {
+        QString const sessionID = LogEntry::timestampToDateTime(sessionStart).toString("yyyyMMdd_HHmmsszzz");
+        qint64 launcherEnd = sessionStart;
+        qint64 bridgeEnd = sessionStart;
+        qint64 guiEnd = sessionStart;
+        result += this->writeLog(dir, sessionID, FilenameInfo::Executable::Launcher, config_.maxFileByteCount, config_.launcherLineCount,
+            launcherEnd, progress);
+        result += this->writeLog(dir, sessionID, FilenameInfo::Executable::Bridge, config_.bridgeByteCount, -1, bridgeEnd, progress);
+        result += this->writeLog(dir, sessionID, FilenameInfo::Executable::BridgeGUI, config_.guiByteCount, -1, guiEnd, progress);
+        sessionStart = std::max({ launcherEnd, bridgeEnd, guiEnd }) + sessionGapMs;
+    }
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] dir The folder.
+/// \param[in] sessionID The session ID.
+/// \param[in] executable The executable.
+/// \param[in] maxByteCount The size of the log, in bytes.
+/// \param[in] maxLineCount The maximum number of lines, or -1 for no limit.
+/// \param[in,out] timestamp The timestamp of the first entry. On return, the timestamp of the last entry.
+/// \param[in] progress The progress callback.
+/// \return The paths of the files of the log.
+//****************************************************************************************************************************************************
+QStringList LogGenerator::writeLog(QDir const &dir, QString const &sessionID, FilenameInfo::Executable executable, qint64 maxByteCount,
+    qsizetype maxLineCount, qint64 &timestamp, ProgressCallback const &progress) {
+    QString const exe = (executable == FilenameInfo::Executable::Bridge) ? "bri" :
+        ((executable == FilenameInfo::Executable::BridgeGUI) ? "gui" : "lau");
+    QStringList result;
+    std::unique_ptr<BufferedWriter> writer;
+    qint64 fileByteCount = 0;
+    qint64 logByteCount = 0;
+    QByteArray line;
+    for (qsizetype lineIndex = 0; (maxLineCount < 0) || (lineIndex < maxLineCount); ++lineIndex) {
+        line.clear();
+        if (executable == FilenameInfo::Executable::BridgeGUI) {
+            this->appendGUILine(line, timestamp);
+        } else {
+            this->appendBridgeLine(line, timestamp);
+        }
+        if (logByteCount + line.size() > maxByteCount) {
+            break;
+        }
+        if ((!writer) || (fileByteCount + line.size() > config_.maxFileByteCount)) {
+            if (writer) {
+                writer->close();
+            }
+            QString const filename = QString("%1_%2_%3_v%4_%5.log").arg(sessionID, exe).arg(result.count(), 3, 10, QChar('0'))
+                .arg(config_.version, config_.tag);
+            result.append(dir.absoluteFilePath(filename));
+            writer = std::make_unique<BufferedWriter>(result.back());
+            fileByteCount = 0;
+        }
+        writer->append(QByteArrayView(line));
+        fileByteCount += line.size();
+        logByteCount += line.size();
+        if (progress && ((bytesWritten_ + line.size()) / progressInterval != bytesWritten_ / progressInterval)) {
+            progress(bytesWritten_ + line.size());
+        }
+        bytesWritten_ += line.size();
+        timestamp += this->randomInterval();
+    }
+    if (writer) {
+        writer->close();
+    }
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// Values are drawn from a fixed set of fieldCardinality values per field, so the number of distinct field values can be controlled.
+///
+/// \param[in] line The line.
+/// \param[in] timestamp The timestamp of the entry.
+//****************************************************************************************************************************************************
+void LogGenerator::appendBridgeLine(QByteArray &line, qint64 timestamp) {
+    line.append("time=\"");
+    appendTime(line, timestamp);
+    line.append("\" level=");
+    line.append(bridgeLevelNames[qsizetype(this->randomLevel())]);
+    line.append(" msg=\"");
+    line.append(fillMessage(bridgeMessages[rng_.bounded(qint32(bridgeMessages.size()))], rng_));
+    line.append('"');
+
+    if (rng_.generateDouble() < config_.invalidRatio) {
+        line.append(" dangling\n"); // The number of tokens is not a multiple of 3.
+        return;
+    }
+    if (rng_.generateDouble() < config_.messageUpdatedRatio) {
+        line.append(" message updated=true\n"); // Logrus field key with a space, handled by a workaround of the parser.
+        return;
+    }
+
+    line.append(" pkg=");
+    line.append(packages[rng_.bounded(qint32(packages.size()))]);
+    qint32 const fieldCount = rng_.bounded(qint32(qBound(qsizetype(0), config_.maxFieldCount, qsizetype(fieldKeys.size()))) + 1);
+    qint32 const firstKey = rng_.bounded(qint32(fieldKeys.size()));
+    for (qint32 i = 0; i < fieldCount; ++i) {
+        line.append(' ');
+        line.append(fieldKeys[(firstKey + i) % fieldKeys.size()]);
+        line.append('=');
+        this->appendFieldValue(line);
+    }
+    line.append('\n');
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] line The line.
+/// \param[in] timestamp The timestamp of the entry.
+//****************************************************************************************************************************************************
+void LogGenerator::appendGUILine(QByteArray &line, qint64 timestamp) {
+    if (rng_.generateDouble() < config_.invalidRatio) {
+        line.append("goroutine 1 [running]:\n");
+        return;
+    }
+    line.append(guiLevelNames[qsizetype(this->randomLevel())]);
+    line.append('[');
+    appendTime(line, timestamp);
+    line.append("] ");
+    line.append(fillMessage(guiMessages[rng_.bounded(qint32(guiMessages.size()))], rng_));
+    line.append('\n');
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] line The line.
+//****************************************************************************************************************************************************
+void LogGenerator::appendFieldValue(QByteArray &line) {
+    QByteArray const id = QByteArray::number(rng_.bounded(qint32(qMax(qsizetype(1), qMin(config_.fieldCardinality, qsizetype(INT_MAX))))), 16);
+    double const r = rng_.generateDouble();
+    if (r < config_.base64Ratio) {
+        QByteArray bytes(config_.base64Length, Qt::Uninitialized);
+        for (char &c: bytes) {
+            c = char(rng_.bounded(256));
+        }
+        line.append('"');
+        line.append(bytes.toBase64());
+        line.append('"');
+        return;
+    }
+    if (r < config_.base64Ratio + config_.escapedRatio) {
+        line.append(R"("error: \"server )");
+        line.append(id);
+        line.append(R"(\" closed the connection")");
+        return;
+    }
+    if (r < config_.base64Ratio + config_.escapedRatio + config_.quotedRatio) {
+        line.append("\"value ");
+        line.append(id);
+        line.append(" with spaces\"");
+        return;
+    }
+    line.append('v');
+    line.append(id);
+}
+
+
+//****************************************************************************************************************************************************
+/// \return A random level.
+//****************************************************************************************************************************************************
+LogEntry::Level LogGenerator::randomLevel() {
+    double const r = rng_.generateDouble();
+    qsizetype const index = std::ranges::upper_bound(cumulativeWeights_, r) - cumulativeWeights_.begin();
+    return LogEntry::Level(qMin(index, LogEntry::levelCount - 1));
+}
+
+
+//****************************************************************************************************************************************************
+/// \return A random interval between 0 and twice the mean interval, in milliseconds.
+//****************************************************************************************************************************************************
+qint64 LogGenerator::randomInterval() {
+    return (config_.meanIntervalMs <= 0) ? 0 : rng_.bounded(2 * config_.meanIntervalMs + 1);
+}
@@ -0,0 +1,79 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of synthetic log generator class.
+
+
+#ifndef ANALOG_LOG_GENERATOR_H
+#define ANALOG_LOG_GENERATOR_H
+
+
+#include "FilenameInfo.h"
+#include "LogEntry.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Synthetic log generator class.
+///
+/// The generator writes whole session folders: for each session, a launcher log, a bridge log in the bridge 3.4 logfmt format and a
+/// bridge-gui log in the bridge-gui 3.4 format. File names are valid for FilenameInfo, and logs larger than the maximum file size are split
+/// into several files with increasing file indices. The content is pseudo-random but fully determined by the configuration, including the
+/// seed, so measurements can be reproduced.
+//****************************************************************************************************************************************************
+class LogGenerator {
+public: // data types
+    struct Config {
+        quint32 seed { 1 }; ///< The seed of the random generator.
+        QDateTime start; ///< The start of the first session. If invalid, January 1st of the current year at 08:00 is used.
+        qsizetype sessionCount { 1 }; ///< The number of sessions.
+        qint64 bridgeByteCount { 100 * 1024 * 1024 }; ///< The size of the bridge log of each session, in bytes.
+        qint64 guiByteCount { 10 * 1024 * 1024 }; ///< The size of the bridge-gui log of each session, in bytes.
+        qsizetype launcherLineCount { 20 }; ///< The number of lines of the launcher log of each session.
+        qint64 maxFileByteCount { 256 * 1024 * 1024 }; ///< The maximum size of a log file, in bytes.
+        qint64 meanIntervalMs { 5 }; ///< The mean interval between two entries, in milliseconds.
+        std::array<double, LogEntry::levelCount> levelWeights { 10.0, 50.0, 30.0, 6.0, 3.5, 0.4, 0.1 }; ///< The relative frequency of each level.
+        qsizetype fieldCardinality { 1000 }; ///< The number of distinct values of each field.
+        qsizetype maxFieldCount { 6 }; ///< The maximum number of fields of a bridge entry, not counting the package.
+        double quotedRatio { 0.3 }; ///< The ratio of field values that are quoted.
+        double escapedRatio { 0.05 }; ///< The ratio of field values that contain escaped quotes.
+        double base64Ratio { 0.01 }; ///< The ratio of field values that are long base64 strings.
+        qsizetype base64Length { 2048 }; ///< The number of random bytes encoded in base64 values.
+        double messageUpdatedRatio { 0.001 }; ///< The ratio of bridge entries with a 'message updated' field key.
+        double invalidRatio { 0.0 }; ///< The ratio of lines that are not valid log entries.
+        QString version { "3.4.0" }; ///< The version in the file names.
+        QString tag { "generated" }; ///< The tag in the file names.
+    }; ///< Structure for generator configurations.
+
+    typedef std::function<void(qint64 byteCount)> ProgressCallback; ///< Type definition for progress callback functions.
+
+public: // static members
+    static qint64 constexpr sessionGapMs = 60 * 60 * 1000; ///< The time between the end of a session and the start of the next one.
+
+public: // member functions.
+    explicit LogGenerator(Config config); ///< Default constructor.
+    LogGenerator(LogGenerator const &) = delete; ///< Disabled copy-constructor.
+    LogGenerator(LogGenerator &&) = delete; ///< Disabled assignment copy-constructor.
+    ~LogGenerator() = default; ///< Destructor.
+    LogGenerator& operator=(LogGenerator const &) = delete; ///< Disabled assignment operator.
+    LogGenerator& operator=(LogGenerator &&) = delete; ///< Disabled move assignment operator.
+
+    QStringList generate(QString const &dirPath, ProgressCallback const &progress = {}); ///< Generate the sessions in a folder.
+
+private: // member functions.
+    QStringList writeLog(QDir const &dir, QString const &sessionID, FilenameInfo::Executable executable, qint64 maxByteCount,
+        qsizetype maxLineCount, qint64 &timestamp, ProgressCallback const &progress); ///< Write the log of an executable.
+    void appendBridgeLine(QByteArray &line, qint64 timestamp); ///< Append a random bridge 3.4 entry to a line.
+    void appendGUILine(QByteArray &line, qint64 timestamp); ///< Append a random bridge-gui 3.4 entry to a line.
+    void appendFieldValue(QByteArray &line); ///< Append a random field value to a line.
+    LogEntry::Level randomLevel(); ///< Return a random level, following the level weights.
+    qint64 randomInterval(); ///< Return a random interval between two entries.
+
+private: // data members
+    Config config_; ///< The configuration.
+    QRandomGenerator rng_; ///< The random generator.
+    std::array<double, LogEntry::levelCount> cumulativeWeights_ {}; ///< The cumulative level weights, normalized to 1.
+    qint64 bytesWritten_ { 0 }; ///< The number of bytes written so far.
+};
+
+
+#endif //ANALOG_LOG_GENERATOR_H
@@ -0,0 +1,198 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of log scheduler class.
+
+
+#include "LogScheduler.h"
+#include "LogCache.h"
+
+
+//****************************************************************************************************************************************************
+/// \param[in] filePaths The ordered list of files forming the log.
+/// \return The estimated memory usage of the log once opened, in bytes.
+//****************************************************************************************************************************************************
+qint64 estimatedByteCount(QStringList const &filePaths) {
+    return std::accumulate(filePaths.begin(), filePaths.end(), qint64(0), [](qint64 acc, QString const &filePath) -> qint64 {
+        return acc + QFileInfo(filePath).size() * LogScheduler::prefetchSizeFactor;
+    });
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+LogScheduler::LogScheduler() {
+    resumeTimer_.setSingleShot(true);
+    resumeTimer_.setInterval(resumeDelayMs);
+    connect(&resumeTimer_, &QTimer::timeout, this, &LogScheduler::startNextPrefetch);
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+LogScheduler::~LogScheduler() {
+    this->stop(prefetch_);
+    this->stop(load_);
+}
+
+
+//****************************************************************************************************************************************************
+/// Any high priority load in progress is cancelled. If the log is being prefetched, the prefetch is promoted to high priority. Otherwise,
+/// prefetching is pre-empted.
+///
+/// \param[in] filePaths The ordered list of files forming the log.
+//****************************************************************************************************************************************************
+void LogScheduler::load(QStringList const &filePaths) {
+    this->stop(load_);
+    prefetchQueue_.removeAll(filePaths);
+    if (prefetch_.generation && (prefetch_.filePaths == filePaths)) {
+        std::swap(load_, prefetch_);
+    } else {
+        this->preempt();
+        this->start(load_, filePaths);
+    }
+    resumeTimer_.start();
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void LogScheduler::cancel() {
+    this->stop(load_);
+    this->startNextPrefetch();
+}
+
+
+//****************************************************************************************************************************************************
+/// \return true iff a log is being loaded at high priority.
+//****************************************************************************************************************************************************
+bool LogScheduler::isLoading() const {
+    return load_.generation != 0;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The files of the log being loaded at high priority.
+/// \return An empty list if no log is being loaded at high priority.
+//****************************************************************************************************************************************************
+QStringList LogScheduler::filePaths() const {
+    return load_.filePaths;
+}
+
+
+//****************************************************************************************************************************************************
+/// The prefetch in progress is cancelled if its log is not in the new list.
+///
+/// \param[in] filePathsList The logs to prefetch, by decreasing priority.
+//****************************************************************************************************************************************************
+void LogScheduler::setPrefetchList(QList<QStringList> const &filePathsList) {
+    prefetchQueue_ = filePathsList;
+    if (prefetch_.generation) {
+        if (prefetchQueue_.contains(prefetch_.filePaths)) {
+            prefetchQueue_.removeAll(prefetch_.filePaths);
+        } else {
+            this->stop(prefetch_);
+        }
+    }
+    this->startNextPrefetch();
+}
+
+
+//****************************************************************************************************************************************************
+/// The prefetch in progress is cancelled, and its log is put back at the front of the queue.
+//****************************************************************************************************************************************************
+void LogScheduler::preempt() {
+    if (prefetch_.generation) {
+        prefetchQueue_.prepend(prefetch_.filePaths);
+        this->stop(prefetch_);
+    }
+    resumeTimer_.start();
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] task The task.
+/// \param[in] filePaths The ordered list of files forming the log.
+//****************************************************************************************************************************************************
+void LogScheduler::start(Task &task, QStringList const &filePaths) {
+    quint64 const generation = ++lastGeneration_;
+    task.generation = generation;
+    task.filePaths = filePaths;
+    task.cancelled = std::make_shared<std::atomic_bool>(false);
+    task.thread = std::thread([this, filePaths, generation, cancelled = task.cancelled, targetThread = this->thread()]() {
+        SPLog log = std::make_shared<Log>();
+        log->open(filePaths, *cancelled);
+        if (*cancelled) {
+            return;
+        }
+        log->moveToThread(targetThread);
+        QMetaObject::invokeMethod(this, [this, generation, filePaths, log]() { this->onTaskFinished(generation, filePaths, log); },
+            Qt::QueuedConnection);
+    });
+}
+
+
+//****************************************************************************************************************************************************
+/// The worker thread checks for cancellation regularly while reading, parsing and indexing, so this function returns quickly.
+///
+/// \param[in] task The task.
+//****************************************************************************************************************************************************
+void LogScheduler::stop(Task &task) {
+    if (task.cancelled) {
+        *task.cancelled = true;
+    }
+    if (task.thread.joinable()) {
+        task.thread.join();
+    }
+    task.generation = 0;
+    task.filePaths.clear();
+    task.cancelled.reset();
+}
+
+
+//****************************************************************************************************************************************************
+/// Results of cancelled tasks are discarded. A task may have been promoted from low to high priority while it was running, so tasks are
+/// identified by their generation.
+///
+/// \param[in] generation The generation of the task.
+/// \param[in] filePaths The ordered list of files forming the log.
+/// \param[in] log The log.
+//****************************************************************************************************************************************************
+void LogScheduler::onTaskFinished(quint64 generation, QStringList const &filePaths, SPLog const &log) {
+    if (generation == load_.generation) {
+        this->stop(load_);
+        emit loaded(filePaths, log);
+    } else if (generation == prefetch_.generation) {
+        this->stop(prefetch_);
+        LogCache::insert(filePaths, log);
+    } else {
+        return;
+    }
+    this->startNextPrefetch();
+}
+
+
+//****************************************************************************************************************************************************
+/// Logs that are already cached are skipped. Prefetching stops at the first log that does not fit in the free memory budget of the log cache,
+/// so prefetched logs never cause the eviction of other logs.
+//****************************************************************************************************************************************************
+void LogScheduler::startNextPrefetch() {
+    if (load_.generation || prefetch_.generation || resumeTimer_.isActive()) {
+        return;
+    }
+    while (!prefetchQueue_.isEmpty()) {
+        QStringList const filePaths = prefetchQueue_.takeFirst();
+        if (filePaths.isEmpty() || LogCache::contains(filePaths)) {
+            continue;
+        }
+        if (estimatedByteCount(filePaths) > LogCache::availableByteCount()) {
+            prefetchQueue_.clear();
+            return;
+        }
+        this->start(prefetch_, filePaths);
+        return;
+    }
+}
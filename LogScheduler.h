@@ -0,0 +1,73 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of log scheduler class.
+
+
+#ifndef ANALOG_LOG_SCHEDULER_H
+#define ANALOG_LOG_SCHEDULER_H
+
+
+#include "Log.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Log scheduler class.
+///
+/// The scheduler opens logs on background threads, at two priorities. The displayed log is loaded at high priority: starting a new load
+/// cancels the current one, and pre-empts prefetching. Logs the user is likely to open next are prefetched at low priority, one at a time,
+/// only while no high priority load is running and while they fit in the free memory budget of the log cache. Prefetched logs are inserted
+/// in the log cache. Prefetching is pre-empted by preempt(), that must only be called when the user starts new work, like editing a filter,
+/// searching or sorting, and not on every input, and resumes after a short period of inactivity. A pre-empted prefetch is restarted from
+/// scratch, but if the user requests the log that is being prefetched, the prefetch is promoted to high priority instead.
+/// Logs are moved to the thread of the scheduler before they are published. The scheduler must only be used from the GUI thread.
+//****************************************************************************************************************************************************
+class LogScheduler : public QObject {
+    Q_OBJECT
+
+public: // static members
+    static qint64 constexpr prefetchSizeFactor = 4; ///< The ratio between the estimated memory usage of a log and the size of its files.
+    static int constexpr resumeDelayMs = 500; ///< The delay after the last pre-emption after which prefetching resumes, in milliseconds.
+
+public: // member functions.
+    LogScheduler(); ///< Default constructor.
+    LogScheduler(LogScheduler const &) = delete; ///< Disabled copy-constructor.
+    LogScheduler(LogScheduler &&) = delete; ///< Disabled assignment copy-constructor.
+    ~LogScheduler() override; ///< Destructor.
+    LogScheduler& operator=(LogScheduler const &) = delete; ///< Disabled assignment operator.
+    LogScheduler& operator=(LogScheduler &&) = delete; ///< Disabled move assignment operator.
+
+    void load(QStringList const &filePaths); ///< Start loading a log at high priority.
+    void cancel(); ///< Cancel the current high priority load.
+    bool isLoading() const; ///< Check if a log is being loaded at high priority.
+    QStringList filePaths() const; ///< Return the files of the log being loaded at high priority.
+    void setPrefetchList(QList<QStringList> const &filePathsList); ///< Set the logs to prefetch at low priority, by decreasing priority.
+    void preempt(); ///< Suspend prefetching while the user starts new work, until no work has been started for resumeDelayMs.
+
+signals:
+    void loaded(QStringList const &filePaths, SPLog const &log); ///< Signal emitted when a log has been loaded at high priority.
+
+private: // data types
+    struct Task {
+        std::thread thread; ///< The worker thread.
+        std::shared_ptr<std::atomic_bool> cancelled; ///< The cancellation flag.
+        quint64 generation { 0 }; ///< The generation of the task, or 0 if no task is running.
+        QStringList filePaths; ///< The files of the log being loaded.
+    }; ///< Structure for the background load tasks.
+
+private: // member functions.
+    void start(Task &task, QStringList const &filePaths); ///< Start a load task.
+    void stop(Task &task); ///< Cancel a load task.
+    void onTaskFinished(quint64 generation, QStringList const &filePaths, SPLog const &log); ///< Handle a log loaded by a worker thread.
+    void startNextPrefetch(); ///< Start prefetching the next log, if possible.
+
+private: // data members.
+    Task load_; ///< The high priority task.
+    Task prefetch_; ///< The low priority task.
+    quint64 lastGeneration_ { 0 }; ///< The generation of the last task started.
+    QList<QStringList> prefetchQueue_; ///< The logs waiting to be prefetched, by decreasing priority.
+    QTimer resumeTimer_; ///< The timer resuming prefetching after a period of inactivity.
+};
+
+
+#endif //ANALOG_LOG_SCHEDULER_H
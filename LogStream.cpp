@@ -0,0 +1,63 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of log stream class.
+
+
+#include "LogStream.h"
+#include "Tracer.h"
+
+
+//****************************************************************************************************************************************************
+/// The bridge, bridge-gui and launcher log files are read in that order.
+///
+/// \param[in] session The session.
+/// \param[in] callback The function called for each entry, including invalid ones.
+/// \param[in,out] errors The list errors are appended to.
+/// \param[in] cancelled The cancellation flag.
+//****************************************************************************************************************************************************
+void LogStream::readSession(Session const &session, EntryCallback const &callback, QStringList &errors, std::atomic_bool const &cancelled) {
+    for (QStringList const &filePaths: { session.bridgeFilePaths(), session.guiFilePaths(), session.launcherFilePaths() }) {
+        for (QString const &filePath: filePaths) {
+            if (cancelled) {
+                return;
+            }
+            readFile(filePath, callback, errors, cancelled);
+        }
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] filePath The path of the log file.
+/// \param[in] callback The function called for each entry, including invalid ones.
+/// \param[in,out] errors The list errors are appended to.
+/// \param[in] cancelled The cancellation flag.
+//****************************************************************************************************************************************************
+void LogStream::readFile(QString const &filePath, EntryCallback const &callback, QStringList &errors, std::atomic_bool const &cancelled) {
+    Tracer::Scope const scope("LogStream::readFile", "io");
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        errors.append(QString("The file '%1' could not be opened.").arg(QDir::toNativeSeparators(filePath)));
+        return;
+    }
+    if (file.atEnd()) {
+        return;
+    }
+
+    QByteArray line = file.readLine();
+    LogEntry::Format const format = Log::getLogFormat(QString::fromUtf8(line));
+    if (format == LogEntry::Format::Unknown) {
+        errors.append(QString("The file '%1' is not of a known log format.").arg(QDir::toNativeSeparators(filePath)));
+        return;
+    }
+
+    qsizetype lineCount = 0;
+    while (true) {
+        callback(LogEntry(std::move(line), format));
+        if (file.atEnd() || ((++lineCount % cancellationCheckInterval == 0) && cancelled)) {
+            return;
+        }
+        line = file.readLine();
+    }
+}
@@ -0,0 +1,35 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of log stream class.
+
+
+#ifndef ANALOG_LOG_STREAM_H
+#define ANALOG_LOG_STREAM_H
+
+
+#include "Session.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Log stream class.
+///
+/// The class reads log files line by line and passes each parsed entry to a callback, without storing the entries. It is used by the analyses
+/// that fold whole sessions into aggregates, so that their memory use does not depend on the size of the logs.
+//****************************************************************************************************************************************************
+class LogStream {
+public: // data types
+    typedef std::function<void(LogEntry const &entry)> EntryCallback; ///< Type definition for entry callback functions.
+
+public: // static members
+    static qsizetype constexpr cancellationCheckInterval = 4096; ///< The number of lines read between two checks of the cancellation flag.
+
+public: // static member functions.
+    static void readSession(Session const &session, EntryCallback const &callback, QStringList &errors,
+        std::atomic_bool const &cancelled); ///< Read all the log files of a session.
+    static void readFile(QString const &filePath, EntryCallback const &callback, QStringList &errors,
+        std::atomic_bool const &cancelled); ///< Read a log file.
+};
+
+
+#endif //ANALOG_LOG_STREAM_H
@@ -0,0 +1,67 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of log style class.
+
+
+#include "LogStyle.h"
+#include "Log.h"
+
+
+namespace {
+QColor const traceColor("#fffffc"); ///< The color for the trace log level.
+QColor const debugColor("#9bf6ff"); ///< The color for the debug log level.
+QColor const infoColor("#caffbf"); ///< The color for the info log level.
+QColor const warnColor("#fdd6a5"); ///< The color for the warn log level.
+QColor const errorColor("#ffadad"); ///< The color for the error log level.
+QColor const fatalColor("#a0c4ff"); ///< The color for the fatal log level.
+QColor const panicColor("#bdb2ff"); ///< The color for the panic log level.
+QColor const background(0x2b, 0x2d, 0x30); ///< The background color of the log views.
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] level The level.
+/// \return The color associated with a level.
+//****************************************************************************************************************************************************
+QColor LogStyle::levelColor(LogEntry::Level level) {
+    switch (level) {
+    case LogEntry::Level::Trace:
+        return traceColor;
+    case LogEntry::Level::Debug:
+        return debugColor;
+    case LogEntry::Level::Info:
+        return infoColor;
+    case LogEntry::Level::Warn:
+        return warnColor;
+    case LogEntry::Level::Error:
+        return errorColor;
+    case LogEntry::Level::Fatal:
+        return fatalColor;
+    case LogEntry::Level::Panic:
+        return panicColor;
+    default:
+        qCritical() << QString("Unknown log level '%1'").arg(static_cast<qint64>(level));
+        return traceColor;
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The background color of the log views.
+//****************************************************************************************************************************************************
+QColor LogStyle::backgroundColor() {
+    return background;
+}
+
+
+//****************************************************************************************************************************************************
+/// This function must be called before any log is displayed.
+//****************************************************************************************************************************************************
+void LogStyle::install() {
+    std::array<QVariant, LogEntry::levelCount> levelColors;
+    for (qsizetype i = 0; i < LogEntry::levelCount; ++i) {
+        levelColors[i] = levelColor(LogEntry::Level(i));
+    }
+    Log::setDisplayColors(levelColors, background);
+}
@@ -0,0 +1,28 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of log style class.
+
+
+#ifndef ANALOG_LOG_STYLE_H
+#define ANALOG_LOG_STYLE_H
+
+
+#include "LogEntry.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Log style class.
+///
+/// The colors used to display logs belong to the GUI, so the core library only depends on Qt Core. install() gives the colors to the log
+/// model, that returns them for the foreground and background roles.
+//****************************************************************************************************************************************************
+class LogStyle {
+public: // static member functions.
+    static QColor levelColor(LogEntry::Level level); ///< Return the color for a level.
+    static QColor backgroundColor(); ///< Return the background color of the log views.
+    static void install(); ///< Install the style in the log model.
+};
+
+
+#endif //ANALOG_LOG_STYLE_H
@@ -5,7 +5,14 @@
 
 
 #include "MainWindow.h"
+#include "DiagnosticsDialog.h"
+#include "ExportDialog.h"
+#include "LogCache.h"
+#include "PagedLogDialog.h"
 #include "ReportDialog.h"
+#include "SessionAnalysisDialog.h"
+#include "SessionDiffDialog.h"
+#include "TemplateDialog.h"
 #include "Exception.h"
 
 
@@ -19,8 +26,14 @@ MainWindow::MainWindow() {
     ui_.sessionList->setMinimumWidth(250);
     connect(ui_.sessionList->selectionModel(), &QItemSelectionModel::selectionChanged, this, &MainWindow::onSelectedSessionChanged);
     connect(ui_.actionOpenFile, &QAction::triggered, this, &MainWindow::onActionOpenFile);
+    connect(ui_.actionOpenLargeFile, &QAction::triggered, this, &MainWindow::onActionOpenLargeFile);
+    connect(ui_.actionExport, &QAction::triggered, this, &MainWindow::onActionExport);
     connect(ui_.actionAbout, &QAction::triggered, this, &MainWindow::onAbout);
     connect(ui_.actionShowReport, &QAction::triggered, this, &MainWindow::onActionShowReport);
+    connect(ui_.actionShowTemplates, &QAction::triggered, this, &MainWindow::onActionShowTemplates);
+    connect(ui_.actionAnalyzeSessions, &QAction::triggered, this, &MainWindow::onActionAnalyzeSessions);
+    connect(ui_.actionCompareSessions, &QAction::triggered, this, &MainWindow::onActionCompareSessions);
+    connect(ui_.actionShowDiagnostics, &QAction::triggered, this, &MainWindow::onActionShowDiagnostics);
     connect(ui_.sessionWidget, &SessionWidget::logStatusMessageChanged, this, &MainWindow::onLogStatusMessageChanged);
     connect(ui_.sessionWidget, &SessionWidget::logErrorsOccurred, this, &MainWindow::onLogErrors);
 }
@@ -37,6 +50,64 @@ void MainWindow::onActionOpenFile() {
 }
 
 
+//****************************************************************************************************************************************************
+/// Large files are opened in a paged log dialog, that only keeps a few pages of the log in memory.
+//****************************************************************************************************************************************************
+void MainWindow::onActionOpenLargeFile() {
+    QStringList filePaths = QFileDialog::getOpenFileNames(this, tr("Select log file"), QString(), tr("Log files (*.log);;All files (*.*)"));
+    if (filePaths.isEmpty()) {
+        return;
+    }
+    filePaths.sort();
+    auto *dlg = new PagedLogDialog(this, filePaths);
+    dlg->setAttribute(Qt::WA_DeleteOnClose);
+    dlg->show();
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void MainWindow::onActionCompareSessions() {
+    if (sessionList_.count() == 0) {
+        return;
+    }
+    QModelIndex const current = ui_.sessionList->currentIndex();
+    auto *dlg = new SessionDiffDialog(this, sessionList_.sessions(), current.isValid() ? current.row() : -1);
+    dlg->setAttribute(Qt::WA_DeleteOnClose);
+    dlg->show();
+}
+
+
+//****************************************************************************************************************************************************
+/// The diagnostics dialog is not modal, so the statistics can be watched while logs are opened and filtered.
+//****************************************************************************************************************************************************
+void MainWindow::onActionShowDiagnostics() {
+    auto *dlg = new DiagnosticsDialog(this, [this]() -> QList<std::pair<QString, MemoryUsage>> {
+        return {
+            { "Displayed log", ui_.sessionWidget->memoryUsage() },
+            { "Session list", sessionList_.memoryUsage() },
+            { "Log cache", LogCache::memoryUsage() },
+        };
+    });
+    dlg->setAttribute(Qt::WA_DeleteOnClose);
+    dlg->show();
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void MainWindow::onActionExport() {
+    SPLog const log = ui_.sessionWidget->log();
+    if (!log) {
+        return;
+    }
+    ExportDialog dlg(this, log, ui_.sessionWidget->visibleSourceRows());
+    dlg.exec();
+}
+
+
 //****************************************************************************************************************************************************
 /// \param[in] filePaths The list of file paths to open
 //****************************************************************************************************************************************************
@@ -101,10 +172,11 @@ void MainWindow::dropEvent(QDropEvent *event) {
 //****************************************************************************************************************************************************
 void MainWindow::onActionShowReport() {
     try {
-        if (!log_) {
+        SPLog const log = ui_.sessionWidget->log();
+        if (!log) {
             return;
         }
-        ReportDialog dlg(this, log_->generateReport());
+        ReportDialog dlg(this, log->generateReport());
         dlg.exec();
     } catch (Exception const &e) {
         QMessageBox::critical(this, "Error", e.message());
@@ -112,6 +184,38 @@ void MainWindow::onActionShowReport() {
 }
 
 
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void MainWindow::onActionShowTemplates() {
+    SPLog const log = ui_.sessionWidget->log();
+    if (!log) {
+        return;
+    }
+    TemplateDialog dlg(this, log);
+    connect(&dlg, &TemplateDialog::sourceRowActivated, ui_.sessionWidget, &SessionWidget::selectSourceRow);
+    dlg.exec();
+}
+
+
+//****************************************************************************************************************************************************
+/// The analysis dialog is not modal, so sessions can be inspected while the analysis runs.
+//****************************************************************************************************************************************************
+void MainWindow::onActionAnalyzeSessions() {
+    if (sessionList_.count() == 0) {
+        return;
+    }
+    auto *dlg = new SessionAnalysisDialog(this, sessionList_.sessions());
+    dlg->setAttribute(Qt::WA_DeleteOnClose);
+    connect(dlg, &SessionAnalysisDialog::sessionActivated, this, [this](qsizetype index) {
+        if (index < sessionList_.count()) {
+            ui_.sessionList->setCurrentIndex(sessionList_.index(int(index), 0));
+        }
+    });
+    dlg->show();
+}
+
+
 //****************************************************************************************************************************************************
 //
 //****************************************************************************************************************************************************
@@ -125,7 +229,21 @@ void MainWindow::onAbout() {
 //****************************************************************************************************************************************************
 void MainWindow::onSelectedSessionChanged(const QItemSelection &selected, const QItemSelection &) const {
     QList<QModelIndex> const indexes = selected.indexes();
-    ui_.sessionWidget->setSession(indexes.isEmpty() ? std::optional<Session> {} : sessionList_[indexes.first().row()]);
+    if (indexes.isEmpty()) {
+        ui_.sessionWidget->setSession({});
+        return;
+    }
+
+    // The adjacent sessions are prefetched, the next one first.
+    int const row = indexes.first().row();
+    QList<Session> adjacentSessions;
+    if (row + 1 < sessionList_.count()) {
+        adjacentSessions.append(sessionList_[row + 1]);
+    }
+    if (row > 0) {
+        adjacentSessions.append(sessionList_[row - 1]);
+    }
+    ui_.sessionWidget->setSession(sessionList_[row], adjacentSessions);
 }
 
 
@@ -40,7 +40,13 @@ public slots:
     /// \name Actions
     ///\{
     void onActionOpenFile(); ///< Slot for the 'Open File' action.
+    void onActionOpenLargeFile(); ///< Slot for the 'Open Large File' action.
+    void onActionExport(); ///< Slot for the 'Export' action.
     void onActionShowReport(); ///< Slot for the 'Show Report' action.
+    void onActionShowTemplates(); ///< Slot for the 'Show Templates' action.
+    void onActionAnalyzeSessions(); ///< Slot for the 'Analyze All Sessions' action.
+    void onActionCompareSessions(); ///< Slot for the 'Compare Sessions' action.
+    void onActionShowDiagnostics(); ///< Slot for the 'Show Diagnostics' action.
     void onAbout(); ///< Slot for showing the about dialog.
     ///\}
 
@@ -52,7 +58,6 @@ public slots:
 private: // data members.
     Ui::MainWindow ui_ {}; ///< The GUI for the window.
     SessionList sessionList_; ///< The session list.
-    SPLog log_; ///< The log
 };
 
 
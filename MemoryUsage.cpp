@@ -0,0 +1,100 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of memory usage class.
+
+
+#include "MemoryUsage.h"
+
+
+//****************************************************************************************************************************************************
+/// \param[in] str The string.
+/// \return The heap size of the string, in bytes.
+//****************************************************************************************************************************************************
+qint64 MemoryUsage::stringByteCount(QString const &str) {
+    return str.capacity() ? qint64(sizeof(QArrayData)) + (str.capacity() + 1) * qint64(sizeof(QChar)) : 0;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] array The byte array.
+/// \return The heap size of the byte array, in bytes.
+//****************************************************************************************************************************************************
+qint64 MemoryUsage::byteArrayByteCount(QByteArray const &array) {
+    return array.capacity() ? qint64(sizeof(QArrayData)) + array.capacity() + 1 : 0;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] list The list.
+/// \return The heap size of the list, including its strings, in bytes.
+//****************************************************************************************************************************************************
+qint64 MemoryUsage::stringListByteCount(QStringList const &list) {
+    qint64 result = listByteCount(list);
+    for (QString const &str: list) {
+        result += stringByteCount(str);
+    }
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] byteCount The number of bytes.
+/// \return A human-readable string for the number of bytes.
+//****************************************************************************************************************************************************
+QString MemoryUsage::formatByteCount(qint64 byteCount) {
+    return QLocale::c().formattedDataSize(byteCount, 1, QLocale::DataSizeTraditionalFormat);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] name The name of the component.
+/// \param[in] byteCount The size of the component, in bytes.
+//****************************************************************************************************************************************************
+void MemoryUsage::add(QString const &name, qint64 byteCount) {
+    components_.append({ name, byteCount });
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] prefix The prefix added to the name of the components.
+/// \param[in] usage The memory usage.
+//****************************************************************************************************************************************************
+void MemoryUsage::add(QString const &prefix, MemoryUsage const &usage) {
+    for (Component const &component: usage.components_) {
+        components_.append({ prefix + component.name, component.byteCount });
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The components.
+//****************************************************************************************************************************************************
+QList<MemoryUsage::Component> const &MemoryUsage::components() const {
+    return components_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The total size of the components, in bytes.
+//****************************************************************************************************************************************************
+qint64 MemoryUsage::total() const {
+    return std::accumulate(components_.begin(), components_.end(), qint64(0), [](qint64 acc, Component const &component) -> qint64 {
+        return acc + component.byteCount;
+    });
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The memory usage as JSON, with the size in bytes of each component and the total.
+//****************************************************************************************************************************************************
+QJsonObject MemoryUsage::toJson() const {
+    QJsonObject components;
+    for (Component const &component: components_) {
+        components.insert(component.name, component.byteCount);
+    }
+    return {
+        { "components", components },
+        { "total", this->total() },
+    };
+}
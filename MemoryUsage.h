@@ -0,0 +1,83 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of memory usage class.
+
+
+#ifndef ANALOG_MEMORY_USAGE_H
+#define ANALOG_MEMORY_USAGE_H
+
+
+//****************************************************************************************************************************************************
+/// \brief Memory usage class.
+///
+/// A memory usage is a list of named components with their size in bytes. Sizes are estimates computed from the size and capacity of
+/// containers: they ignore allocator overhead, and implicitly shared data is counted once per reference.
+//****************************************************************************************************************************************************
+class MemoryUsage {
+public: // data types
+    struct Component {
+        QString name; ///< The name of the component.
+        qint64 byteCount { 0 }; ///< The size of the component, in bytes.
+    }; ///< Structure for memory components.
+
+public: // static members
+    static qint64 constexpr mapNodeOverhead = 32; ///< The estimated size of the bookkeeping data of a QMap node, in bytes.
+    static qint64 constexpr hashNodeOverhead = 8; ///< The estimated size of the bookkeeping data of a QHash node, in bytes.
+
+public: // static member functions.
+    static qint64 stringByteCount(QString const &str); ///< Return the heap size of a string.
+    static qint64 byteArrayByteCount(QByteArray const &array); ///< Return the heap size of a byte array.
+    static qint64 stringListByteCount(QStringList const &list); ///< Return the heap size of a string list, including its strings.
+    template <typename T> static qint64 listByteCount(QList<T> const &list); ///< Return the heap size of a list, excluding heap data of its items.
+    template <typename K, typename V> static qint64 mapByteCount(QMap<K, V> const &map); ///< Return the heap size of a map, excluding heap data of its items.
+    template <typename K, typename V> static qint64 hashByteCount(QHash<K, V> const &hash); ///< Return the heap size of a hash, excluding heap data of its items.
+    static QString formatByteCount(qint64 byteCount); ///< Return a human-readable string for a number of bytes.
+
+public: // member functions.
+    MemoryUsage() = default; ///< Default constructor.
+    MemoryUsage(MemoryUsage const &) = default; ///< Default copy-constructor.
+    MemoryUsage(MemoryUsage &&) = default; ///< Default move-constructor.
+    ~MemoryUsage() = default; ///< Destructor.
+    MemoryUsage& operator=(MemoryUsage const &) = default; ///< Default assignment operator.
+    MemoryUsage& operator=(MemoryUsage &&) = default; ///< Default move assignment operator.
+
+    void add(QString const &name, qint64 byteCount); ///< Add a component.
+    void add(QString const &prefix, MemoryUsage const &usage); ///< Add the components of another memory usage, with a name prefix.
+    QList<Component> const &components() const; ///< Return the components.
+    qint64 total() const; ///< Return the total size of the components.
+    QJsonObject toJson() const; ///< Return the memory usage as JSON.
+
+private: // data members
+    QList<Component> components_; ///< The components.
+};
+
+
+//****************************************************************************************************************************************************
+/// \param[in] list The list.
+/// \return The heap size of the list, excluding the heap data of its items.
+//****************************************************************************************************************************************************
+template <typename T> qint64 MemoryUsage::listByteCount(QList<T> const &list) {
+    return list.capacity() ? qint64(sizeof(QArrayData)) + list.capacity() * qint64(sizeof(T)) : 0;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] map The map.
+/// \return The heap size of the map, excluding the heap data of its items.
+//****************************************************************************************************************************************************
+template <typename K, typename V> qint64 MemoryUsage::mapByteCount(QMap<K, V> const &map) {
+    return map.size() * (mapNodeOverhead + qint64(sizeof(K)) + qint64(sizeof(V)));
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] hash The hash.
+/// \return The heap size of the hash, excluding the heap data of its items.
+//****************************************************************************************************************************************************
+template <typename K, typename V> qint64 MemoryUsage::hashByteCount(QHash<K, V> const &hash) {
+    return hash.capacity() * (hashNodeOverhead + qint64(sizeof(K)) + qint64(sizeof(V)));
+}
+
+
+#endif //ANALOG_MEMORY_USAGE_H
@@ -8,7 +8,7 @@
 #define ANALOG_PCH_H
 
 
-#include <QtCore>
+#include "CorePCH.h"
 #include <QtGui>
 #include <QtWidgets>
 
@@ -0,0 +1,282 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of paged log class.
+
+
+#include "PagedLog.h"
+#include "Log.h"
+#include "LogStyle.h"
+#include "Exception.h"
+
+
+namespace {
+qint64 constexpr indexBlockSize = 4 * 1024 * 1024; ///< The size of the blocks read when indexing files.
+}
+
+
+//****************************************************************************************************************************************************
+/// Opening the log reads the files once, to locate the first line of every page. No entry is parsed, except the first one to detect the format.
+///
+/// \param[in] filePaths The ordered list of files forming the log.
+/// \param[in] progress An optional progress callback. If the callback returns false, the log is left empty.
+//****************************************************************************************************************************************************
+void PagedLog::open(QStringList const &filePaths, ProgressCallback const &progress) {
+    this->beginResetModel();
+    filePaths_.clear();
+    pages_.clear();
+    cache_.clear();
+    lineCount_ = 0;
+    windowStart_ = 0;
+    format_ = LogEntry::Format::Unknown;
+
+    try {
+        qint64 const bytesTotal = std::accumulate(filePaths.begin(), filePaths.end(), qint64(0), [](qint64 acc, QString const &path) -> qint64 {
+            return acc + QFileInfo(path).size();
+        });
+        qint64 bytesRead = 0;
+        for (qsizetype fileIndex = 0; fileIndex < filePaths.count(); ++fileIndex) {
+            QString const &filePath = filePaths[fileIndex];
+            QFile file(filePath);
+            if (!file.open(QIODevice::ReadOnly)) {
+                throw Exception(QString("The file '%1' could not be opened.").arg(QDir::toNativeSeparators(filePath)));
+            }
+
+            LogEntry::Format const format = Log::getLogFormat(QString::fromUtf8(file.readLine()));
+            if (format == LogEntry::Format::Unknown) {
+                throw Exception(QString("The file '%1' is not of a known log format.").arg(QDir::toNativeSeparators(filePath)));
+            }
+            if ((format_ != LogEntry::Format::Unknown) && (format_ != format)) {
+                throw Exception(QString("The file '%1' is not of the same format as the beginning of the log.").arg(QDir::toNativeSeparators(filePath)));
+            }
+            format_ = format;
+            file.seek(0);
+
+            qint64 offset = 0;
+            bool atLineStart = true;
+            while (!file.atEnd()) {
+                QByteArray const block = file.read(indexBlockSize);
+                char const *begin = block.constData();
+                char const *end = begin + block.size();
+                char const *p = begin;
+                while (p < end) {
+                    if (atLineStart) {
+                        if (lineCount_ % linesPerPage == 0) {
+                            pages_.append(PageLocation { .fileIndex = fileIndex, .offset = offset + (p - begin) });
+                        }
+                        ++lineCount_;
+                        atLineStart = false;
+                    }
+                    auto const *newLine = static_cast<char const *>(memchr(p, '\n', end - p));
+                    if (!newLine) {
+                        break;
+                    }
+                    p = newLine + 1;
+                    atLineStart = true;
+                }
+                offset += block.size();
+                bytesRead += block.size();
+                if (progress && !progress(bytesRead, bytesTotal)) {
+                    throw Exception("Opening of the log was cancelled.");
+                }
+            }
+            filePaths_.append(filePath);
+        }
+    } catch (Exception const &) {
+        filePaths_.clear();
+        pages_.clear();
+        lineCount_ = 0;
+        this->endResetModel();
+        throw;
+    }
+
+    this->endResetModel();
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The number of lines in the log.
+//****************************************************************************************************************************************************
+qint64 PagedLog::lineCount() const {
+    return lineCount_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The line number of the first row of the window.
+//****************************************************************************************************************************************************
+qint64 PagedLog::windowStart() const {
+    return windowStart_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The maximum number of rows in the window.
+//****************************************************************************************************************************************************
+int PagedLog::windowSize() const {
+    return windowSize_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] size The maximum number of rows in the window.
+//****************************************************************************************************************************************************
+void PagedLog::setWindowSize(int size) {
+    this->beginResetModel();
+    windowSize_ = qMax(1, size);
+    windowStart_ = qBound(qint64(0), windowStart_, qMax(qint64(0), lineCount_ - windowSize_));
+    this->endResetModel();
+}
+
+
+//****************************************************************************************************************************************************
+/// The window is clamped so that it stays within the log.
+///
+/// \param[in] line The line number of the first row of the window.
+//****************************************************************************************************************************************************
+void PagedLog::setWindowStart(qint64 line) {
+    qint64 const start = qBound(qint64(0), line, qMax(qint64(0), lineCount_ - windowSize_));
+    if (start == windowStart_) {
+        return;
+    }
+    this->beginResetModel();
+    windowStart_ = start;
+    this->endResetModel();
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] row The row in the window.
+/// \return The line number of the row.
+//****************************************************************************************************************************************************
+qint64 PagedLog::lineForRow(int row) const {
+    return windowStart_ + row;
+}
+
+
+//****************************************************************************************************************************************************
+/// The returned reference is only valid until the next access to an entry, as the page containing it may be evicted.
+///
+/// \param[in] line The line number.
+/// \return The entry at the line.
+//****************************************************************************************************************************************************
+LogEntry const &PagedLog::entry(qint64 line) const {
+    return (*this->page(line / linesPerPage))[qsizetype(line % linesPerPage)];
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The number of rows in the window.
+//****************************************************************************************************************************************************
+int PagedLog::rowCount(QModelIndex const &) const {
+    return int(qBound(qint64(0), lineCount_ - windowStart_, qint64(windowSize_)));
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The number of columns in the model.
+//****************************************************************************************************************************************************
+int PagedLog::columnCount(QModelIndex const &) const {
+    return 5;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] index The index of the data to retrieve.
+/// \param[in] role The role of the data to retrieve.
+/// \return The data for a given role at a model index.
+//****************************************************************************************************************************************************
+QVariant PagedLog::data(QModelIndex const &index, int role) const {
+    if ((role != Qt::DisplayRole) && (role != Qt::ForegroundRole) && (role != Qt::BackgroundRole)) {
+        return {};
+    }
+    LogEntry const &entry = this->entry(this->lineForRow(index.row()));
+    if (role == Qt::ForegroundRole) {
+        return LogStyle::levelColor(entry.isValid() ? entry.level() : LogEntry::Level::Error);
+    }
+    if (role == Qt::BackgroundRole) {
+        return LogStyle::backgroundColor();
+    }
+    if (!entry.isValid()) {
+        return (index.column() == 3) ? QString("Invalid log entry: %1").arg(entry.error()) : QString();
+    }
+    switch (index.column()) {
+    case 0:
+        return LogEntry::timestampToString(entry.timestamp());
+    case 1:
+        return LogEntry::levelToString(entry.level());
+    case 2:
+        return entry.package();
+    case 3:
+        return entry.message();
+    case 4:
+        return entry.fieldsString();
+    default:
+        return {};
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// The vertical header displays the 1-based line numbers in the log.
+///
+/// \param[in] section The section (i.e. index of the row of column)
+/// \param[in] orientation The orientation of the header.
+/// \param[in] role The role of the data to retrieve.
+/// \return The data for the header.
+//****************************************************************************************************************************************************
+QVariant PagedLog::headerData(int section, Qt::Orientation orientation, int role) const {
+    if (role != Qt::DisplayRole) {
+        return QAbstractItemModel::headerData(section, orientation, role);
+    }
+    if (orientation == Qt::Vertical) {
+        return QString::number(this->lineForRow(section) + 1);
+    }
+    switch (section) {
+    case 0:
+        return tr("Time");
+    case 1:
+        return tr("Level");
+    case 2:
+        return tr("Package");
+    case 3:
+        return tr("Message");
+    case 4:
+        return tr("Fields");
+    default:
+        return {};
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] pageIndex The index of the page.
+/// \return The page.
+//****************************************************************************************************************************************************
+QList<LogEntry> *PagedLog::page(qint64 pageIndex) const {
+    if (QList<LogEntry> *cached = cache_.object(pageIndex)) {
+        return cached;
+    }
+
+    qint64 const lineCount = qMin(linesPerPage, lineCount_ - pageIndex * linesPerPage);
+    auto *entries = new QList<LogEntry>();
+    entries->reserve(lineCount);
+    PageLocation const &location = pages_[pageIndex];
+    qint64 offset = location.offset;
+    for (qsizetype fileIndex = location.fileIndex; (fileIndex < filePaths_.count()) && (entries->count() < lineCount); ++fileIndex) {
+        QFile file(filePaths_[fileIndex]);
+        if ((!file.open(QIODevice::ReadOnly)) || (!file.seek(offset))) {
+            break;
+        }
+        while ((entries->count() < lineCount) && (!file.atEnd())) {
+            entries->append(LogEntry(file.readLine(), format_));
+        }
+        offset = 0;
+    }
+    while (entries->count() < lineCount) {
+        entries->append(LogEntry(QByteArray(), format_)); // the file was modified or removed since the log was opened.
+    }
+
+    cache_.insert(pageIndex, entries);
+    return entries;
+}
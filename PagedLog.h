@@ -0,0 +1,77 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of paged log class.
+
+
+#ifndef ANALOG_PAGED_LOG_H
+#define ANALOG_PAGED_LOG_H
+
+
+#include "LogEntry.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Paged log class.
+///
+/// Contrary to Log, the paged log does not keep the entries in memory. Opening the log only builds a sparse index of the files, with the
+/// location of the first line of each page. Pages are read and parsed from disk on demand, and are evicted when the page cache is full.
+///
+/// Line numbers are 64-bit, so the log can have more lines than INT_MAX. As Qt models use int rows, the model only exposes a window of the log
+/// starting at windowStart(). Entries that cannot be parsed are displayed as errors instead of being skipped, so that line numbers and rows
+/// always match.
+//****************************************************************************************************************************************************
+class PagedLog : public QAbstractTableModel {
+    Q_OBJECT
+
+public: // data types
+    typedef std::function<bool(qint64 bytesRead, qint64 bytesTotal)> ProgressCallback; ///< Type for progress callbacks. Return false to cancel.
+
+public: // static members
+    static qint64 constexpr linesPerPage = 4096; ///< The number of lines in a page.
+    static int constexpr maxCachedPages = 64; ///< The maximum number of pages in the page cache.
+    static int constexpr defaultWindowSize = 1000000; ///< The default number of rows in the window.
+
+public: // member functions.
+    PagedLog() = default; ///< Default constructor.
+    PagedLog(PagedLog const &) = delete; ///< Disabled copy-constructor.
+    PagedLog(PagedLog &&) = delete; ///< Disabled assignment copy-constructor.
+    ~PagedLog() override = default; ///< Destructor.
+    PagedLog &operator=(PagedLog const &) = delete; ///< Disabled assignment operator.
+    PagedLog &operator=(PagedLog &&) = delete; ///< Disabled move assignment operator.
+
+    void open(QStringList const &filePaths, ProgressCallback const &progress = {}); ///< Open a log from an ordered list of files.
+    qint64 lineCount() const; ///< Return the total number of lines in the log.
+    qint64 windowStart() const; ///< Return the line number of the first row of the window.
+    int windowSize() const; ///< Return the maximum number of rows in the window.
+    void setWindowSize(int size); ///< Set the maximum number of rows in the window.
+    void setWindowStart(qint64 line); ///< Move the window.
+    qint64 lineForRow(int row) const; ///< Return the line number for a row of the window.
+    LogEntry const &entry(qint64 line) const; ///< Return the entry at a given line.
+
+    int rowCount(QModelIndex const &parent) const override; ///< Get the number of rows in the model.
+    int columnCount(QModelIndex const &parent) const override; ///< Get the number of columns in the model.
+    QVariant data(QModelIndex const &index, int role) const override; ///< Get the data at an index in the model.
+    QVariant headerData(int section, Qt::Orientation orientation, int role) const override; ///< Get the header data for a row/column.
+
+private: // data types
+    struct PageLocation {
+        qsizetype fileIndex { 0 }; ///< The index of the file containing the first line of the page.
+        qint64 offset { 0 }; ///< The offset of the first line of the page in the file.
+    }; ///< Structure for the location of a page on disk.
+
+private: // member functions.
+    QList<LogEntry> *page(qint64 pageIndex) const; ///< Return a page, reading it from disk if needed.
+
+private: // data members
+    QStringList filePaths_; ///< The paths of the files.
+    LogEntry::Format format_ { LogEntry::Format::Unknown }; ///< The log format.
+    QList<PageLocation> pages_; ///< The location of the pages.
+    qint64 lineCount_ { 0 }; ///< The total number of lines.
+    qint64 windowStart_ { 0 }; ///< The line number of the first row of the window.
+    int windowSize_ { defaultWindowSize }; ///< The maximum number of rows in the window.
+    mutable QCache<qint64, QList<LogEntry>> cache_ { maxCachedPages }; ///< The page cache.
+};
+
+
+#endif //ANALOG_PAGED_LOG_H
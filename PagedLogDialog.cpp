@@ -0,0 +1,121 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of paged log dialog class.
+
+
+#include "PagedLogDialog.h"
+#include "Exception.h"
+
+
+namespace {
+int constexpr scrollBarSteps = 1000000; ///< The maximum number of steps of the virtual scroll bar.
+int constexpr windowMarginRatio = 10; ///< The window is recentered when scrolling within 1/windowMarginRatio of its edges.
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] parent The parent widget of the dialog.
+/// \param[in] filePaths The ordered list of files forming the log.
+//****************************************************************************************************************************************************
+PagedLogDialog::PagedLogDialog(QWidget *parent, QStringList const &filePaths)
+    : QDialog(parent) {
+    ui_.setupUi(this);
+    this->setWindowTitle(QFileInfo(filePaths.value(0)).fileName());
+    connect(ui_.buttonClose, &QPushButton::clicked, this, &QDialog::accept);
+
+    QProgressDialog progressDialog(tr("Indexing log files..."), tr("Cancel"), 0, 1000, parent);
+    progressDialog.setWindowModality(Qt::WindowModal);
+    progressDialog.setMinimumDuration(500);
+    try {
+        log_.open(filePaths, [&progressDialog](qint64 bytesRead, qint64 bytesTotal) -> bool {
+            progressDialog.setValue(bytesTotal > 0 ? int(bytesRead * 1000 / bytesTotal) : 0);
+            QCoreApplication::processEvents();
+            return !progressDialog.wasCanceled();
+        });
+    } catch (Exception const &e) {
+        QMessageBox::critical(parent, tr("Error"), e.message());
+    }
+
+    ui_.tableView->setModel(&log_);
+    ui_.tableView->setColumnWidth(0, 180);
+    ui_.tableView->setColumnWidth(1, 70);
+    ui_.tableView->setColumnWidth(2, 120);
+    ui_.tableView->setColumnWidth(3, 600);
+    ui_.tableView->verticalHeader()->setSectionResizeMode(QHeaderView::Fixed);
+    ui_.tableView->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
+    ui_.scrollBarLog->setRange(0, int(qMin(qint64(scrollBarSteps), qMax(qint64(0), log_.lineCount() - 1))));
+    ui_.scrollBarLog->setPageStep(qMax(1, ui_.scrollBarLog->maximum() / 100));
+
+    connect(ui_.scrollBarLog, &QScrollBar::valueChanged, this, &PagedLogDialog::onLogScrollBarChanged);
+    connect(ui_.tableView->verticalScrollBar(), &QScrollBar::valueChanged, this, &PagedLogDialog::onTableScrolled);
+    this->updateInfo();
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] value The value of the scroll bar.
+//****************************************************************************************************************************************************
+void PagedLogDialog::onLogScrollBarChanged(int value) {
+    if (updating_) {
+        return;
+    }
+    int const max = ui_.scrollBarLog->maximum();
+    qint64 const lastLine = qMax(qint64(0), log_.lineCount() - 1);
+    this->showLine((max > 0) ? qint64(double(value) / double(max) * double(lastLine)) : 0);
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void PagedLogDialog::onTableScrolled() {
+    if (updating_) {
+        return;
+    }
+    qint64 const line = this->topLine();
+    qint64 const row = line - log_.windowStart();
+    qint64 const margin = log_.windowSize() / windowMarginRatio;
+    bool const nearStart = (row < margin) && (log_.windowStart() > 0);
+    bool const nearEnd = (row > log_.windowSize() - margin) && (log_.windowStart() + log_.windowSize() < log_.lineCount());
+    if (nearStart || nearEnd) {
+        this->showLine(line);
+        return;
+    }
+
+    QSignalBlocker const blocker(ui_.scrollBarLog);
+    qint64 const lastLine = qMax(qint64(1), log_.lineCount() - 1);
+    ui_.scrollBarLog->setValue(int(double(line) / double(lastLine) * double(ui_.scrollBarLog->maximum())));
+    this->updateInfo();
+}
+
+
+//****************************************************************************************************************************************************
+/// The window is centered on the line.
+///
+/// \param[in] line The line number.
+//****************************************************************************************************************************************************
+void PagedLogDialog::showLine(qint64 line) {
+    updating_ = true;
+    log_.setWindowStart(line - log_.windowSize() / 2);
+    QModelIndex const index = log_.index(int(line - log_.windowStart()), 0);
+    ui_.tableView->scrollTo(index, QAbstractItemView::PositionAtTop);
+    updating_ = false;
+    this->updateInfo();
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The line number of the first visible row of the table view.
+//****************************************************************************************************************************************************
+qint64 PagedLogDialog::topLine() const {
+    return log_.lineForRow(qMax(0, ui_.tableView->rowAt(0)));
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void PagedLogDialog::updateInfo() {
+    ui_.labelInfo->setText(tr("Line %1 of %2").arg(this->topLine() + 1).arg(log_.lineCount()));
+}
@@ -0,0 +1,48 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of paged log dialog class.
+
+
+#ifndef ANALOG_PAGED_LOG_DIALOG_H
+#define ANALOG_PAGED_LOG_DIALOG_H
+
+
+#include "ui_PagedLogDialog.h"
+#include "PagedLog.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Paged log dialog class.
+///
+/// The dialog displays a paged log. The scroll bar on the right of the table is a virtual scroll bar spanning the whole log: moving it
+/// moves the window of the model. Scrolling the table close to the edges of the window recenters the window.
+//****************************************************************************************************************************************************
+class PagedLogDialog : public QDialog {
+    Q_OBJECT
+
+public: // member functions.
+    PagedLogDialog(QWidget *parent, QStringList const &filePaths); ///< Default constructor.
+    PagedLogDialog(PagedLogDialog const &) = delete; ///< Disabled copy-constructor.
+    PagedLogDialog(PagedLogDialog &&) = delete; ///< Disabled assignment copy-constructor.
+    ~PagedLogDialog() override = default; ///< Destructor.
+    PagedLogDialog& operator=(PagedLogDialog const &) = delete; ///< Disabled assignment operator.
+    PagedLogDialog& operator=(PagedLogDialog &&) = delete; ///< Disabled move assignment operator.
+
+private slots:
+    void onLogScrollBarChanged(int value); ///< Slot for the change of the virtual scroll bar.
+    void onTableScrolled(); ///< Slot for the scrolling of the table view.
+
+private: // member functions.
+    void showLine(qint64 line); ///< Show a line at the top of the table view, moving the window if needed.
+    qint64 topLine() const; ///< Return the line number of the first visible row.
+    void updateInfo(); ///< Update the information label.
+
+private: // data members
+    Ui::PagedLogDialog ui_ {}; ///< The UI for the dialog.
+    PagedLog log_; ///< The paged log.
+    bool updating_ { false }; ///< Set while the dialog updates the scroll bars, to avoid feedback loops.
+};
+
+
+#endif //ANALOG_PAGED_LOG_DIALOG_H
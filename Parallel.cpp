@@ -0,0 +1,43 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of parallel processing functions.
+
+
+#include "Parallel.h"
+
+
+//****************************************************************************************************************************************************
+/// \param[in] count The number of items.
+/// \param[in] minChunkSize The minimum number of items in a chunk.
+/// \return The number of chunks, which is at most the number of hardware threads.
+//****************************************************************************************************************************************************
+qsizetype parallelChunkCount(qsizetype count, qsizetype minChunkSize) {
+    qsizetype const threadCount = qMax(qsizetype(1), qsizetype(std::thread::hardware_concurrency()));
+    return qBound(qsizetype(1), count / qMax(qsizetype(1), minChunkSize), threadCount);
+}
+
+
+//****************************************************************************************************************************************************
+/// The items are split in parallelChunkCount() contiguous chunks of similar size, each processed on its own thread. The first chunk is
+/// processed on the calling thread. The function returns when all chunks have been processed.
+///
+/// \param[in] count The number of items.
+/// \param[in] minChunkSize The minimum number of items in a chunk.
+/// \param[in] func The function called for each chunk, with the index of the chunk and the [begin, end) range of items.
+//****************************************************************************************************************************************************
+void parallelFor(qsizetype count, qsizetype minChunkSize, ChunkFunction const &func) {
+    qsizetype const chunkCount = parallelChunkCount(count, minChunkSize);
+    qsizetype const chunkSize = (count + chunkCount - 1) / chunkCount;
+    std::vector<std::thread> threads;
+    threads.reserve(chunkCount - 1);
+    for (qsizetype chunk = 1; chunk < chunkCount; ++chunk) {
+        qsizetype const begin = qMin(count, chunk * chunkSize);
+        qsizetype const end = qMin(count, begin + chunkSize);
+        threads.emplace_back(func, chunk, begin, end);
+    }
+    func(0, 0, qMin(count, chunkSize));
+    for (std::thread &thread: threads) {
+        thread.join();
+    }
+}
@@ -0,0 +1,18 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of parallel processing functions.
+
+
+#ifndef ANALOG_PARALLEL_H
+#define ANALOG_PARALLEL_H
+
+
+typedef std::function<void(qsizetype chunkIndex, qsizetype begin, qsizetype end)> ChunkFunction; ///< Type definition for chunk processing functions.
+
+
+qsizetype parallelChunkCount(qsizetype count, qsizetype minChunkSize); ///< Return the number of chunks used to process items in parallel.
+void parallelFor(qsizetype count, qsizetype minChunkSize, ChunkFunction const &func); ///< Process items in parallel, by chunks.
+
+
+#endif //ANALOG_PARALLEL_H
@@ -0,0 +1,472 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of parser verifier class.
+
+
+#include "ParserVerifier.h"
+#include "Exception.h"
+#include "Log.h"
+#include "LogStream.h"
+
+
+namespace {
+QString const mutationChars = "\"\\= \t[]x9é€\u00a0\u3000"; ///< The characters inserted by mutations, including non-ASCII whitespace.
+qsizetype constexpr maxMutationCount = 3; ///< The maximum number of mutations applied to a line.
+QChar constexpr doubleQuote('"'); ///< The double quote character.
+QChar constexpr backslash('\\'); ///< The backslash character.
+QChar constexpr equal('='); ///< The equal sign character.
+QChar constexpr space(' '); ///< The space character.
+}
+
+
+//****************************************************************************************************************************************************
+/// This is the reference tokenizer. It must not be modified when the tokenizer of LogEntry is.
+///
+/// \param[in] str The string.
+/// \return The keys, equal signs and values of the string.
+//****************************************************************************************************************************************************
+QStringList referenceTokenize(QString const &str) {
+    QStringList result;
+    if (str.isEmpty()) {
+        return result;
+    }
+    QChar prevChar(0);
+    bool inQuotes = false;
+    QString acc;
+    for (QChar c: str) {
+        if ((c == doubleQuote) && (prevChar != backslash)) {
+            if (!acc.isEmpty()) {
+                result.append(acc);
+                acc = QString();
+            }
+            inQuotes = !inQuotes;
+            prevChar = c;
+            continue;
+        }
+
+        if ((c == space) && (!inQuotes) && (acc.isEmpty()) && (!result.isEmpty()) && (result.back() == equal)) {
+            result.push_back(QString());
+            prevChar = c;
+            continue;
+        }
+
+        if ((c == equal) && (!inQuotes)) {
+            if (!acc.isEmpty()) {
+                result.push_back(acc);
+                acc = QString();
+            }
+            result.push_back(c);
+            prevChar = c;
+            continue;
+        }
+
+        if (c.isSpace() && !inQuotes) {
+            if (!acc.isEmpty()) {
+                result.append(acc);
+                acc = QString();
+            }
+            prevChar = c;
+            continue;
+        }
+
+        acc.append(c);
+        prevChar = c;
+    }
+
+    if (!acc.isEmpty()) {
+        result.append(acc);
+    }
+
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] str The string.
+/// \param[in] names The names of the levels, by increasing level.
+/// \return The level whose name matches the string case-insensitively.
+/// \return LogEntry::Level::Trace if no level matches.
+//****************************************************************************************************************************************************
+LogEntry::Level referenceLevel(QString const &str, std::array<char const *, LogEntry::levelCount> const &names) {
+    for (qsizetype i = 0; i < LogEntry::levelCount; ++i) {
+        if (str.compare(QLatin1StringView(names[i]), Qt::CaseInsensitive) == 0) {
+            return LogEntry::Level(i);
+        }
+    }
+    return LogEntry::Level::Trace;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] str The string.
+/// \param[out] entry The entry.
+//****************************************************************************************************************************************************
+void referenceParseBridgeGUI34Entry(QString const &str, ParserVerifier::ReferenceEntry &entry) {
+    QRegularExpression const rx(R"(^(?<level>PANI|FATA|ERRO|WARN|INFO|DEBU|TRAC)\[(?<time>.{19})]\s+(?<message>.*)$)");
+    QRegularExpressionMatch const match = rx.match(str);
+    if (!match.hasMatch()) {
+        entry.error = "Invalid log entry";
+        return;
+    }
+    entry.level = referenceLevel(match.captured("level"), { "TRAC", "DEBU", "INFO", "WARN", "ERRO", "FATA", "PANI" });
+    entry.time = match.captured("time");
+    entry.message = match.captured("message");
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] str The string.
+/// \param[out] entry The entry.
+//****************************************************************************************************************************************************
+void referenceParseBridge34Entry(QString const &str, ParserVerifier::ReferenceEntry &entry) {
+    try {
+        QStringList tokens = referenceTokenize(str);
+        qsizetype count = tokens.size();
+        if (count % 3 != 0) {
+            if ((count % 3 == 1) && (count > 10) && (tokens[9] == "message") && (tokens[10] == "updated")) {
+                tokens[9] = "message updated";
+                tokens.removeAt(10);
+                --count;
+            } else {
+                throw Exception("Invalid number of elements after tokenization.");
+            }
+        }
+        for (int i = 0; i < count; i += 3) {
+            QString const &expectedEqual = tokens[i + 1];
+            if (expectedEqual != equal) {
+                throw Exception(QString("expected equal sign but encountered '%1'")
+                    .arg(expectedEqual.size() < 10 ? expectedEqual : expectedEqual.left(10) + "..."));
+            }
+            QString const &key = tokens[i];
+            QString const &value = tokens[i + 2];
+            if (entry.fields.contains(key)) {
+                throw Exception(QString("Duplicate field \"%1\"").arg(key));
+            }
+            if (key == "time") {
+                entry.time = value;
+            } else if (key == "level") {
+                entry.level = referenceLevel(value, { "trace", "debug", "info", "warning", "error", "fatal", "panic" });
+            } else if ((key == "pkg") || (key == "service")) {
+                entry.package = value;
+            } else if (key == "msg") {
+                entry.message = value;
+            } else {
+                entry.fields[key] = value;
+            }
+        }
+    } catch (Exception const &e) {
+        QString const msg = e.message();
+        entry.error = msg.isEmpty() ? "Unknown error" : msg;
+        entry.fields.clear();
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \return true iff the entry is valid.
+//****************************************************************************************************************************************************
+bool ParserVerifier::ReferenceEntry::isValid() const {
+    return error.isEmpty();
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The fields as a string, in the format of LogEntry::fieldsString().
+//****************************************************************************************************************************************************
+QString ParserVerifier::ReferenceEntry::fieldsString() const {
+    QStringList result;
+    for (auto it = fields.begin(); it != fields.end(); ++it) {
+        result.append(QString(R"(%1=%2)").arg(it.key(), it.value()));
+    }
+    return result.join(" - ");
+}
+
+
+//****************************************************************************************************************************************************
+/// The reference implementation is a frozen copy of the original string-based parser of LogEntry, with its regular expression for bridge-gui
+/// entries. It is deliberately kept independent of LogEntry, so that changes to the parser of LogEntry can be verified against it.
+///
+/// \param[in] line The line.
+/// \param[in] format The log format.
+/// \return The entry.
+//****************************************************************************************************************************************************
+ParserVerifier::ReferenceEntry ParserVerifier::referenceEntry(QString const &line, LogEntry::Format format) {
+    ReferenceEntry result;
+    switch (format) {
+    case LogEntry::Format::BridgeGUI_3_4_0:
+        referenceParseBridgeGUI34Entry(line, result);
+        break;
+    case LogEntry::Format::Bridge_3_4_0:
+        referenceParseBridge34Entry(line, result);
+        break;
+    case LogEntry::Format::Unknown:
+        throw Exception("Failed parsing of log entry of unknown format.");
+    }
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// The reference implementation reads the file line by line, and parses each line with referenceEntry(). End-of-line characters are removed
+/// before parsing, as LogEntry does.
+///
+/// \param[in] filePath The path of the file.
+/// \param[out] lineNumbers The one-based line number of each valid entry.
+/// \return The valid entries of the file.
+//****************************************************************************************************************************************************
+QList<ParserVerifier::ReferenceEntry> referenceParse(QString const &filePath, QList<qsizetype> &lineNumbers) {
+    lineNumbers.clear();
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        throw Exception(QString("The file '%1' could not be opened.").arg(QDir::toNativeSeparators(filePath)));
+    }
+    QList<ParserVerifier::ReferenceEntry> result;
+    LogEntry::Format format = LogEntry::Format::Unknown;
+    qsizetype lineNumber = 0;
+    while (!file.atEnd()) {
+        QByteArray bytes = file.readLine();
+        while (bytes.endsWith('\n') || bytes.endsWith('\r')) {
+            bytes.chop(1);
+        }
+        QString const line = QString::fromUtf8(bytes);
+        ++lineNumber;
+        if (lineNumber == 1) {
+            format = Log::getLogFormat(line);
+            if (format == LogEntry::Format::Unknown) {
+                return result;
+            }
+        }
+        ParserVerifier::ReferenceEntry entry = ParserVerifier::referenceEntry(line, format);
+        if (entry.isValid()) {
+            result.append(std::move(entry));
+            lineNumbers.append(lineNumber);
+        }
+    }
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] filePath The path of the file.
+/// \param[in] lineNumber The one-based line number.
+/// \return The line, without its end-of-line characters.
+//****************************************************************************************************************************************************
+QString lineAt(QString const &filePath, qsizetype lineNumber) {
+    QFile file(filePath);
+    if ((lineNumber < 1) || (!file.open(QIODevice::ReadOnly | QIODevice::Text))) {
+        return QString();
+    }
+    QByteArray line;
+    for (qsizetype i = 0; (i < lineNumber) && (!file.atEnd()); ++i) {
+        line = file.readLine();
+    }
+    while (line.endsWith('\n') || line.endsWith('\r')) {
+        line.chop(1);
+    }
+    return QString::fromUtf8(line);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] name The name of the attribute.
+/// \param[in] expected The expected value.
+/// \param[in] actual The actual value.
+/// \return The description of the difference.
+//****************************************************************************************************************************************************
+QString describeDifference(QString const &name, QString const &expected, QString const &actual) {
+    return QString("%1 differs: expected '%2', got '%3'").arg(name, expected, actual);
+}
+
+
+//****************************************************************************************************************************************************
+/// \return A string describing the divergence.
+//****************************************************************************************************************************************************
+QString ParserVerifier::Divergence::toString() const {
+    QString result = QString("%1 diverges from the reference on '%2'").arg(implementation, QDir::toNativeSeparators(filePath));
+    if (lineNumber > 0) {
+        result += QString(" at line %1").arg(lineNumber);
+    }
+    result += QString(": %1").arg(description);
+    if (!line.isEmpty()) {
+        result += QString("\nLine: %1").arg(line);
+    }
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The alternative implementations.
+//****************************************************************************************************************************************************
+QList<ParserVerifier::Implementation> ParserVerifier::implementations() {
+    return {
+        {
+            "Log", [](QString const &filePath) -> QList<LogEntry> {
+                return Log(filePath).entries();
+            }
+        },
+        {
+            "LogStream", [](QString const &filePath) -> QList<LogEntry> {
+                QList<LogEntry> result;
+                QStringList errors;
+                std::atomic_bool const cancelled { false };
+                LogStream::readFile(filePath, [&result](LogEntry const &entry) {
+                    if (entry.isValid()) {
+                        result.append(entry);
+                    }
+                }, errors, cancelled);
+                return result;
+            }
+        },
+    };
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] expected The expected entry, parsed by the reference implementation.
+/// \param[in] actual The actual entry.
+/// \return A description of the first difference between the entries.
+/// \return An empty string if the entries are identical.
+//****************************************************************************************************************************************************
+QString ParserVerifier::compareEntries(ReferenceEntry const &expected, LogEntry const &actual) {
+    if (expected.isValid() != actual.isValid()) {
+        return describeDifference("validity", expected.isValid() ? "valid" : "invalid", actual.isValid() ? "valid" : "invalid");
+    }
+    if (expected.error != actual.error()) {
+        return describeDifference("error", expected.error, actual.error());
+    }
+    if (expected.time != actual.time()) {
+        return describeDifference("time", expected.time, actual.time());
+    }
+    if (expected.level != actual.level()) {
+        return describeDifference("level", LogEntry::levelToString(expected.level), LogEntry::levelToString(actual.level()));
+    }
+    if (expected.package != actual.package()) {
+        return describeDifference("package", expected.package, actual.package());
+    }
+    if (expected.message != actual.message()) {
+        return describeDifference("message", expected.message, actual.message());
+    }
+    if (expected.fields != actual.fields()) {
+        return describeDifference("fields", expected.fieldsString(), actual.fieldsString());
+    }
+    return QString();
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] filePath The path of the file.
+/// \return The first divergence between the reference implementation and an alternative implementation.
+/// \return std::nullopt if all implementations agree.
+//****************************************************************************************************************************************************
+std::optional<ParserVerifier::Divergence> ParserVerifier::verifyFile(QString const &filePath) {
+    QList<qsizetype> lineNumbers;
+    QList<ReferenceEntry> const expected = referenceParse(filePath, lineNumbers);
+    for (Implementation const &implementation: implementations()) {
+        QList<LogEntry> const actual = implementation.parse(filePath);
+        qsizetype const count = qMin(expected.count(), actual.count());
+        for (qsizetype i = 0; i < count; ++i) {
+            QString const difference = compareEntries(expected[i], actual[i]);
+            if (!difference.isEmpty()) {
+                return Divergence { implementation.name, filePath, lineNumbers[i], lineAt(filePath, lineNumbers[i]),
+                    QString("valid entry #%1: %2").arg(i + 1).arg(difference) };
+            }
+        }
+        if (expected.count() != actual.count()) {
+            qsizetype const lineNumber = (count < expected.count()) ? lineNumbers[count] : -1;
+            return Divergence { implementation.name, filePath, lineNumber, lineAt(filePath, lineNumber),
+                QString("expected %1 valid entries, got %2").arg(expected.count()).arg(actual.count()) };
+        }
+    }
+    return std::nullopt;
+}
+
+
+//****************************************************************************************************************************************************
+/// Seed lines are grouped by format. For each format, a file is written in the folder, starting with an unmodified seed line so the format
+/// is detected, followed by mutations of random seed lines. The files are then verified.
+///
+/// \param[in] seedLines The valid lines that are mutated.
+/// \param[in] lineCount The number of random lines per format.
+/// \param[in] seed The seed of the random generator.
+/// \param[in] dirPath The folder the files are written to.
+/// \return The first divergence between the reference implementation and an alternative implementation.
+/// \return std::nullopt if all implementations agree.
+//****************************************************************************************************************************************************
+std::optional<ParserVerifier::Divergence> ParserVerifier::verifyRandomLines(QStringList const &seedLines, qsizetype lineCount, quint32 seed,
+    QString const &dirPath) {
+    QMap<LogEntry::Format, QStringList> seedsByFormat;
+    for (QString const &line: seedLines) {
+        LogEntry::Format const format = Log::getLogFormat(line);
+        if (format != LogEntry::Format::Unknown) {
+            seedsByFormat[format].append(line);
+        }
+    }
+
+    QRandomGenerator rng(seed);
+    for (auto it = seedsByFormat.begin(); it != seedsByFormat.end(); ++it) {
+        QStringList const &seeds = it.value();
+        QString const filePath = QDir(dirPath).absoluteFilePath(QString("random_%1_%2.log").arg(qint32(it.key())).arg(seed));
+        QFile file(filePath);
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text)) {
+            throw Exception(QString("The file '%1' could not be created.").arg(QDir::toNativeSeparators(filePath)));
+        }
+        QByteArray content = seeds.front().toUtf8() + '\n';
+        for (qsizetype i = 0; i < lineCount; ++i) {
+            content += mutateLine(seeds[rng.bounded(qint32(seeds.count()))], rng).toUtf8() + '\n';
+        }
+        if (file.write(content) != content.size()) {
+            throw Exception(QString("Could not write to '%1'.").arg(QDir::toNativeSeparators(filePath)));
+        }
+        file.close();
+
+        std::optional<Divergence> const divergence = verifyFile(filePath);
+        if (divergence) {
+            return divergence;
+        }
+    }
+    return std::nullopt;
+}
+
+
+//****************************************************************************************************************************************************
+/// Mutations insert quotes, backslashes, equal signs, ASCII and non-ASCII spaces and other non-ASCII characters, delete, duplicate or swap
+/// characters, truncate the line, or insert a 'message updated' key, so that both the valid and the error paths of the parsers are
+/// exercised. The result never contains end-of-line characters.
+///
+/// \param[in] line The line.
+/// \param[in] rng The random generator.
+/// \return The mutated line.
+//****************************************************************************************************************************************************
+QString ParserVerifier::mutateLine(QString const &line, QRandomGenerator &rng) {
+    QString result = line;
+    qsizetype const mutationCount = rng.bounded(qint32(maxMutationCount + 1));
+    for (qsizetype i = 0; i < mutationCount; ++i) {
+        qsizetype const pos = rng.bounded(qint32(result.size() + 1));
+        switch (rng.bounded(6)) {
+        case 0:
+            result.insert(pos, mutationChars[rng.bounded(qint32(mutationChars.size()))]);
+            break;
+        case 1:
+            if (pos < result.size()) {
+                result.remove(pos, 1);
+            }
+            break;
+        case 2:
+            result.insert(pos, result.mid(pos, rng.bounded(16)));
+            break;
+        case 3:
+            result.truncate(pos);
+            break;
+        case 4:
+            if (pos + 1 < result.size()) {
+                std::swap(result[pos], result[pos + 1]);
+            }
+            break;
+        default:
+            result.insert(pos, " message updated=true");
+            break;
+        }
+    }
+    return result;
+}
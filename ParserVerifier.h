@@ -0,0 +1,64 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of parser verifier class.
+
+
+#ifndef ANALOG_PARSER_VERIFIER_H
+#define ANALOG_PARSER_VERIFIER_H
+
+
+#include "LogEntry.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Parser verifier class.
+///
+/// The verifier is a differential test harness: it parses log files with a reference implementation, and with every alternative
+/// implementation, then reports the first entry on which they diverge. The reference reads the file line by line, and parses each line with a
+/// frozen copy of the original string-based tokenizer and parsers, so it shares no parsing code with the LogEntry class.
+/// Entries are compared on all their attributes. Randomized lines, obtained by mutating valid lines, exercise the error cases of the parsers.
+//****************************************************************************************************************************************************
+class ParserVerifier {
+public: // data types
+    typedef std::function<QList<LogEntry>(QString const &filePath)> ParseFunction; ///< Type definition for parse functions, that return the valid entries of a file.
+
+    struct Implementation {
+        QString name; ///< The name of the implementation.
+        ParseFunction parse; ///< The parse function.
+    }; ///< Structure for parser implementations.
+
+    struct ReferenceEntry {
+        QString time; ///< The entry time.
+        LogEntry::Level level { LogEntry::Level::Trace }; ///< The entry level.
+        QString package; ///< The entry package.
+        QString message; ///< The entry message.
+        QMap<QString, QString> fields; ///< The other entry fields.
+        QString error; ///< The error that makes the line invalid.
+
+        bool isValid() const; ///< Return true iff the entry is valid.
+        QString fieldsString() const; ///< Return the fields as a string.
+    }; ///< Structure for the entries parsed by the reference implementation.
+
+    struct Divergence {
+        QString implementation; ///< The name of the implementation.
+        QString filePath; ///< The path of the file.
+        qsizetype lineNumber { -1 }; ///< The line number of the entry in the file, or -1 if unknown.
+        QString line; ///< The line of the entry, if known.
+        QString description; ///< The description of the divergence.
+
+        QString toString() const; ///< Return a string describing the divergence.
+    }; ///< Structure for divergences.
+
+public: // static member functions.
+    static QList<Implementation> implementations(); ///< Return the alternative implementations.
+    static ReferenceEntry referenceEntry(QString const &line, LogEntry::Format format); ///< Parse a line with the reference implementation.
+    static QString compareEntries(ReferenceEntry const &expected, LogEntry const &actual); ///< Compare a reference entry with an entry.
+    static std::optional<Divergence> verifyFile(QString const &filePath); ///< Verify all implementations on a file.
+    static std::optional<Divergence> verifyRandomLines(QStringList const &seedLines, qsizetype lineCount, quint32 seed,
+        QString const &dirPath); ///< Verify all implementations on randomized lines.
+    static QString mutateLine(QString const &line, QRandomGenerator &rng); ///< Return a random mutation of a line.
+};
+
+
+#endif //ANALOG_PARSER_VERIFIER_H
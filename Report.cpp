@@ -14,6 +14,7 @@ QString const dateTimeFormat(dateFormat + " " + timeFormat);
 qint64 constexpr secondsPerMinute = 60;
 qint64 constexpr secondsPerHour = secondsPerMinute * 60;
 qint64 constexpr secondsPerDay = secondsPerHour * 24;
+qsizetype constexpr maxListedPeakMinutes = 10; ///< The maximum number of minutes listed in the error peaks.
 }
 
 
@@ -53,16 +54,64 @@ QString durationToString(qint64 durationSecs) {
 }
 
 
+//****************************************************************************************************************************************************
+/// \param[in] title The title of the section.
+/// \param[in] counts The counts.
+/// \return A report section listing the counts.
+//****************************************************************************************************************************************************
+QString countListToString(QString const &title, Report::CountList const &counts) {
+    QString result = QString("\n\n## %1\n").arg(title);
+    if (counts.isEmpty()) {
+        return result + "None";
+    }
+    QStringList lines;
+    for (auto const &[name, count]: counts) {
+        lines.append(QString("%1: %2").arg(name.isEmpty() ? "<none>" : name).arg(count));
+    }
+    return result + lines.join("\n");
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The number of entries whose level is error or higher.
+//****************************************************************************************************************************************************
+qsizetype Report::errorCount() const {
+    return std::accumulate(levelCounts.begin() + qsizetype(LogEntry::Level::Error), levelCounts.end(), qsizetype(0));
+}
+
+
 //****************************************************************************************************************************************************
 /// \return The report as a human readable string
 //****************************************************************************************************************************************************
 QString Report::toString() const {
     QString result = "## Time\n";
-    result += QString("Start: %1\nEnd: %2\nDuration: %3").arg(
+    result += QString("Start: %1\nEnd: %2\nDuration: %3\nFirst error: %4").arg(
         startDate.toString(dateTimeFormat),
         endDate.toString(dateTimeFormat),
-        durationToString(startDate.secsTo(endDate))
+        durationToString(startDate.secsTo(endDate)),
+        firstErrorDate.isValid() ? firstErrorDate.toString(dateTimeFormat) : "None"
     );
 
+    result += QString("\n\n## Levels\nEntries: %1").arg(entryCount);
+    for (qsizetype level = 0; level < LogEntry::levelCount; ++level) {
+        result += QString("\n%1: %2").arg(LogEntry::levelToString(LogEntry::Level(level))).arg(levelCounts[level]);
+    }
+
+    result += countListToString("Packages", packageCounts);
+    result += countListToString("Field keys", fieldKeyCounts);
+
+    result += QString("\n\n## Errors per minute\nErrors: %1\nMinutes with errors: %2").arg(errorCount()).arg(errorsPerMinute.size());
+    QList<std::pair<qint64, qsizetype>> peaks = errorsPerMinute;
+    std::ranges::stable_sort(peaks, [](auto const &lhs, auto const &rhs) -> bool { return lhs.second > rhs.second; });
+    peaks.resize(qMin(peaks.size(), maxListedPeakMinutes));
+    for (auto const &[minute, count]: peaks) {
+        result += QString("\n%1: %2").arg(LogEntry::timestampToDateTime(minute).toString(dateFormat + " hh:mm")).arg(count);
+    }
+
+    result += countListToString("Top messages", topMessages);
+
+    result += "\n\n## Anomalies\n";
+    result += anomalies.isEmpty() ? "None" : anomalies.join("\n");
+
     return result;
 }
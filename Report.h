@@ -8,15 +8,32 @@
 #define ANALOG_REPORT_H
 
 
+#include "LogEntry.h"
+
+
 //****************************************************************************************************************************************************
 /// \brief Report structure.
 //****************************************************************************************************************************************************
 struct Report {
-    QDateTime startDate;
-    QDateTime endDate;
+    typedef QList<std::pair<QString, qsizetype>> CountList; ///< Type definition for lists of counts, in descending count order.
+
+    QDateTime startDate; ///< The date/time of the first entry.
+    QDateTime endDate; ///< The date/time of the last entry.
+    qsizetype entryCount { 0 }; ///< The number of entries.
+    std::array<qsizetype, LogEntry::levelCount> levelCounts {}; ///< The number of entries for each level.
+    CountList packageCounts; ///< The number of entries for each package.
+    CountList fieldKeyCounts; ///< The number of entries for each field key.
+    QList<std::pair<qint64, qsizetype>> errorsPerMinute; ///< The number of errors for each minute containing errors, in chronological order.
+    CountList topMessages; ///< The most frequent message templates.
+    QDateTime firstErrorDate; ///< The date/time of the first error, invalid if the log contains no error.
+    QStringList anomalies; ///< The description of the bursts and anomalies detected in the log, in chronological order.
 
-    QString toString() const;
+    qsizetype errorCount() const; ///< Return the number of entries whose level is error or higher.
+    QString toString() const; ///< Return the report as a human readable string.
 };
 
 
+QString durationToString(qint64 durationSecs); ///< Return a string describing a duration.
+
+
 #endif //ANALOG_REPORT_H
@@ -5,6 +5,8 @@
 
 
 #include "ReportDialog.h"
+#include "BufferedWriter.h"
+#include "Exception.h"
 
 
 //****************************************************************************************************************************************************
@@ -25,5 +27,16 @@ ReportDialog::ReportDialog(QWidget *parent, Report const &report)
 //
 //****************************************************************************************************************************************************
 void ReportDialog::onSave() {
-    QMessageBox::critical(this, "Error", "Not yet implemented.");
+    QString const path = QFileDialog::getSaveFileName(this, tr("Save Report"), QString(), tr("Markdown files (*.md);;Text files (*.txt)"));
+    if (path.isEmpty()) {
+        return;
+    }
+    try {
+        BufferedWriter writer(path);
+        writer.append(report_.toString());
+        writer.append('\n');
+        writer.close();
+    } catch (Exception const &e) {
+        QMessageBox::critical(this, tr("Error"), e.message());
+    }
 }
@@ -0,0 +1,176 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of report engine class.
+
+
+#include "ReportEngine.h"
+#include "Parallel.h"
+#include "Exception.h"
+
+
+namespace {
+
+
+qint64 constexpr msecsPerMinute = 60 * 1000; ///< The number of milliseconds in a minute.
+
+
+//****************************************************************************************************************************************************
+/// \brief The statistics computed by a thread on a chunk of entries.
+//****************************************************************************************************************************************************
+struct PartialReport {
+    std::array<qsizetype, LogEntry::levelCount> levelCounts {}; ///< The number of entries for each level.
+    QList<qsizetype> packageCounts; ///< The number of entries for each package of the package dictionary.
+    QList<qsizetype> templateCounts; ///< The number of entries for each message template.
+    QHash<QByteArray, qsizetype> fieldKeyCounts; ///< The number of entries for each UTF-8 field key.
+    QHash<qint64, qsizetype> errorsPerMinute; ///< The number of errors for each minute, by minute index.
+    qsizetype firstErrorRow { -1 }; ///< The first row containing an error, or -1 if the chunk contains no error.
+};
+
+
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] counts The counts.
+/// \return The list of counts, sorted by descending count, then ascending name.
+//****************************************************************************************************************************************************
+template <typename Iterable>
+Report::CountList sortedCounts(Iterable const &counts) {
+    Report::CountList result;
+    result.reserve(counts.size());
+    for (auto it = counts.begin(); it != counts.end(); ++it) {
+        result.append({ it.key(), it.value() });
+    }
+    std::ranges::sort(result, [](auto const &lhs, auto const &rhs) -> bool {
+        return (lhs.second != rhs.second) ? (lhs.second > rhs.second) : (lhs.first < rhs.first);
+    });
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] log The log.
+/// \param[in] begin The first row of the chunk.
+/// \param[in] end The row after the last row of the chunk.
+/// \param[out] partial The partial report to fill.
+//****************************************************************************************************************************************************
+void processChunk(Log const &log, qsizetype begin, qsizetype end, PartialReport &partial) {
+    partial.packageCounts.fill(0, log.packages_.size());
+    partial.templateCounts.fill(0, log.templateMiner_.templates().size());
+    bool const hasTemplates = log.templateIds_.size() == log.entries_.size();
+    for (qsizetype row = begin; row < end; ++row) {
+        LogEntry const &entry = log.entries_[row];
+        qsizetype const level = qsizetype(entry.level());
+        ++partial.levelCounts[level];
+        ++partial.packageCounts[log.packageIds_[row]];
+        if (hasTemplates) {
+            ++partial.templateCounts[log.templateIds_[row]];
+        }
+
+        for (qsizetype i = 0; i < entry.fieldCount(); ++i) {
+            QUtf8StringView const key = entry.fieldKeyUtf8(i);
+            auto it = partial.fieldKeyCounts.find(QByteArray::fromRawData(key.data(), key.size())); // no copy is made for the lookup.
+            if (it == partial.fieldKeyCounts.end()) {
+                it = partial.fieldKeyCounts.insert(QByteArray(key.data(), key.size()), 0);
+            }
+            ++it.value();
+        }
+
+        if (level < qsizetype(LogEntry::Level::Error)) {
+            continue;
+        }
+        if (partial.firstErrorRow < 0) {
+            partial.firstErrorRow = row;
+        }
+        ++partial.errorsPerMinute[log.timestamps_[row] / msecsPerMinute];
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] log The log.
+/// \return The report for the log.
+//****************************************************************************************************************************************************
+Report ReportEngine::generate(Log const &log) {
+    if (log.entries_.isEmpty()) {
+        throw Exception("Empty log");
+    }
+
+    qsizetype const count = log.entries_.size();
+    QList<PartialReport> partials(parallelChunkCount(count, minChunkSize));
+    parallelFor(count, minChunkSize, [&](qsizetype chunk, qsizetype begin, qsizetype end) {
+        processChunk(log, begin, end, partials[chunk]);
+    });
+
+    // Merge the partial reports. Chunks are contiguous and in row order, so the first error is the first one found.
+    PartialReport &total = partials.front();
+    for (qsizetype i = 1; i < partials.size(); ++i) {
+        PartialReport const &partial = partials[i];
+        for (qsizetype level = 0; level < LogEntry::levelCount; ++level) {
+            total.levelCounts[level] += partial.levelCounts[level];
+        }
+        for (qsizetype id = 0; id < total.packageCounts.size(); ++id) {
+            total.packageCounts[id] += partial.packageCounts[id];
+        }
+        for (qsizetype id = 0; id < total.templateCounts.size(); ++id) {
+            total.templateCounts[id] += partial.templateCounts[id];
+        }
+        for (auto it = partial.fieldKeyCounts.begin(); it != partial.fieldKeyCounts.end(); ++it) {
+            total.fieldKeyCounts[it.key()] += it.value();
+        }
+        for (auto it = partial.errorsPerMinute.begin(); it != partial.errorsPerMinute.end(); ++it) {
+            total.errorsPerMinute[it.key()] += it.value();
+        }
+        if ((total.firstErrorRow < 0) && (partial.firstErrorRow >= 0)) {
+            total.firstErrorRow = partial.firstErrorRow;
+        }
+    }
+
+    Report report;
+    report.startDate = LogEntry::timestampToDateTime(log.startTimestamp());
+    report.endDate = LogEntry::timestampToDateTime(log.endTimestamp());
+    report.entryCount = count;
+    report.levelCounts = total.levelCounts;
+    QHash<QString, qsizetype> fieldKeyCounts;
+    for (auto it = total.fieldKeyCounts.begin(); it != total.fieldKeyCounts.end(); ++it) {
+        fieldKeyCounts.insert(QString::fromUtf8(it.key()), it.value());
+    }
+    report.fieldKeyCounts = sortedCounts(fieldKeyCounts);
+
+    QHash<QString, qsizetype> packageCounts;
+    for (qsizetype id = 0; id < total.packageCounts.size(); ++id) {
+        packageCounts.insert(log.packages_[id], total.packageCounts[id]);
+    }
+    report.packageCounts = sortedCounts(packageCounts);
+
+    QList<qsizetype> templateIds(total.templateCounts.size());
+    std::iota(templateIds.begin(), templateIds.end(), 0);
+    qsizetype const topCount = qMin(topMessageCount, templateIds.size());
+    std::partial_sort(templateIds.begin(), templateIds.begin() + topCount, templateIds.end(), [&](qsizetype lhs, qsizetype rhs) -> bool {
+        return total.templateCounts[lhs] > total.templateCounts[rhs];
+    });
+    QList<TemplateMiner::Template> const &templates = log.templateMiner_.templates();
+    for (qsizetype i = 0; i < topCount; ++i) {
+        qsizetype const id = templateIds[i];
+        if (total.templateCounts[id] > 0) {
+            report.topMessages.append({ templates[id].text(), total.templateCounts[id] });
+        }
+    }
+
+    report.errorsPerMinute.reserve(total.errorsPerMinute.size());
+    for (auto it = total.errorsPerMinute.begin(); it != total.errorsPerMinute.end(); ++it) {
+        report.errorsPerMinute.append({ it.key() * msecsPerMinute, it.value() });
+    }
+    std::ranges::sort(report.errorsPerMinute);
+
+    if (total.firstErrorRow >= 0) {
+        report.firstErrorDate = LogEntry::timestampToDateTime(log.timestamps_[total.firstErrorRow]);
+    }
+
+    for (BurstDetector::Anomaly const &anomaly: log.anomalies_) {
+        report.anomalies.append(anomaly.toString());
+    }
+
+    return report;
+}
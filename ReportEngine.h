@@ -0,0 +1,30 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of report engine class.
+
+
+#ifndef ANALOG_REPORT_ENGINE_H
+#define ANALOG_REPORT_ENGINE_H
+
+
+#include "Log.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Report engine class.
+///
+/// The engine computes the statistics of a log in a single pass over the entries. The entries are split in contiguous chunks processed in
+/// parallel, each thread filling its own partial aggregate. The partial aggregates are then merged into the report.
+//****************************************************************************************************************************************************
+class ReportEngine {
+public: // static members
+    static qsizetype constexpr topMessageCount = 20; ///< The number of messages listed in the top messages.
+    static qsizetype constexpr minChunkSize = 65536; ///< The minimum number of entries processed by a thread.
+
+public: // static member functions.
+    static Report generate(Log const &log); ///< Generate the report for a log.
+};
+
+
+#endif //ANALOG_REPORT_ENGINE_H
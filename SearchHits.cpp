@@ -0,0 +1,169 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of search hit list class.
+
+
+#include "SearchHits.h"
+
+
+namespace {
+qsizetype constexpr chunkSize = 16384; ///< The number of rows scanned between two publications of hits.
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+SearchHits::~SearchHits() {
+    this->cancel();
+}
+
+
+//****************************************************************************************************************************************************
+/// Any search in progress is cancelled.
+///
+/// \param[in] log The log.
+/// \param[in] text The text to search for.
+//****************************************************************************************************************************************************
+void SearchHits::start(SPLog const &log, QString const &text) {
+    this->cancel();
+    text_ = text;
+    if ((!log) || text.isEmpty()) {
+        emit hitsChanged();
+        emit finished();
+        return;
+    }
+
+    running_ = true;
+    quint64 const generation = generation_;
+    cancelled_ = std::make_shared<std::atomic_bool>(false);
+    thread_ = std::thread([this, log, query = LogEntry::TextQuery(text), generation, cancelled = cancelled_]() {
+        QList<LogEntry> const &entries = log->entries();
+        QList<qint32> chunkHits;
+        for (qsizetype chunkStart = 0; chunkStart < entries.count(); chunkStart += chunkSize) {
+            if (*cancelled) {
+                return;
+            }
+            qsizetype const chunkEnd = qMin(chunkStart + chunkSize, entries.count());
+            for (qsizetype row = chunkStart; row < chunkEnd; ++row) {
+                if (entries[row].containsText(query)) {
+                    chunkHits.append(qint32(row));
+                }
+            }
+            if (!chunkHits.isEmpty()) {
+                QMetaObject::invokeMethod(this, [this, generation, chunkHits]() { this->appendHits(generation, chunkHits, false); },
+                    Qt::QueuedConnection);
+                chunkHits.clear();
+            }
+        }
+        QMetaObject::invokeMethod(this, [this, generation]() { this->appendHits(generation, {}, true); }, Qt::QueuedConnection);
+    });
+}
+
+
+//****************************************************************************************************************************************************
+/// The worker thread checks for cancellation between chunks, so this function returns quickly.
+//****************************************************************************************************************************************************
+void SearchHits::cancel() {
+    if (cancelled_) {
+        *cancelled_ = true;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    ++generation_;
+    running_ = false;
+    hits_.clear();
+    text_.clear();
+}
+
+
+//****************************************************************************************************************************************************
+/// \return true iff a search is in progress.
+//****************************************************************************************************************************************************
+bool SearchHits::isRunning() const {
+    return running_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The searched text.
+//****************************************************************************************************************************************************
+QString SearchHits::text() const {
+    return text_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The number of hits found so far.
+//****************************************************************************************************************************************************
+qsizetype SearchHits::count() const {
+    return hits_.count();
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The sorted list of hits.
+//****************************************************************************************************************************************************
+QList<qint32> const &SearchHits::hits() const {
+    return hits_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] sourceRow The source row.
+/// \return The index of the source row in the hit list.
+/// \return -1 if the source row is not a hit.
+//****************************************************************************************************************************************************
+qsizetype SearchHits::indexOf(qint32 sourceRow) const {
+    auto const it = std::lower_bound(hits_.begin(), hits_.end(), sourceRow);
+    return ((it != hits_.end()) && (*it == sourceRow)) ? it - hits_.begin() : -1;
+}
+
+
+//****************************************************************************************************************************************************
+/// The search is O(log n).
+///
+/// \param[in] sourceRow The source row. Use -1 to get the first hit.
+/// \return The first hit strictly after sourceRow, if any.
+//****************************************************************************************************************************************************
+std::optional<qint32> SearchHits::next(qint32 sourceRow) const {
+    auto const it = std::upper_bound(hits_.begin(), hits_.end(), sourceRow);
+    return (it == hits_.end()) ? std::optional<qint32> {} : *it;
+}
+
+
+//****************************************************************************************************************************************************
+/// The search is O(log n).
+///
+/// \param[in] sourceRow The source row. Use a value past the last row to get the last hit.
+/// \return The last hit strictly before sourceRow, if any.
+//****************************************************************************************************************************************************
+std::optional<qint32> SearchHits::previous(qint32 sourceRow) const {
+    auto const it = std::lower_bound(hits_.begin(), hits_.end(), sourceRow);
+    return (it == hits_.begin()) ? std::optional<qint32> {} : *(it - 1);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] generation The generation of the search that found the hits.
+/// \param[in] hits The hits.
+/// \param[in] done Is the search complete.
+//****************************************************************************************************************************************************
+void SearchHits::appendHits(quint64 generation, QList<qint32> const &hits, bool done) {
+    if (generation != generation_) {
+        return;
+    }
+    hits_.append(hits);
+    if (done) {
+        running_ = false;
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+    emit hitsChanged();
+    if (done) {
+        emit finished();
+    }
+}
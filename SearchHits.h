@@ -0,0 +1,58 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of search hit list class.
+
+
+#ifndef ANALOG_SEARCH_HITS_H
+#define ANALOG_SEARCH_HITS_H
+
+
+#include "Log.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Search hit list class.
+///
+/// The list of source rows matching a text is computed on a background thread. Hits are published in chunks while the scan progresses, so the
+/// first hits can be navigated before the scan finishes. Rows are scanned in order, so the list is always sorted.
+//****************************************************************************************************************************************************
+class SearchHits : public QObject {
+    Q_OBJECT
+
+public: // member functions.
+    SearchHits() = default; ///< Default constructor.
+    SearchHits(SearchHits const &) = delete; ///< Disabled copy-constructor.
+    SearchHits(SearchHits &&) = delete; ///< Disabled assignment copy-constructor.
+    ~SearchHits() override; ///< Destructor.
+    SearchHits& operator=(SearchHits const &) = delete; ///< Disabled assignment operator.
+    SearchHits& operator=(SearchHits &&) = delete; ///< Disabled move assignment operator.
+
+    void start(SPLog const &log, QString const &text); ///< Start a search.
+    void cancel(); ///< Cancel the current search and clear the hits.
+    bool isRunning() const; ///< Check if a search is in progress.
+    QString text() const; ///< Return the searched text.
+    qsizetype count() const; ///< Return the number of hits found so far.
+    QList<qint32> const &hits() const; ///< Return the sorted list of source rows matching the search.
+    qsizetype indexOf(qint32 sourceRow) const; ///< Return the index of a hit.
+    std::optional<qint32> next(qint32 sourceRow) const; ///< Return the first hit after a source row.
+    std::optional<qint32> previous(qint32 sourceRow) const; ///< Return the last hit before a source row.
+
+signals:
+    void hitsChanged(); ///< Signal emitted when new hits are available.
+    void finished(); ///< Signal emitted when the search is complete.
+
+private: // member functions.
+    void appendHits(quint64 generation, QList<qint32> const &hits, bool done); ///< Append hits published by the worker thread.
+
+private: // data members.
+    std::thread thread_; ///< The worker thread.
+    std::shared_ptr<std::atomic_bool> cancelled_; ///< The cancellation flag of the current search.
+    quint64 generation_ { 0 }; ///< The generation of the current search, used to discard results of cancelled searches.
+    QString text_; ///< The searched text.
+    QList<qint32> hits_; ///< The sorted source rows matching the search.
+    bool running_ { false }; ///< Is a search in progress.
+};
+
+
+#endif //ANALOG_SEARCH_HITS_H
@@ -7,6 +7,7 @@
 #include "Session.h"
 #include "Exception.h"
 #include "FilenameInfo.h"
+#include "LogCache.h"
 
 
 //****************************************************************************************************************************************************
@@ -107,7 +108,7 @@ bool Session::hasLauncherLog() const {
 /// \return A null pointer if the session has no bridge log.
 //****************************************************************************************************************************************************
 SPLog Session::bridgeLog() const {
-    return hasBridgeLog() ? std::make_shared<Log>(this->bridgeFilePaths()) : SPLog {};
+    return hasBridgeLog() ? LogCache::log(this->bridgeFilePaths()) : SPLog {};
 }
 
 
@@ -116,7 +117,7 @@ SPLog Session::bridgeLog() const {
 /// \return A null pointer if the session has no brige-gui log.
 //****************************************************************************************************************************************************
 SPLog Session::guiLog() const {
-    return hasGUILog() ? std::make_shared<Log>(this->guiFilePaths()) : SPLog {};
+    return hasGUILog() ? LogCache::log(this->guiFilePaths()) : SPLog {};
 }
 
 
@@ -125,7 +126,7 @@ SPLog Session::guiLog() const {
 /// \return A null pointer if the session has no launcher log.
 //****************************************************************************************************************************************************
 SPLog Session::launcherLog() const {
-    return hasLauncherLog() ? std::make_shared<Log>(this->launcherFilePaths()) : SPLog {};
+    return hasLauncherLog() ? LogCache::log(this->launcherFilePaths()) : SPLog {};
 }
 
 
@@ -165,3 +166,14 @@ QStringList Session::guiFilePaths() const {
 QStringList Session::launcherFilePaths() const {
     return fullPaths(dir_, launcherFiles_);
 }
+
+
+//****************************************************************************************************************************************************
+/// The logs of the session are not included, as they are owned by the log cache.
+///
+/// \return The estimated heap size of the session, in bytes.
+//****************************************************************************************************************************************************
+qint64 Session::byteCount() const {
+    return MemoryUsage::stringByteCount(sessionID_) + MemoryUsage::stringListByteCount(bridgeFiles_)
+        + MemoryUsage::stringListByteCount(guiFiles_) + MemoryUsage::stringListByteCount(launcherFiles_);
+}
@@ -32,6 +32,7 @@ public: // member functions.
     QStringList bridgeFilePaths() const; ///< Return the full paths of the bridge log files
     QStringList guiFilePaths() const; ///< Return the full paths of the bridge-gui log files
     QStringList launcherFilePaths() const; ///< Return the full paths of the launcher log files
+    qint64 byteCount() const; ///< Return the estimated heap size of the session.
 
 private: // data members.
     QDir dir_; ///< The folder containing the session.
@@ -0,0 +1,170 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of cross-session analysis class.
+
+
+#include "SessionAnalysis.h"
+#include "LogStream.h"
+
+
+//****************************************************************************************************************************************************
+/// \return The duration of the session in seconds.
+/// \return -1 if the session contains no valid timestamp.
+//****************************************************************************************************************************************************
+qint64 SessionAnalysis::Summary::durationSecs() const {
+    if ((startTimestamp < 0) || (endTimestamp < 0)) {
+        return -1;
+    }
+    return (endTimestamp - startTimestamp) / 1000;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] session The session.
+/// \param[in] query The text searched in the entries. If empty, no entry is matched.
+/// \param[in] cancelled The cancellation flag.
+/// \return The summary of the session.
+//****************************************************************************************************************************************************
+SessionAnalysis::Summary SessionAnalysis::analyzeSession(Session const &session, QString const &query, std::atomic_bool const &cancelled) {
+    Summary summary;
+    summary.sessionID = session.sessionID();
+    LogEntry::TextQuery const textQuery(query);
+    LogStream::readSession(session, [&summary, &textQuery](LogEntry const &entry) {
+        if (!entry.isValid()) {
+            ++summary.invalidLineCount;
+            return;
+        }
+        ++summary.entryCount;
+        ++summary.levelCounts[qsizetype(entry.level())];
+        qint64 const ts = entry.timestamp();
+        if (ts >= 0) {
+            summary.startTimestamp = (summary.startTimestamp < 0) ? ts : qMin(summary.startTimestamp, ts);
+            summary.endTimestamp = qMax(summary.endTimestamp, ts);
+        }
+        if ((!textQuery.text.isEmpty()) && entry.containsText(textQuery)) {
+            ++summary.matchCount;
+        }
+    }, summary.errors, cancelled);
+    summary.isComplete = !cancelled;
+    return summary;
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+SessionAnalysis::~SessionAnalysis() {
+    this->cancel();
+}
+
+
+//****************************************************************************************************************************************************
+/// Any analysis in progress is cancelled.
+///
+/// \param[in] sessions The sessions.
+/// \param[in] query The text searched in the entries. If empty, no entry is matched.
+//****************************************************************************************************************************************************
+void SessionAnalysis::start(QList<Session> const &sessions, QString const &query) {
+    this->cancel();
+    query_ = query;
+    completedCount_ = 0;
+    summaries_.clear();
+    summaries_.reserve(sessions.count());
+    for (Session const &session: sessions) {
+        summaries_.append(Summary { .sessionID = session.sessionID() });
+    }
+    if (sessions.isEmpty()) {
+        emit finished();
+        return;
+    }
+
+    quint64 const generation = generation_;
+    cancelled_ = std::make_shared<std::atomic_bool>(false);
+    auto const nextIndex = std::make_shared<std::atomic<qsizetype>>(0);
+    qsizetype const threadCount = qBound(qsizetype(1), qsizetype(std::thread::hardware_concurrency()), sessions.count());
+    for (qsizetype i = 0; i < threadCount; ++i) {
+        threads_.emplace_back([this, sessions, query, generation, nextIndex, cancelled = cancelled_]() {
+            while (!*cancelled) {
+                qsizetype const index = (*nextIndex)++;
+                if (index >= sessions.count()) {
+                    return;
+                }
+                Summary const summary = analyzeSession(sessions[index], query, *cancelled);
+                if (*cancelled) {
+                    return;
+                }
+                QMetaObject::invokeMethod(this, [this, generation, index, summary]() { this->setSummary(generation, index, summary); },
+                    Qt::QueuedConnection);
+            }
+        });
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// The summaries of the sessions that were already analyzed are kept. The worker threads check for cancellation regularly, so this function
+/// returns quickly.
+//****************************************************************************************************************************************************
+void SessionAnalysis::cancel() {
+    if (cancelled_) {
+        *cancelled_ = true;
+    }
+    for (std::thread &thread: threads_) {
+        if (thread.joinable()) {
+            thread.join();
+        }
+    }
+    threads_.clear();
+    ++generation_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return true iff an analysis is in progress.
+//****************************************************************************************************************************************************
+bool SessionAnalysis::isRunning() const {
+    return (!threads_.empty()) && (completedCount_ < summaries_.count());
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The query of the analysis.
+//****************************************************************************************************************************************************
+QString SessionAnalysis::query() const {
+    return query_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The session summaries, in the order of the session list. Summaries of sessions not yet analyzed are incomplete.
+//****************************************************************************************************************************************************
+QList<SessionAnalysis::Summary> const &SessionAnalysis::summaries() const {
+    return summaries_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The number of sessions analyzed so far.
+//****************************************************************************************************************************************************
+qsizetype SessionAnalysis::completedCount() const {
+    return completedCount_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] generation The generation of the analysis that produced the summary.
+/// \param[in] index The index of the session.
+/// \param[in] summary The summary.
+//****************************************************************************************************************************************************
+void SessionAnalysis::setSummary(quint64 generation, qsizetype index, Summary const &summary) {
+    if ((generation != generation_) || (index >= summaries_.count())) {
+        return;
+    }
+    summaries_[index] = summary;
+    ++completedCount_;
+    emit sessionAnalyzed(index);
+    if (completedCount_ == summaries_.count()) {
+        emit finished();
+    }
+}
@@ -0,0 +1,74 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of cross-session analysis class.
+
+
+#ifndef ANALOG_SESSION_ANALYSIS_H
+#define ANALOG_SESSION_ANALYSIS_H
+
+
+#include "Session.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Cross-session analysis class.
+///
+/// The analysis computes a summary of each session of a list. Sessions are processed in parallel by a pool of worker threads that pick the next
+/// session to analyze from a shared counter. Log files are streamed line by line: each entry is folded into the summary of its session and then
+/// discarded, so the memory used does not depend on the size of the logs. Summaries are published as soon as a session is complete.
+//****************************************************************************************************************************************************
+class SessionAnalysis : public QObject {
+    Q_OBJECT
+
+public: // data types
+    struct Summary {
+        QString sessionID; ///< The session ID.
+        bool isComplete { false }; ///< Has the session been analyzed.
+        qsizetype entryCount { 0 }; ///< The number of valid entries.
+        qsizetype invalidLineCount { 0 }; ///< The number of lines that could not be parsed.
+        std::array<qsizetype, LogEntry::levelCount> levelCounts {}; ///< The number of entries for each level.
+        qint64 startTimestamp { LogEntry::invalidTimestamp }; ///< The smallest timestamp in the session.
+        qint64 endTimestamp { LogEntry::invalidTimestamp }; ///< The largest timestamp in the session.
+        qsizetype matchCount { 0 }; ///< The number of entries matching the query.
+        QStringList errors; ///< The errors encountered while reading the session.
+
+        qint64 durationSecs() const; ///< Return the duration of the session in seconds.
+    }; ///< Structure for session summaries.
+
+public: // static member functions.
+    static Summary analyzeSession(Session const &session, QString const &query, std::atomic_bool const &cancelled); ///< Analyze a session.
+
+public: // member functions.
+    SessionAnalysis() = default; ///< Default constructor.
+    SessionAnalysis(SessionAnalysis const &) = delete; ///< Disabled copy-constructor.
+    SessionAnalysis(SessionAnalysis &&) = delete; ///< Disabled assignment copy-constructor.
+    ~SessionAnalysis() override; ///< Destructor.
+    SessionAnalysis& operator=(SessionAnalysis const &) = delete; ///< Disabled assignment operator.
+    SessionAnalysis& operator=(SessionAnalysis &&) = delete; ///< Disabled move assignment operator.
+
+    void start(QList<Session> const &sessions, QString const &query); ///< Start an analysis.
+    void cancel(); ///< Cancel the current analysis.
+    bool isRunning() const; ///< Check if an analysis is in progress.
+    QString query() const; ///< Return the query of the analysis.
+    QList<Summary> const &summaries() const; ///< Return the session summaries.
+    qsizetype completedCount() const; ///< Return the number of sessions analyzed so far.
+
+signals:
+    void sessionAnalyzed(qsizetype index); ///< Signal emitted when the analysis of a session is complete.
+    void finished(); ///< Signal emitted when the analysis is complete.
+
+private: // member functions.
+    void setSummary(quint64 generation, qsizetype index, Summary const &summary); ///< Store a summary published by a worker thread.
+
+private: // data members.
+    std::vector<std::thread> threads_; ///< The worker threads.
+    std::shared_ptr<std::atomic_bool> cancelled_; ///< The cancellation flag of the current analysis.
+    quint64 generation_ { 0 }; ///< The generation of the current analysis, used to discard results of cancelled analyses.
+    QString query_; ///< The query.
+    QList<Summary> summaries_; ///< The session summaries.
+    qsizetype completedCount_ { 0 }; ///< The number of sessions analyzed so far.
+};
+
+
+#endif //ANALOG_SESSION_ANALYSIS_H
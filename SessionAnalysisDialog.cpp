@@ -0,0 +1,146 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of cross-session analysis dialog class.
+
+
+#include "SessionAnalysisDialog.h"
+#include "Report.h"
+
+
+namespace {
+
+
+int constexpr sessionColumn = 0; ///< The index of the session column.
+int constexpr entriesColumn = 1; ///< The index of the entry count column.
+int constexpr firstLevelColumn = 2; ///< The index of the column of the first level.
+int constexpr durationColumn = firstLevelColumn + LogEntry::levelCount; ///< The index of the duration column.
+int constexpr matchesColumn = durationColumn + 1; ///< The index of the match count column.
+int constexpr invalidLinesColumn = matchesColumn + 1; ///< The index of the invalid line count column.
+int constexpr indexRole = Qt::UserRole; ///< The role used to store the session index in the items of the session column.
+int constexpr sortRole = Qt::UserRole + 1; ///< The role used to store the sort key of numeric items.
+
+
+//****************************************************************************************************************************************************
+/// \brief Table item sorted on a numeric value, independently of its text.
+//****************************************************************************************************************************************************
+class NumericItem : public QTableWidgetItem {
+public: // member functions.
+    NumericItem(QString const &text, qint64 value) : QTableWidgetItem(text) { ///< Default constructor.
+        this->setData(sortRole, value);
+        this->setTextAlignment(Qt::AlignRight | Qt::AlignVCenter);
+    }
+    bool operator<(QTableWidgetItem const &other) const override { ///< Comparison operator.
+        return this->data(sortRole).toLongLong() < other.data(sortRole).toLongLong();
+    }
+};
+
+
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] parent The parent widget of the dialog.
+/// \param[in] sessions The sessions.
+//****************************************************************************************************************************************************
+SessionAnalysisDialog::SessionAnalysisDialog(QWidget *parent, QList<Session> sessions)
+    : QDialog(parent),
+      sessions_(std::move(sessions)) {
+    ui_.setupUi(this);
+    connect(ui_.buttonClose, &QPushButton::clicked, this, &QDialog::accept);
+    connect(ui_.buttonRun, &QPushButton::clicked, this, &SessionAnalysisDialog::onRun);
+    connect(ui_.editQuery, &QLineEdit::returnPressed, this, &SessionAnalysisDialog::onRun);
+    connect(ui_.buttonCancel, &QPushButton::clicked, this, &SessionAnalysisDialog::onCancel);
+    connect(ui_.table, &QTableWidget::itemDoubleClicked, this, &SessionAnalysisDialog::onItemDoubleClicked);
+    connect(&analysis_, &SessionAnalysis::sessionAnalyzed, this, &SessionAnalysisDialog::onSessionAnalyzed);
+    connect(&analysis_, &SessionAnalysis::finished, this, &SessionAnalysisDialog::onFinished);
+    this->onRun();
+}
+
+
+//****************************************************************************************************************************************************
+/// The table is cleared and one row per session is created. Rows are filled as sessions are analyzed, and sorting is disabled until the
+/// analysis is complete, so that the row of a session is its index.
+//****************************************************************************************************************************************************
+void SessionAnalysisDialog::onRun() {
+    analysis_.cancel();
+    ui_.table->setSortingEnabled(false);
+    ui_.table->clearContents();
+    ui_.table->setRowCount(int(sessions_.count()));
+    for (qsizetype i = 0; i < sessions_.count(); ++i) {
+        auto *item = new QTableWidgetItem(sessions_[i].sessionID());
+        item->setData(indexRole, qlonglong(i));
+        ui_.table->setItem(int(i), sessionColumn, item);
+    }
+    timer_.start();
+    analysis_.start(sessions_, ui_.editQuery->text().trimmed());
+    this->updateStatus();
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void SessionAnalysisDialog::onCancel() {
+    analysis_.cancel();
+    ui_.table->setSortingEnabled(true);
+    this->updateStatus();
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] index The index of the session.
+//****************************************************************************************************************************************************
+void SessionAnalysisDialog::onSessionAnalyzed(qsizetype index) {
+    SessionAnalysis::Summary const &summary = analysis_.summaries()[index];
+    int const row = int(index);
+    ui_.table->setItem(row, entriesColumn, new NumericItem(QString::number(summary.entryCount), summary.entryCount));
+    for (qsizetype level = 0; level < LogEntry::levelCount; ++level) {
+        qsizetype const count = summary.levelCounts[level];
+        ui_.table->setItem(row, int(firstLevelColumn + level), new NumericItem(QString::number(count), count));
+    }
+    qint64 const duration = summary.durationSecs();
+    ui_.table->setItem(row, durationColumn, new NumericItem((duration < 0) ? QString() : durationToString(duration), duration));
+    QString const matches = analysis_.query().isEmpty() ? QString() : QString::number(summary.matchCount);
+    ui_.table->setItem(row, matchesColumn, new NumericItem(matches, summary.matchCount));
+    ui_.table->setItem(row, invalidLinesColumn, new NumericItem(QString::number(summary.invalidLineCount), summary.invalidLineCount));
+    if (!summary.errors.isEmpty()) {
+        ui_.table->item(row, sessionColumn)->setToolTip(summary.errors.join("\n"));
+    }
+    this->updateStatus();
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void SessionAnalysisDialog::onFinished() {
+    ui_.table->setSortingEnabled(true);
+    ui_.table->resizeColumnsToContents();
+    this->updateStatus();
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] item The item.
+//****************************************************************************************************************************************************
+void SessionAnalysisDialog::onItemDoubleClicked(QTableWidgetItem *item) {
+    QTableWidgetItem const *sessionItem = item ? ui_.table->item(item->row(), sessionColumn) : nullptr;
+    if (sessionItem) {
+        emit sessionActivated(sessionItem->data(indexRole).toLongLong());
+    }
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void SessionAnalysisDialog::updateStatus() {
+    bool const running = analysis_.isRunning();
+    ui_.buttonCancel->setEnabled(running);
+    QString status = QString("%1/%2 sessions analyzed").arg(analysis_.completedCount()).arg(sessions_.count());
+    if (!running) {
+        status += QString(" in %1 ms").arg(timer_.elapsed());
+    }
+    ui_.labelStatus->setText(status);
+}
@@ -0,0 +1,52 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of cross-session analysis dialog class.
+
+
+#ifndef ANALOG_SESSION_ANALYSIS_DIALOG_H
+#define ANALOG_SESSION_ANALYSIS_DIALOG_H
+
+
+#include "ui_SessionAnalysisDialog.h"
+#include "SessionAnalysis.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Cross-session analysis dialog class.
+///
+/// The dialog runs a cross-session analysis and shows a table with one row per session. Rows are filled as sessions are analyzed.
+//****************************************************************************************************************************************************
+class SessionAnalysisDialog : public QDialog {
+    Q_OBJECT
+
+public: // member functions.
+    SessionAnalysisDialog(QWidget *parent, QList<Session> sessions); ///< Default constructor.
+    SessionAnalysisDialog(SessionAnalysisDialog const &) = delete; ///< Disabled copy-constructor.
+    SessionAnalysisDialog(SessionAnalysisDialog &&) = delete; ///< Disabled assignment copy-constructor.
+    ~SessionAnalysisDialog() override = default; ///< Destructor.
+    SessionAnalysisDialog& operator=(SessionAnalysisDialog const &) = delete; ///< Disabled assignment operator.
+    SessionAnalysisDialog& operator=(SessionAnalysisDialog &&) = delete; ///< Disabled move assignment operator.
+
+signals:
+    void sessionActivated(qsizetype index); ///< Signal emitted when a session is double-clicked.
+
+private slots:
+    void onRun(); ///< Slot for the 'Run' button.
+    void onCancel(); ///< Slot for the 'Cancel' button.
+    void onSessionAnalyzed(qsizetype index); ///< Slot for the completion of the analysis of a session.
+    void onFinished(); ///< Slot for the completion of the analysis.
+    void onItemDoubleClicked(QTableWidgetItem *item); ///< Slot for the double-click on an item.
+
+private: // member functions.
+    void updateStatus(); ///< Update the status label and buttons.
+
+private: // data members
+    Ui::SessionAnalysisDialog ui_ {}; ///< The UI for the dialog.
+    QList<Session> sessions_; ///< The sessions.
+    SessionAnalysis analysis_; ///< The analysis.
+    QElapsedTimer timer_; ///< The timer measuring the duration of the analysis.
+};
+
+
+#endif //ANALOG_SESSION_ANALYSIS_DIALOG_H
@@ -0,0 +1,250 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of session diff class.
+
+
+#include "SessionDiff.h"
+#include "LogStream.h"
+#include "Parallel.h"
+
+
+//****************************************************************************************************************************************************
+/// \param[in] dimension The dimension.
+/// \param[in] key The key.
+/// \param[in] firstCount The number of entries in the first session.
+/// \param[in] secondCount The number of entries in the second session.
+/// \param[in] first The profile of the first session.
+/// \param[in] second The profile of the second session.
+/// \return The diff item.
+//****************************************************************************************************************************************************
+SessionDiff::Item makeItem(SessionDiff::Dimension dimension, QString const &key, qsizetype firstCount, qsizetype secondCount,
+    SessionDiff::Profile const &first, SessionDiff::Profile const &second) {
+    SessionDiff::Item item { dimension, key, firstCount, secondCount };
+    item.firstRate = (first.entryCount > 0) ? 1000.0 * double(firstCount) / double(first.entryCount) : 0.0;
+    item.secondRate = (second.entryCount > 0) ? 1000.0 * double(secondCount) / double(second.entryCount) : 0.0;
+    if ((firstCount == 0) && (secondCount > 0)) {
+        item.change = SessionDiff::Change::OnlyInSecond;
+    } else if ((secondCount == 0) && (firstCount > 0)) {
+        item.change = SessionDiff::Change::OnlyInFirst;
+    } else if (qMax(firstCount, secondCount) < SessionDiff::minSignificantCount) {
+        item.change = SessionDiff::Change::Unchanged;
+    } else if (item.secondRate >= SessionDiff::minSignificantRatio * item.firstRate) {
+        item.change = SessionDiff::Change::Increased;
+    } else if (item.firstRate >= SessionDiff::minSignificantRatio * item.secondRate) {
+        item.change = SessionDiff::Change::Decreased;
+    }
+    return item;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] dimension The dimension.
+/// \param[in] firstCounts The counts of the first session.
+/// \param[in] secondCounts The counts of the second session.
+/// \param[in] first The profile of the first session.
+/// \param[in] second The profile of the second session.
+/// \param[out] items The list the items are appended to.
+//****************************************************************************************************************************************************
+void compareCounts(SessionDiff::Dimension dimension, QHash<QString, qsizetype> const &firstCounts, QHash<QString, qsizetype> const &secondCounts,
+    SessionDiff::Profile const &first, SessionDiff::Profile const &second, QList<SessionDiff::Item> &items) {
+    for (auto it = firstCounts.begin(); it != firstCounts.end(); ++it) {
+        items.append(makeItem(dimension, it.key(), it.value(), secondCounts.value(it.key(), 0), first, second));
+    }
+    for (auto it = secondCounts.begin(); it != secondCounts.end(); ++it) {
+        if (!firstCounts.contains(it.key())) {
+            items.append(makeItem(dimension, it.key(), 0, it.value(), first, second));
+        }
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// Packages are counted by identifier in a UTF-8 package dictionary, so each package is only converted to a string once.
+///
+/// \param[in] session The session.
+/// \param[in] cancelled The cancellation flag.
+/// \return The profile of the session.
+//****************************************************************************************************************************************************
+SessionDiff::Profile SessionDiff::computeProfile(Session const &session, std::atomic_bool const &cancelled) {
+    Profile profile;
+    profile.sessionID = session.sessionID();
+    TemplateMiner miner;
+    QHash<QByteArray, qint32> packageIds; // entries are not kept once read, so the keys are copies.
+    QList<qsizetype> packageCounts;
+    LogStream::readSession(session, [&profile, &miner, &packageIds, &packageCounts](LogEntry const &entry) {
+        if (!entry.isValid()) {
+            return;
+        }
+        ++profile.entryCount;
+        ++profile.levelCounts[qsizetype(entry.level())];
+        QUtf8StringView const package = entry.packageUtf8();
+        auto it = packageIds.find(QByteArray::fromRawData(package.data(), package.size())); // no copy is made for the lookup.
+        if (it == packageIds.end()) {
+            it = packageIds.insert(QByteArray(package.data(), package.size()), qint32(packageCounts.size()));
+            packageCounts.append(0);
+        }
+        ++packageCounts[it.value()];
+        miner.addEntry(entry, entry.timestamp());
+    }, profile.errors, cancelled);
+
+    for (auto it = packageIds.begin(); it != packageIds.end(); ++it) {
+        profile.packageCounts.insert(QString::fromUtf8(it.key()), packageCounts[it.value()]);
+    }
+
+    for (TemplateMiner::Template const &tmpl: miner.templates()) {
+        profile.templateCounts[tmpl.text()] += tmpl.count;
+    }
+    return profile;
+}
+
+
+//****************************************************************************************************************************************************
+/// Items are sorted by dimension, then by decreasing absolute rate difference.
+///
+/// \param[in] first The profile of the first session.
+/// \param[in] second The profile of the second session.
+/// \return The diff items.
+//****************************************************************************************************************************************************
+QList<SessionDiff::Item> SessionDiff::compare(Profile const &first, Profile const &second) {
+    QList<Item> items;
+    for (qsizetype level = 0; level < LogEntry::levelCount; ++level) {
+        items.append(makeItem(Dimension::Level, LogEntry::levelToString(LogEntry::Level(level)), first.levelCounts[level],
+            second.levelCounts[level], first, second));
+    }
+    compareCounts(Dimension::Package, first.packageCounts, second.packageCounts, first, second, items);
+    compareCounts(Dimension::Template, first.templateCounts, second.templateCounts, first, second, items);
+    std::ranges::stable_sort(items, [](Item const &lhs, Item const &rhs) -> bool {
+        if (lhs.dimension != rhs.dimension) {
+            return lhs.dimension < rhs.dimension;
+        }
+        return qAbs(lhs.secondRate - lhs.firstRate) > qAbs(rhs.secondRate - rhs.firstRate);
+    });
+    return items;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] change The change.
+/// \return The string for the change.
+//****************************************************************************************************************************************************
+QString SessionDiff::changeToString(Change change) {
+    switch (change) {
+    case Change::OnlyInFirst:
+        return "only in first";
+    case Change::OnlyInSecond:
+        return "only in second";
+    case Change::Increased:
+        return "increased";
+    case Change::Decreased:
+        return "decreased";
+    case Change::Unchanged:
+    default:
+        return QString();
+    }
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+SessionDiff::~SessionDiff() {
+    this->cancel();
+}
+
+
+//****************************************************************************************************************************************************
+/// Any comparison in progress is cancelled. The profiles of the two sessions are computed in parallel.
+///
+/// \param[in] first The first session.
+/// \param[in] second The second session.
+//****************************************************************************************************************************************************
+void SessionDiff::start(Session const &first, Session const &second) {
+    this->cancel();
+    running_ = true;
+    quint64 const generation = generation_;
+    cancelled_ = std::make_shared<std::atomic_bool>(false);
+    thread_ = std::thread([this, first, second, generation, cancelled = cancelled_]() {
+        std::array<Profile, 2> profiles;
+        parallelFor(2, 1, [&](qsizetype, qsizetype begin, qsizetype end) {
+            for (qsizetype i = begin; i < end; ++i) {
+                profiles[i] = computeProfile((i == 0) ? first : second, *cancelled);
+            }
+        });
+        if (*cancelled) {
+            return;
+        }
+        QList<Item> const items = compare(profiles[0], profiles[1]);
+        QMetaObject::invokeMethod(this, [this, generation, profiles, items]() {
+            this->setResult(generation, profiles[0], profiles[1], items);
+        }, Qt::QueuedConnection);
+    });
+}
+
+
+//****************************************************************************************************************************************************
+/// The worker threads check for cancellation regularly, so this function returns quickly.
+//****************************************************************************************************************************************************
+void SessionDiff::cancel() {
+    if (cancelled_) {
+        *cancelled_ = true;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    ++generation_;
+    running_ = false;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return true iff a comparison is in progress.
+//****************************************************************************************************************************************************
+bool SessionDiff::isRunning() const {
+    return running_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The profile of the first session.
+//****************************************************************************************************************************************************
+SessionDiff::Profile const &SessionDiff::firstProfile() const {
+    return firstProfile_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The profile of the second session.
+//****************************************************************************************************************************************************
+SessionDiff::Profile const &SessionDiff::secondProfile() const {
+    return secondProfile_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The diff items.
+//****************************************************************************************************************************************************
+QList<SessionDiff::Item> const &SessionDiff::items() const {
+    return items_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] generation The generation of the comparison that produced the result.
+/// \param[in] first The profile of the first session.
+/// \param[in] second The profile of the second session.
+/// \param[in] items The diff items.
+//****************************************************************************************************************************************************
+void SessionDiff::setResult(quint64 generation, Profile const &first, Profile const &second, QList<Item> const &items) {
+    if (generation != generation_) {
+        return;
+    }
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+    running_ = false;
+    firstProfile_ = first;
+    secondProfile_ = second;
+    items_ = items;
+    emit finished();
+}
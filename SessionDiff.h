@@ -0,0 +1,100 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of session diff class.
+
+
+#ifndef ANALOG_SESSION_DIFF_H
+#define ANALOG_SESSION_DIFF_H
+
+
+#include "Session.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Session diff class.
+///
+/// The diff compares the frequency profiles of two sessions: the number of entries per level, per package and per message template. The
+/// profiles of the two sessions are computed in parallel on worker threads by streaming the log files, so the logs are never loaded in memory.
+/// Templates are mined independently for each session, and matched by their text. Frequencies are normalized by the number of entries of the
+/// session, so sessions of different lengths can be compared.
+//****************************************************************************************************************************************************
+class SessionDiff : public QObject {
+    Q_OBJECT
+
+public: // data types
+    struct Profile {
+        QString sessionID; ///< The session ID.
+        qsizetype entryCount { 0 }; ///< The number of valid entries.
+        std::array<qsizetype, LogEntry::levelCount> levelCounts {}; ///< The number of entries for each level.
+        QHash<QString, qsizetype> packageCounts; ///< The number of entries for each package.
+        QHash<QString, qsizetype> templateCounts; ///< The number of entries for each message template.
+        QStringList errors; ///< The errors encountered while reading the session.
+    }; ///< Structure for session profiles.
+
+    enum class Dimension {
+        Level = 0,
+        Package = 1,
+        Template = 2,
+    }; ///< Enumeration for the dimensions of a profile.
+
+    enum class Change {
+        OnlyInFirst = 0,
+        OnlyInSecond = 1,
+        Increased = 2,
+        Decreased = 3,
+        Unchanged = 4,
+    }; ///< Enumeration for the kinds of change between two sessions.
+
+    struct Item {
+        Dimension dimension { Dimension::Level }; ///< The dimension.
+        QString key; ///< The level, package or template.
+        qsizetype firstCount { 0 }; ///< The number of entries in the first session.
+        qsizetype secondCount { 0 }; ///< The number of entries in the second session.
+        double firstRate { 0.0 }; ///< The number of entries per thousand entries in the first session.
+        double secondRate { 0.0 }; ///< The number of entries per thousand entries in the second session.
+        Change change { Change::Unchanged }; ///< The change between the two sessions.
+    }; ///< Structure for diff items.
+
+public: // static members
+    static qsizetype constexpr minSignificantCount = 10; ///< The minimum count in one of the sessions for a change to be significant.
+    static double constexpr minSignificantRatio = 2.0; ///< The minimum ratio between two rates for a change to be significant.
+
+public: // static member functions.
+    static Profile computeProfile(Session const &session, std::atomic_bool const &cancelled); ///< Compute the profile of a session.
+    static QList<Item> compare(Profile const &first, Profile const &second); ///< Compare two profiles.
+    static QString changeToString(Change change); ///< Return the string for a change.
+
+public: // member functions.
+    SessionDiff() = default; ///< Default constructor.
+    SessionDiff(SessionDiff const &) = delete; ///< Disabled copy-constructor.
+    SessionDiff(SessionDiff &&) = delete; ///< Disabled assignment copy-constructor.
+    ~SessionDiff() override; ///< Destructor.
+    SessionDiff& operator=(SessionDiff const &) = delete; ///< Disabled assignment operator.
+    SessionDiff& operator=(SessionDiff &&) = delete; ///< Disabled move assignment operator.
+
+    void start(Session const &first, Session const &second); ///< Start the comparison of two sessions.
+    void cancel(); ///< Cancel the comparison in progress.
+    bool isRunning() const; ///< Check if a comparison is in progress.
+    Profile const &firstProfile() const; ///< Return the profile of the first session.
+    Profile const &secondProfile() const; ///< Return the profile of the second session.
+    QList<Item> const &items() const; ///< Return the diff items.
+
+signals:
+    void finished(); ///< Signal emitted when the comparison is complete.
+
+private: // member functions.
+    void setResult(quint64 generation, Profile const &first, Profile const &second, QList<Item> const &items); ///< Store the result of a comparison.
+
+private: // data members.
+    std::thread thread_; ///< The worker thread.
+    std::shared_ptr<std::atomic_bool> cancelled_; ///< The cancellation flag of the current comparison.
+    quint64 generation_ { 0 }; ///< The generation of the current comparison, used to discard results of cancelled comparisons.
+    bool running_ { false }; ///< Is a comparison in progress.
+    Profile firstProfile_; ///< The profile of the first session.
+    Profile secondProfile_; ///< The profile of the second session.
+    QList<Item> items_; ///< The diff items.
+};
+
+
+#endif //ANALOG_SESSION_DIFF_H
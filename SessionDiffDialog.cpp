@@ -0,0 +1,154 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of session diff dialog class.
+
+
+#include "SessionDiffDialog.h"
+
+
+namespace {
+
+
+int constexpr keyColumn = 0; ///< The index of the key column.
+int constexpr firstCountColumn = 1; ///< The index of the column of the count in the first session.
+int constexpr secondCountColumn = 2; ///< The index of the column of the count in the second session.
+int constexpr firstRateColumn = 3; ///< The index of the column of the rate in the first session.
+int constexpr secondRateColumn = 4; ///< The index of the column of the rate in the second session.
+int constexpr changeColumn = 5; ///< The index of the change column.
+
+
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] dimension The dimension.
+/// \return The title of the tree node for the dimension.
+//****************************************************************************************************************************************************
+QString dimensionTitle(SessionDiff::Dimension dimension) {
+    switch (dimension) {
+    case SessionDiff::Dimension::Level:
+        return "Levels";
+    case SessionDiff::Dimension::Package:
+        return "Packages";
+    case SessionDiff::Dimension::Template:
+    default:
+        return "Message templates";
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] parent The parent widget of the dialog.
+/// \param[in] sessions The sessions.
+/// \param[in] currentIndex The index of the current session, or -1 if no session is selected.
+//****************************************************************************************************************************************************
+SessionDiffDialog::SessionDiffDialog(QWidget *parent, QList<Session> sessions, qsizetype currentIndex)
+    : QDialog(parent),
+      sessions_(std::move(sessions)) {
+    ui_.setupUi(this);
+    for (Session const &session: sessions_) {
+        ui_.comboFirst->addItem(session.sessionID());
+        ui_.comboSecond->addItem(session.sessionID());
+    }
+    // By default, the current session is compared to the previous one.
+    qsizetype const second = ((currentIndex >= 0) && (currentIndex < sessions_.count())) ? currentIndex : 0;
+    ui_.comboSecond->setCurrentIndex(int(second));
+    ui_.comboFirst->setCurrentIndex(int((second + 1 < sessions_.count()) ? second + 1 : second));
+
+    connect(ui_.buttonClose, &QPushButton::clicked, this, &QDialog::accept);
+    connect(ui_.buttonCompare, &QPushButton::clicked, this, &SessionDiffDialog::onCompare);
+    connect(ui_.checkOnlyChanges, &QCheckBox::toggled, this, &SessionDiffDialog::updateTree);
+    connect(&diff_, &SessionDiff::finished, this, &SessionDiffDialog::onFinished);
+    this->updateStatus();
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void SessionDiffDialog::onCompare() {
+    qsizetype const first = ui_.comboFirst->currentIndex();
+    qsizetype const second = ui_.comboSecond->currentIndex();
+    if ((first < 0) || (second < 0)) {
+        return;
+    }
+    ui_.tree->clear();
+    timer_.start();
+    diff_.start(sessions_[first], sessions_[second]);
+    this->updateStatus();
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void SessionDiffDialog::onFinished() {
+    this->updateTree();
+    this->updateStatus();
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void SessionDiffDialog::updateTree() {
+    ui_.tree->clear();
+    bool const onlyChanges = ui_.checkOnlyChanges->isChecked();
+    QTreeWidgetItem *node = nullptr;
+    std::optional<SessionDiff::Dimension> dimension;
+    for (SessionDiff::Item const &item: diff_.items()) {
+        if (onlyChanges && (item.change == SessionDiff::Change::Unchanged)) {
+            continue;
+        }
+        if (item.dimension != dimension) {
+            dimension = item.dimension;
+            node = new QTreeWidgetItem(ui_.tree, { dimensionTitle(item.dimension) });
+            node->setFirstColumnSpanned(true);
+            node->setExpanded(true);
+        }
+        auto *child = new QTreeWidgetItem(node);
+        child->setText(keyColumn, item.key);
+        child->setToolTip(keyColumn, item.key);
+        child->setText(firstCountColumn, QString::number(item.firstCount));
+        child->setText(secondCountColumn, QString::number(item.secondCount));
+        child->setText(firstRateColumn, QString::number(item.firstRate, 'f', 3));
+        child->setText(secondRateColumn, QString::number(item.secondRate, 'f', 3));
+        child->setText(changeColumn, SessionDiff::changeToString(item.change));
+        for (int column = firstCountColumn; column <= secondRateColumn; ++column) {
+            child->setTextAlignment(column, Qt::AlignRight | Qt::AlignVCenter);
+        }
+    }
+    for (int column = firstCountColumn; column <= changeColumn; ++column) {
+        ui_.tree->resizeColumnToContents(column);
+    }
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void SessionDiffDialog::updateStatus() {
+    bool const running = diff_.isRunning();
+    ui_.buttonCompare->setEnabled(!running);
+    if (running) {
+        ui_.labelStatus->setText("Comparing sessions...");
+        return;
+    }
+    if (diff_.items().isEmpty()) {
+        ui_.labelStatus->clear();
+        return;
+    }
+    SessionDiff::Profile const &first = diff_.firstProfile();
+    SessionDiff::Profile const &second = diff_.secondProfile();
+    QString status = QString("%1: %2 entries, %3: %4 entries, compared in %5 ms").arg(first.sessionID).arg(first.entryCount)
+        .arg(second.sessionID).arg(second.entryCount).arg(timer_.elapsed());
+    QStringList const errors = first.errors + second.errors;
+    if (!errors.isEmpty()) {
+        status += QString(" (%1 errors)").arg(errors.count());
+        ui_.labelStatus->setToolTip(errors.join("\n"));
+    } else {
+        ui_.labelStatus->setToolTip(QString());
+    }
+    ui_.labelStatus->setText(status);
+}
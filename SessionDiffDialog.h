@@ -0,0 +1,47 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of session diff dialog class.
+
+
+#ifndef ANALOG_SESSION_DIFF_DIALOG_H
+#define ANALOG_SESSION_DIFF_DIALOG_H
+
+
+#include "ui_SessionDiffDialog.h"
+#include "SessionDiff.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Session diff dialog class.
+///
+/// The dialog compares two sessions and shows the levels, packages and message templates whose frequency differs between them.
+//****************************************************************************************************************************************************
+class SessionDiffDialog : public QDialog {
+    Q_OBJECT
+
+public: // member functions.
+    SessionDiffDialog(QWidget *parent, QList<Session> sessions, qsizetype currentIndex); ///< Default constructor.
+    SessionDiffDialog(SessionDiffDialog const &) = delete; ///< Disabled copy-constructor.
+    SessionDiffDialog(SessionDiffDialog &&) = delete; ///< Disabled assignment copy-constructor.
+    ~SessionDiffDialog() override = default; ///< Destructor.
+    SessionDiffDialog& operator=(SessionDiffDialog const &) = delete; ///< Disabled assignment operator.
+    SessionDiffDialog& operator=(SessionDiffDialog &&) = delete; ///< Disabled move assignment operator.
+
+private slots:
+    void onCompare(); ///< Slot for the 'Compare' button.
+    void onFinished(); ///< Slot for the completion of the comparison.
+    void updateTree(); ///< Update the tree from the diff items.
+
+private: // member functions.
+    void updateStatus(); ///< Update the status label and buttons.
+
+private: // data members
+    Ui::SessionDiffDialog ui_ {}; ///< The UI for the dialog.
+    QList<Session> sessions_; ///< The sessions.
+    SessionDiff diff_; ///< The session diff.
+    QElapsedTimer timer_; ///< The timer measuring the duration of the comparison.
+};
+
+
+#endif //ANALOG_SESSION_DIFF_DIALOG_H
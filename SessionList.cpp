@@ -7,6 +7,7 @@
 #include "SessionList.h"
 #include "Exception.h"
 #include "FilenameInfo.h"
+#include "LogCache.h"
 
 namespace {
 QString const bridgeStr = "Bridge"; ///< The string for bridge.
@@ -47,6 +48,7 @@ Session const& SessionList::operator[](int index) const {
 void SessionList::open(QStringList const &filePaths) {
     this->beginResetModel();
     sessions_.clear();
+    LogCache::clear();
     if (filePaths.isEmpty()) {
         return;
     }
@@ -96,6 +98,14 @@ qsizetype SessionList::count() const {
 }
 
 
+//****************************************************************************************************************************************************
+/// \return The sessions.
+//****************************************************************************************************************************************************
+QList<Session> const &SessionList::sessions() const {
+    return sessions_;
+}
+
+
 //****************************************************************************************************************************************************
 /// \param[in] parent The parent item index.
 /// \return The number of rows.
@@ -131,3 +141,18 @@ QVariant SessionList::data(QModelIndex const &index, int role) const {
 
     return result;
 }
+
+
+//****************************************************************************************************************************************************
+/// \return The estimated memory usage of the session list, and of the cached logs of its sessions.
+//****************************************************************************************************************************************************
+MemoryUsage SessionList::memoryUsage() const {
+    MemoryUsage result;
+    qint64 sessionByteCount = MemoryUsage::listByteCount(sessions_);
+    for (Session const &session: sessions_) {
+        sessionByteCount += session.byteCount();
+    }
+    result.add("sessions", sessionByteCount);
+    result.add("cachedLogs", LogCache::memoryUsage().total());
+    return result;
+}
@@ -30,6 +30,8 @@ public: // member functions.
     void open(QStringList const &filePaths); ///< Open a session list.
     Session const & session(QModelIndex const &index) const; ///< Get an optional reference to the session at the given index.
     qsizetype count() const; ///< return the number of sessions.
+    QList<Session> const &sessions() const; ///< Return the sessions.
+    MemoryUsage memoryUsage() const; ///< Return the estimated memory usage of the sessions and of their cached logs.
 
     /// \name Tree view model functions.
     ///\{
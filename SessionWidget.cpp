@@ -5,6 +5,8 @@
 ///
 ///
 #include "SessionWidget.h"
+#include "Instrumentation.h"
+#include "LogCache.h"
 
 
 //****************************************************************************************************************************************************
@@ -14,63 +16,175 @@ SessionWidget::SessionWidget(QWidget *parent)
     : QWidget(parent) {
     ui_.setupUi(this);
     ui_.tableView->setModel(&filter_);
+    columnSizer_ = new ColumnSizer(ui_.tableView);
+    columnSizer_->setMaximumWidth(3, 600);
+
+    QHeaderView *header = ui_.tableView->horizontalHeader();
+    header->setSectionsClickable(true);
+    header->setSortIndicatorShown(true);
+    header->setSortIndicator(-1, Qt::AscendingOrder);
+    connect(header, &QHeaderView::sortIndicatorChanged, this, &SessionWidget::onSortIndicatorChanged);
+
+    auto *completer = new QCompleter(&packageCompletionModel_, this);
+    completer->setCompletionRole(Qt::UserRole);
+    completer->setCaseSensitivity(Qt::CaseInsensitive);
+    completer->setFilterMode(Qt::MatchContains);
+    ui_.editPackage->setCompleter(completer);
+
+    ui_.splitterTable->setStretchFactor(0, 1);
+    ui_.facetWidget->setFilterModel(&filter_);
 
     connect(ui_.editFilter, &QLineEdit::textChanged, this, &SessionWidget::onTextFilterChanged);
     connect(ui_.editPackage, &QLineEdit::textChanged, this, &SessionWidget::onPackageFilterChanged);
     connect(ui_.comboLevel, &QComboBox::currentIndexChanged, this, &SessionWidget::onLevelComboChanged);
     connect(ui_.checkAndAbove, &QCheckBox::stateChanged, this, &SessionWidget::onLevelStrictnessChanged);
+    connect(ui_.checkTimeRange, &QCheckBox::toggled, this, &SessionWidget::onTimeRangeChanged);
+    connect(ui_.editTimeStart, &QDateTimeEdit::dateTimeChanged, this, &SessionWidget::onTimeRangeChanged);
+    connect(ui_.editTimeEnd, &QDateTimeEdit::dateTimeChanged, this, &SessionWidget::onTimeRangeChanged);
+    connect(ui_.buttonJump, &QPushButton::clicked, this, &SessionWidget::onJumpToTime);
+    connect(ui_.editJumpTime, &QDateTimeEdit::editingFinished, this, &SessionWidget::onJumpToTime);
+    connect(ui_.histogramWidget, &HistogramWidget::bucketClicked, this, &SessionWidget::onHistogramBucketClicked);
+    connect(ui_.comboAnomalies, &QComboBox::activated, this, &SessionWidget::onAnomalyActivated);
     connect(ui_.buttonBridge, &QPushButton::clicked, this, &SessionWidget::onShowBridgeLog);
     connect(ui_.buttonGUI, &QPushButton::clicked, this, &SessionWidget::onShowGUILog);
     connect(ui_.buttonLauncher, &QPushButton::clicked, this, &SessionWidget::onShowLauncherLog);
     connect(&filter_, &FilterModel::modelReset, this, &SessionWidget::onLogLoaded);
+    connect(&scheduler_, &LogScheduler::loaded, this, &SessionWidget::onLogReady);
     connect(&filter_, &FilterModel::layoutChanged, this, &SessionWidget::onLayoutChanged);
     connect(&filter_, &FilterModel::logErrorsOccurred, this, &SessionWidget::logErrorsOccurred);
+    connect(&filter_, &FilterModel::sortStarted, this, &SessionWidget::onSortStarted);
+    connect(&filter_, &FilterModel::sortFinished, this, &SessionWidget::onLayoutChanged);
+    connect(ui_.facetWidget, &FacetWidget::valueSelected, this, &SessionWidget::onFacetValueSelected);
+    connect(ui_.facetWidget, &FacetWidget::valueCleared, this, &SessionWidget::onFacetValueCleared);
+    connect(ui_.editSearch, &QLineEdit::textChanged, this, &SessionWidget::onSearchTextChanged);
+    connect(ui_.editSearch, &QLineEdit::returnPressed, this, &SessionWidget::onSearchNext);
+    connect(ui_.buttonSearchNext, &QPushButton::clicked, this, &SessionWidget::onSearchNext);
+    connect(ui_.buttonSearchPrevious, &QPushButton::clicked, this, &SessionWidget::onSearchPrevious);
+    connect(&searchHits_, &SearchHits::hitsChanged, this, &SessionWidget::updateSearchLabel);
+    connect(ui_.tableView->selectionModel(), &QItemSelectionModel::currentChanged, this, &SessionWidget::updateSearchLabel);
 
     ui_.editFilter->setText(filter_.textFilter());
     ui_.editPackage->setText(filter_.packageFilter());
     ui_.comboLevel->setCurrentIndex(static_cast<int>(filter_.level()));
     ui_.checkAndAbove->setChecked(!filter_.useStrictLevelFilter());
+    ui_.checkTimeRange->setChecked(filter_.hasTimeRange());
+    this->updateTimeEdits();
 }
 
 
 //****************************************************************************************************************************************************
 /// \param[in] session The session.
+/// \return The files of the log displayed first for the session, i.e. the first available of the bridge, bridge-gui and launcher logs.
+//****************************************************************************************************************************************************
+QStringList primaryFilePaths(Session const &session) {
+    if (session.hasBridgeLog()) {
+        return session.bridgeFilePaths();
+    }
+    return session.hasGUILog() ? session.guiFilePaths() : session.launcherFilePaths();
+}
+
+
+//****************************************************************************************************************************************************
+/// The log of the session is loaded in the background, unless it is in the log cache. Any load started for the previous session is cancelled.
+/// The primary logs of the adjacent sessions, then the other logs of the session, are prefetched at low priority.
+///
+/// \param[in] session The session.
+/// \param[in] adjacentSessions The sessions the user is likely to select next, by decreasing likelihood.
 //****************************************************************************************************************************************************
-void SessionWidget::setSession(std::optional<Session> const &session) {
+void SessionWidget::setSession(std::optional<Session> const &session, QList<Session> const &adjacentSessions) {
     session_ = session;
 
     this->updateGUI();
 
     if (!session_) {
-        filter_.setLog({});
+        scheduler_.setPrefetchList({});
+        this->showLog({});
         return;
     }
-    bool const hasBridgeLog = session->hasBridgeLog();
-    bool const hasGUILog = session->hasGUILog();
-    bool const hasLauncherLog = session->hasLauncherLog();
 
-    if (hasBridgeLog) {
-        filter_.setLog(session->bridgeLog());
+    QStringList const filePaths = primaryFilePaths(*session_);
+    this->showLog(filePaths);
+    if (session_->hasBridgeLog()) {
         ui_.buttonBridge->setChecked(true);
+    } else if (session_->hasGUILog()) {
+        ui_.buttonGUI->setChecked(true);
+    } else if (session_->hasLauncherLog()) {
+        ui_.buttonLauncher->setChecked(true);
+    }
+
+    QList<QStringList> prefetchList;
+    for (Session const &adjacent: adjacentSessions) {
+        prefetchList.append(primaryFilePaths(adjacent));
+    }
+    for (QStringList const &otherFilePaths: { session_->bridgeFilePaths(), session_->guiFilePaths(), session_->launcherFilePaths() }) {
+        if (otherFilePaths != filePaths) {
+            prefetchList.append(otherFilePaths);
+        }
+    }
+    scheduler_.setPrefetchList(prefetchList);
+}
+
+
+//****************************************************************************************************************************************************
+/// Cached logs are displayed immediately. Otherwise, the displayed log is released, so the cache can evict it if needed, and the log is loaded
+/// in the background at high priority. The load in progress is cancelled, unless it is for the same files.
+///
+/// \param[in] filePaths The ordered list of files forming the log, or an empty list to display no log.
+//****************************************************************************************************************************************************
+void SessionWidget::showLog(QStringList const &filePaths) {
+    if (scheduler_.isLoading() && (scheduler_.filePaths() == filePaths)) {
         return;
     }
-    if (hasGUILog) {
-        filter_.setLog(session->guiLog());
-        ui_.buttonGUI->setChecked(true);
+    if (filePaths.isEmpty()) {
+        scheduler_.cancel();
+        filter_.setLog({});
         return;
     }
-    if (hasLauncherLog) {
-        filter_.setLog(session_->launcherLog());
-        ui_.buttonLauncher->setChecked(true);
+    if (SPLog const log = LogCache::find(filePaths)) {
+        scheduler_.preempt();
+        scheduler_.cancel();
+        filter_.setLog(log);
         return;
     }
+    filter_.setLog({});
+    scheduler_.load(filePaths);
+    emit logStatusMessageChanged(tr("Loading..."));
+}
 
+//****************************************************************************************************************************************************
+/// \return The log currently displayed in the widget.
+//****************************************************************************************************************************************************
+SPLog SessionWidget::log() const {
+    return filter_.log();
 }
 
+
+//****************************************************************************************************************************************************
+/// \return The estimated memory usage of the displayed log and of its filter model, by component.
+//****************************************************************************************************************************************************
+MemoryUsage SessionWidget::memoryUsage() const {
+    MemoryUsage result;
+    if (SPLog const log = filter_.log()) {
+        result.add("log/", log->memoryUsage());
+    }
+    result.add("filter/", filter_.memoryUsage());
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The source rows of the filtered view, in view order.
+//****************************************************************************************************************************************************
+QList<qint32> SessionWidget::visibleSourceRows() const {
+    return filter_.visibleSourceRows();
+}
+
+
 //****************************************************************************************************************************************************
 /// \param[in] value The text filter.
 //****************************************************************************************************************************************************
 void SessionWidget::onTextFilterChanged(QString const &value) {
+    scheduler_.preempt();
     filter_.setTextFilter(value);
 }
 
@@ -79,6 +193,7 @@ void SessionWidget::onTextFilterChanged(QString const &value) {
 /// \param[in] index The index of the current item.
 //****************************************************************************************************************************************************
 void SessionWidget::onLevelComboChanged(int index) {
+    scheduler_.preempt();
     filter_.setLevel(static_cast<LogEntry::Level>(index));
 }
 
@@ -87,6 +202,7 @@ void SessionWidget::onLevelComboChanged(int index) {
 /// \param[in] nonStrict The strictness of the level filter.
 //****************************************************************************************************************************************************
 void SessionWidget::onLevelStrictnessChanged(bool nonStrict) {
+    scheduler_.preempt();
     filter_.setUseStrictLevelFilter(!nonStrict);
 }
 
@@ -95,20 +211,244 @@ void SessionWidget::onLevelStrictnessChanged(bool nonStrict) {
 /// \param[in] value The new value for the package filter.
 //****************************************************************************************************************************************************
 void SessionWidget::onPackageFilterChanged(QString const &value) {
+    scheduler_.preempt();
     filter_.setPackageFilter(value);
 }
 
 
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void SessionWidget::onTimeRangeChanged() {
+    scheduler_.preempt();
+    bool const enabled = ui_.checkTimeRange->isChecked();
+    ui_.editTimeStart->setEnabled(enabled);
+    ui_.editTimeEnd->setEnabled(enabled);
+    if (!enabled) {
+        filter_.clearTimeRange();
+        ui_.histogramWidget->clearSelectedRange();
+        return;
+    }
+    qint64 const start = LogEntry::dateTimeToTimestamp(ui_.editTimeStart->dateTime());
+    qint64 const end = LogEntry::dateTimeToTimestamp(ui_.editTimeEnd->dateTime());
+    filter_.setTimeRange(start, end);
+    ui_.histogramWidget->setSelectedRange(start, end);
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void SessionWidget::onJumpToTime() {
+    int const row = filter_.proxyRowForTimestamp(LogEntry::dateTimeToTimestamp(ui_.editJumpTime->dateTime()));
+    if (row < 0) {
+        return;
+    }
+    QModelIndex const index = filter_.index(row, 0);
+    ui_.tableView->setCurrentIndex(index);
+    ui_.tableView->scrollTo(index, QAbstractItemView::PositionAtTop);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] start The start of the bucket time range.
+/// \param[in] end The end of the bucket time range (inclusive).
+//****************************************************************************************************************************************************
+void SessionWidget::onHistogramBucketClicked(qint64 start, qint64 end) {
+    {
+        QSignalBlocker const blockerCheck(ui_.checkTimeRange);
+        QSignalBlocker const blockerStart(ui_.editTimeStart);
+        QSignalBlocker const blockerEnd(ui_.editTimeEnd);
+        ui_.checkTimeRange->setChecked(true);
+        ui_.editTimeStart->setDateTime(LogEntry::timestampToDateTime(start));
+        ui_.editTimeEnd->setDateTime(LogEntry::timestampToDateTime(end));
+        ui_.editTimeStart->setEnabled(true);
+        ui_.editTimeEnd->setEnabled(true);
+    }
+    // The range is applied directly, as the edits may not display milliseconds.
+    scheduler_.preempt();
+    filter_.setTimeRange(start, end);
+    ui_.histogramWidget->setSelectedRange(start, end);
+}
+
+
+//****************************************************************************************************************************************************
+/// The first row of the anomaly is selected if it is visible. Otherwise, the view jumps to the first visible row after the start of the anomaly.
+///
+/// \param[in] index The index of the item in the anomaly list.
+//****************************************************************************************************************************************************
+void SessionWidget::onAnomalyActivated(int index) {
+    SPLog const log = filter_.log();
+    if ((!log) || (index < 1) || (index > log->anomalies().count())) {
+        return;
+    }
+    BurstDetector::Anomaly const &anomaly = log->anomalies()[index - 1];
+    if (filter_.isSourceRowVisible(anomaly.firstRow)) {
+        this->selectSourceRow(anomaly.firstRow);
+    } else {
+        int const row = filter_.proxyRowForTimestamp(anomaly.startTimestamp);
+        if (row >= 0) {
+            QModelIndex const proxyIndex = filter_.index(row, 0);
+            ui_.tableView->setCurrentIndex(proxyIndex);
+            ui_.tableView->scrollTo(proxyIndex, QAbstractItemView::PositionAtCenter);
+        }
+    }
+    ui_.comboAnomalies->setCurrentIndex(0);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] key The field key.
+/// \param[in] value The field value.
+//****************************************************************************************************************************************************
+void SessionWidget::onFacetValueSelected(QString const &key, QString const &value) {
+    SPLog const log = filter_.log();
+    if (log) {
+        scheduler_.preempt();
+        filter_.setRowRestriction(log->facetIndex().rows(key, value));
+    }
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void SessionWidget::onFacetValueCleared() {
+    scheduler_.preempt();
+    filter_.clearRowRestriction();
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] text The search text.
+//****************************************************************************************************************************************************
+void SessionWidget::onSearchTextChanged(QString const &text) {
+    scheduler_.preempt();
+    searchHits_.start(filter_.log(), text);
+}
+
+
+//****************************************************************************************************************************************************
+/// Hits that are hidden by the filter are skipped. The search wraps around at the end of the log.
+//****************************************************************************************************************************************************
+void SessionWidget::onSearchNext() {
+    qint32 row = this->currentSourceRow();
+    bool wrapped = false;
+    while (true) {
+        std::optional<qint32> const hit = searchHits_.next(row);
+        if (!hit) {
+            if (wrapped) {
+                return;
+            }
+            wrapped = true;
+            row = -1;
+            continue;
+        }
+        if (filter_.isSourceRowVisible(*hit)) {
+            this->selectSourceRow(*hit);
+            return;
+        }
+        row = *hit;
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// Hits that are hidden by the filter are skipped. The search wraps around at the beginning of the log.
+//****************************************************************************************************************************************************
+void SessionWidget::onSearchPrevious() {
+    qint32 const rowCount = filter_.log() ? qint32(filter_.log()->entries().count()) : 0;
+    qint32 row = this->currentSourceRow();
+    row = (row < 0) ? rowCount : row;
+    bool wrapped = false;
+    while (true) {
+        std::optional<qint32> const hit = searchHits_.previous(row);
+        if (!hit) {
+            if (wrapped) {
+                return;
+            }
+            wrapped = true;
+            row = rowCount;
+            continue;
+        }
+        if (filter_.isSourceRowVisible(*hit)) {
+            this->selectSourceRow(*hit);
+            return;
+        }
+        row = *hit;
+    }
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void SessionWidget::updateSearchLabel() {
+    if (searchHits_.text().isEmpty()) {
+        ui_.labelSearchHits->clear();
+        return;
+    }
+    qsizetype const count = searchHits_.count();
+    if (searchHits_.isRunning()) {
+        ui_.labelSearchHits->setText(tr("%1 hits...").arg(count));
+        return;
+    }
+    qsizetype const index = searchHits_.indexOf(this->currentSourceRow());
+    ui_.labelSearchHits->setText(index < 0 ? tr("%1 hits").arg(count) : tr("%1 / %2").arg(index + 1).arg(count));
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] column The column.
+/// \param[in] order The sort order.
+//****************************************************************************************************************************************************
+void SessionWidget::onSortIndicatorChanged(int column, Qt::SortOrder order) {
+    scheduler_.preempt();
+    filter_.requestSort(column, order);
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void SessionWidget::onSortStarted() {
+    emit logStatusMessageChanged(tr("Sorting..."));
+}
+
+
 //****************************************************************************************************************************************************
 //
 //****************************************************************************************************************************************************
 void SessionWidget::onLogLoaded() {
-    ui_.tableView->resizeColumnsToContents();
-    ui_.tableView->setColumnWidth(3, qMin(ui_.tableView->columnWidth(3), 600));
+    Instrumentation::ScopedTimer const timer(Instrumentation::Stage::LogLoaded);
+    {
+        QSignalBlocker const blocker(ui_.tableView->horizontalHeader());
+        ui_.tableView->horizontalHeader()->setSortIndicator(-1, Qt::AscendingOrder);
+    }
+    ui_.histogramWidget->setLog(filter_.log());
+    this->updateTimeEdits();
+    this->updatePackageCompleter();
+    this->updateAnomalyList();
+    ui_.facetWidget->refresh();
+    searchHits_.start(filter_.log(), ui_.editSearch->text());
+    {
+        Instrumentation::ScopedTimer const sizingTimer(Instrumentation::Stage::ColumnSizing);
+        columnSizer_->estimate();
+    }
     this->onLayoutChanged();
 }
 
 
+//****************************************************************************************************************************************************
+/// \param[in] filePaths The ordered list of files forming the log.
+/// \param[in] log The log.
+//****************************************************************************************************************************************************
+void SessionWidget::onLogReady(QStringList const &filePaths, SPLog const &log) {
+    LogCache::insert(filePaths, log);
+    filter_.setLog(log);
+}
+
+
 //****************************************************************************************************************************************************
 /// This slot is called when the filtering of the log change.
 //****************************************************************************************************************************************************
@@ -119,6 +459,7 @@ void SessionWidget::onLayoutChanged() {
         message = entryCount > 1 ? QString("%1 entries").arg(entryCount) : "1 entry";
     }
     emit logStatusMessageChanged(message);
+    ui_.facetWidget->updateCounts();
 }
 
 
@@ -126,7 +467,7 @@ void SessionWidget::onLayoutChanged() {
 //
 //****************************************************************************************************************************************************
 void SessionWidget::onShowBridgeLog() {
-    filter_.setLog(session_.has_value() ? session_->bridgeLog() : SPLog {});
+    this->showLog(session_.has_value() ? session_->bridgeFilePaths() : QStringList {});
 }
 
 
@@ -134,7 +475,7 @@ void SessionWidget::onShowBridgeLog() {
 //
 //****************************************************************************************************************************************************
 void SessionWidget::onShowGUILog() {
-    filter_.setLog(session_.has_value() ? session_->guiLog() : SPLog {});
+    this->showLog(session_.has_value() ? session_->guiFilePaths() : QStringList {});
 }
 
 
@@ -142,7 +483,7 @@ void SessionWidget::onShowGUILog() {
 //
 //****************************************************************************************************************************************************
 void SessionWidget::onShowLauncherLog() {
-    filter_.setLog(session_.has_value() ? session_->launcherLog() : SPLog {});
+    this->showLog(session_.has_value() ? session_->launcherFilePaths() : QStringList {});
 }
 
 
@@ -156,3 +497,109 @@ void SessionWidget::updateGUI() {
     ui_.buttonLauncher->setEnabled(hasSession && session_->hasLauncherLog());
 
 }
+
+
+//****************************************************************************************************************************************************
+/// The edits are reset to the time span of the log. If a time range is active, it is updated accordingly.
+//****************************************************************************************************************************************************
+void SessionWidget::updateTimeEdits() {
+    SPLog const log = filter_.log();
+    bool const hasLog = log && !log->isEmpty();
+    ui_.checkTimeRange->setEnabled(hasLog);
+    ui_.editTimeStart->setEnabled(hasLog && ui_.checkTimeRange->isChecked());
+    ui_.editTimeEnd->setEnabled(hasLog && ui_.checkTimeRange->isChecked());
+    ui_.editJumpTime->setEnabled(hasLog);
+    ui_.buttonJump->setEnabled(hasLog);
+    if (!hasLog) {
+        return;
+    }
+
+    QDateTime const start = LogEntry::timestampToDateTime(log->startTimestamp());
+    QDateTime const end = LogEntry::timestampToDateTime(log->endTimestamp());
+    for (QDateTimeEdit *edit: { ui_.editTimeStart, ui_.editTimeEnd, ui_.editJumpTime }) {
+        QSignalBlocker const blocker(edit);
+        edit->setDateTimeRange(start, end);
+    }
+    {
+        QSignalBlocker const blockerStart(ui_.editTimeStart);
+        QSignalBlocker const blockerEnd(ui_.editTimeEnd);
+        ui_.editTimeStart->setDateTime(start);
+        ui_.editTimeEnd->setDateTime(end);
+        ui_.editJumpTime->setDateTime(start);
+    }
+    if (ui_.checkTimeRange->isChecked()) {
+        this->onTimeRangeChanged();
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// The completer pop-up lists the packages by decreasing number of entries, with their entry count.
+//****************************************************************************************************************************************************
+void SessionWidget::updatePackageCompleter() {
+    packageCompletionModel_.clear();
+    SPLog const log = filter_.log();
+    if (!log) {
+        return;
+    }
+
+    QStringList const &packages = log->packages();
+    QList<qsizetype> const &counts = log->packageCounts();
+    QList<qsizetype> order(packages.count());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, [&counts](qsizetype lhs, qsizetype rhs) -> bool { return counts[lhs] > counts[rhs]; });
+    for (qsizetype const i: order) {
+        if (packages[i].isEmpty()) {
+            continue;
+        }
+        auto *item = new QStandardItem(QString("%1 (%2)").arg(packages[i]).arg(counts[i]));
+        item->setData(packages[i], Qt::UserRole);
+        item->setEditable(false);
+        packageCompletionModel_.appendRow(item);
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// The first item of the list is a placeholder that shows the number of anomalies.
+//****************************************************************************************************************************************************
+void SessionWidget::updateAnomalyList() {
+    ui_.comboAnomalies->clear();
+    SPLog const log = filter_.log();
+    qsizetype const count = log ? log->anomalies().count() : 0;
+    ui_.comboAnomalies->addItem(QString("Anomalies (%1)").arg(count));
+    ui_.comboAnomalies->setEnabled(count > 0);
+    if (!log) {
+        return;
+    }
+    for (BurstDetector::Anomaly const &anomaly: log->anomalies()) {
+        ui_.comboAnomalies->addItem(anomaly.toString());
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The source row of the current item in the table view.
+/// \return -1 if there is no current item.
+//****************************************************************************************************************************************************
+qint32 SessionWidget::currentSourceRow() const {
+    QModelIndex const index = ui_.tableView->currentIndex();
+    return index.isValid() ? filter_.mapToSource(index).row() : -1;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] sourceRow The source row.
+//****************************************************************************************************************************************************
+void SessionWidget::selectSourceRow(qint32 sourceRow) {
+    SPLog const log = filter_.log();
+    if (!log) {
+        return;
+    }
+    QModelIndex const index = filter_.mapFromSource(log->index(sourceRow, 0));
+    if (!index.isValid()) {
+        return;
+    }
+    ui_.tableView->setCurrentIndex(index);
+    ui_.tableView->scrollTo(index, QAbstractItemView::PositionAtCenter);
+}
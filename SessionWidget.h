@@ -9,7 +9,10 @@
 
 
 #include "ui_SessionWidget.h"
+#include "ColumnSizer.h"
 #include "FilterModel.h"
+#include "LogScheduler.h"
+#include "SearchHits.h"
 #include "Session.h"
 
 
@@ -27,14 +30,31 @@ public: // member functions.
     SessionWidget& operator=(SessionWidget const &) = delete; ///< Disabled assignment operator.
     SessionWidget& operator=(SessionWidget &&) = delete; ///< Disabled move assignment operator.
 
-    void setSession(std::optional<Session> const &session); ///< Set the session.
+    void setSession(std::optional<Session> const &session, QList<Session> const &adjacentSessions = {}); ///< Set the session.
+    SPLog log() const; ///< Return the currently displayed log.
+    MemoryUsage memoryUsage() const; ///< Return the estimated memory usage of the displayed log and of its filter model.
+    QList<qint32> visibleSourceRows() const; ///< Return the source rows of the filtered view, in view order.
 
 public slots:
     void onTextFilterChanged(QString const &value); ///< Slot for the change of the text filter edit.
     void onPackageFilterChanged(QString const &value); ///< Slot for the change of the packet filter edit.
     void onLevelComboChanged(int index); ///< Slot the the change of the level combo.
     void onLevelStrictnessChanged(bool nonStrict); ///< Slot for the change of the level strictness check.
+    void onTimeRangeChanged(); ///< Slot for the change of the time range controls.
+    void onJumpToTime(); ///< Slot for the 'Jump to' button.
+    void onHistogramBucketClicked(qint64 start, qint64 end); ///< Slot for the click on a bucket of the time histogram.
+    void onAnomalyActivated(int index); ///< Slot for the selection of an anomaly in the anomaly list.
+    void onFacetValueSelected(QString const &key, QString const &value); ///< Slot for the selection of a facet value.
+    void onFacetValueCleared(); ///< Slot for the clearing of the facet value selection.
+    void onSearchTextChanged(QString const &text); ///< Slot for the change of the search text.
+    void onSearchNext(); ///< Slot for the 'Next' search button.
+    void onSearchPrevious(); ///< Slot for the 'Previous' search button.
+    void updateSearchLabel(); ///< Update the search hit counter.
+    void onSortIndicatorChanged(int column, Qt::SortOrder order); ///< Slot for the change of the sort indicator of the table header.
+    void onSortStarted(); ///< Slot for the start of a sort.
+    void selectSourceRow(qint32 sourceRow); ///< Select and show a source row in the table view.
     void onLogLoaded(); ///< Slot for the loading of a log.
+    void onLogReady(QStringList const &filePaths, SPLog const &log); ///< Slot for the end of a background load.
     void onLayoutChanged(); ///< Slot for the changing of the filtering.
     void onShowBridgeLog(); ///< Slot for showing the bridge log.
     void onShowGUILog(); ///< Slot for showing the bridge-gui log.
@@ -45,6 +65,11 @@ signals:
 
 private:
     void updateGUI(); ///< Update the GUI state
+    void showLog(QStringList const &filePaths); ///< Display the log for a list of files, loading it in the background if needed.
+    void updateTimeEdits(); ///< Update the time edits to match the log time span.
+    void updatePackageCompleter(); ///< Update the package completer with the package dictionary of the log.
+    void updateAnomalyList(); ///< Update the anomaly list with the anomalies of the log.
+    qint32 currentSourceRow() const; ///< Return the source row of the current table view item.
 
 signals:
     void logStatusMessageChanged(QString const &statusMessages); ///< emit a signal for change of the log status message.
@@ -53,6 +78,10 @@ private:
     std::optional<Session> session_; ///< The session.
     Ui::SessionWidget ui_ {}; ///< The UI for the widget.
     FilterModel filter_; ///< The filter model for the log.
+    QStandardItemModel packageCompletionModel_; ///< The model for the package filter completer.
+    SearchHits searchHits_; ///< The search hits.
+    ColumnSizer *columnSizer_ { nullptr }; ///< The column sizer for the table view.
+    LogScheduler scheduler_; ///< The scheduler loading and prefetching the logs that are not in the cache.
 };
 
 
@@ -0,0 +1,170 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of sort keys class.
+
+
+#include "SortKeys.h"
+
+
+namespace {
+int constexpr radixBits = 16; ///< The number of bits per pass of the radix sort.
+quint64 constexpr radixMask = (quint64(1) << radixBits) - 1; ///< The mask for a digit of the radix sort.
+qsizetype constexpr cancellationCheckInterval = 1 << 16; ///< The number of rows processed between two cancellation checks.
+}
+
+
+//****************************************************************************************************************************************************
+/// Rows with equal values are kept in log order, whatever the sort order.
+///
+/// \param[in] log The log.
+/// \param[in] column The column.
+/// \param[in] order The sort order.
+/// \param[in] cancelled A flag that is set if the computation should be cancelled.
+/// \return The rows of the log in the sorted order of the column.
+/// \return An empty list if the column cannot be sorted, or if the computation was cancelled.
+//****************************************************************************************************************************************************
+QList<qint32> SortKeys::computeOrder(Log const &log, int column, Qt::SortOrder order, std::atomic_bool const &cancelled) {
+    QList<LogEntry> const &entries = log.entries();
+    QList<quint64> keys(entries.count());
+    switch (column) {
+    case 0:
+        for (qsizetype i = 0; i < keys.count(); ++i) {
+            keys[i] = quint64(log.timestamp(i) + 1); // invalid timestamps (-1) are sorted first.
+        }
+        break;
+    case 1:
+        for (qsizetype i = 0; i < keys.count(); ++i) {
+            keys[i] = quint64(entries[i].level());
+        }
+        break;
+    case 2: {
+        QList<quint64> const packageRanks = SortKeys::collationRanks(log.packages());
+        for (qsizetype i = 0; i < keys.count(); ++i) {
+            keys[i] = packageRanks[log.packageIds_[i]];
+        }
+        break;
+    }
+    case 3:
+        keys = SortKeys::dictionaryKeys(log, [](LogEntry const &entry, QByteArray &) -> QByteArrayView {
+            QUtf8StringView const message = entry.messageUtf8();
+            return QByteArrayView(message.data(), message.size());
+        }, cancelled);
+        break;
+    case 4:
+        keys = SortKeys::dictionaryKeys(log, [](LogEntry const &entry, QByteArray &buffer) -> QByteArrayView {
+            entry.fieldsUtf8(buffer);
+            return buffer;
+        }, cancelled);
+        break;
+    default:
+        return {};
+    }
+    if (cancelled) {
+        return {};
+    }
+
+    if (order == Qt::DescendingOrder) {
+        for (quint64 &key: keys) {
+            key = ~key; // the radix sort is stable, so equal keys stay in log order.
+        }
+    }
+    return SortKeys::orderFromKeys(keys, cancelled);
+}
+
+
+//****************************************************************************************************************************************************
+/// The sort is a stable LSD radix sort with 16-bit digits. Passes where all keys have the same digit are skipped, so small keys such as
+/// levels or dictionary ranks only need one pass.
+///
+/// \param[in] keys The keys.
+/// \param[in] cancelled A flag that is set if the computation should be cancelled.
+/// \return The indices of the keys in the sorted order. Equal keys are kept in index order.
+/// \return An empty list if the computation was cancelled.
+//****************************************************************************************************************************************************
+QList<qint32> SortKeys::orderFromKeys(QList<quint64> const &keys, std::atomic_bool const &cancelled) {
+    qsizetype const count = keys.count();
+    QList<qint32> order(count);
+    std::iota(order.begin(), order.end(), 0);
+    QList<qint32> buffer(count);
+    QList<qsizetype> offsets(radixMask + 2);
+
+    for (int shift = 0; shift < 64; shift += radixBits) {
+        if (cancelled) {
+            return {};
+        }
+        offsets.fill(0);
+        for (qint32 const index: order) {
+            ++offsets[qsizetype((keys[index] >> shift) & radixMask) + 1];
+        }
+        if (std::ranges::any_of(offsets, [count](qsizetype c) -> bool { return c == count; })) {
+            continue; // all keys have the same digit.
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+        for (qint32 const index: order) {
+            buffer[offsets[qsizetype((keys[index] >> shift) & radixMask)]++] = index;
+        }
+        std::swap(order, buffer);
+    }
+    return order;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] values The strings.
+/// \return The rank of each string in the collation order.
+//****************************************************************************************************************************************************
+QList<quint64> SortKeys::collationRanks(QStringList const &values) {
+    QCollator collator;
+    collator.setCaseSensitivity(Qt::CaseInsensitive);
+    collator.setNumericMode(true);
+
+    QList<qsizetype> order(values.count());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::stable_sort(order, [&collator, &values](qsizetype lhs, qsizetype rhs) -> bool {
+        return collator.compare(values[lhs], values[rhs]) < 0;
+    });
+
+    QList<quint64> ranks(values.count());
+    for (qsizetype i = 0; i < order.count(); ++i) {
+        ranks[order[i]] = quint64(i);
+    }
+    return ranks;
+}
+
+
+//****************************************************************************************************************************************************
+/// The dictionary is built on the UTF-8 values of the entries, and each distinct value is only decoded once, for collation.
+///
+/// \param[in] log The log.
+/// \param[in] value The function returning the UTF-8 value of the column for an entry. It receives a buffer it can use to build the value,
+/// and returns a view on the value, that must remain valid until the next call.
+/// \param[in] cancelled A flag that is set if the computation should be cancelled.
+/// \return The key of each row, i.e. the collation rank of its value in the dictionary of values.
+//****************************************************************************************************************************************************
+QList<quint64> SortKeys::dictionaryKeys(Log const &log, std::function<QByteArrayView(LogEntry const &, QByteArray &)> const &value,
+    std::atomic_bool const &cancelled) {
+    QList<LogEntry> const &entries = log.entries();
+    QHash<QByteArray, qint32> lookup;
+    QStringList dictionary;
+    QByteArray buffer;
+    QList<quint64> keys(entries.count());
+    for (qsizetype i = 0; i < entries.count(); ++i) {
+        if ((i % cancellationCheckInterval == 0) && cancelled) {
+            return {};
+        }
+        QByteArrayView const bytes = value(entries[i], buffer);
+        auto it = lookup.find(QByteArray::fromRawData(bytes.data(), bytes.size())); // no copy is made for the lookup.
+        if (it == lookup.end()) {
+            it = lookup.insert(bytes.toByteArray(), qint32(dictionary.count()));
+            dictionary.append(QString::fromUtf8(bytes));
+        }
+        keys[i] = quint64(it.value());
+    }
+
+    QList<quint64> const ranks = SortKeys::collationRanks(dictionary);
+    for (quint64 &key: keys) {
+        key = ranks[qsizetype(key)];
+    }
+    return keys;
+}
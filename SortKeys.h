@@ -0,0 +1,35 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of sort keys class.
+
+
+#ifndef ANALOG_SORT_KEYS_H
+#define ANALOG_SORT_KEYS_H
+
+
+#include "Log.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Sort keys class.
+///
+/// The class computes, for a column of a log, the sorted order of the rows. Time and level are sorted on their integer values. Package,
+/// message and fields are first mapped to dictionary ids, by hashing their UTF-8 bytes, and the distinct values of the dictionary are decoded
+/// once and ranked using a collator. In all cases, the rows are then ordered with a stable LSD radix sort on 64-bit integer keys, so no
+/// comparison of rows is ever performed.
+//****************************************************************************************************************************************************
+class SortKeys {
+public: // static member functions.
+    static QList<qint32> computeOrder(Log const &log, int column, Qt::SortOrder order,
+        std::atomic_bool const &cancelled); ///< Compute the sorted order of the rows for a column.
+    static QList<qint32> orderFromKeys(QList<quint64> const &keys, std::atomic_bool const &cancelled); ///< Compute the sorted order of integer keys.
+
+private: // static member functions.
+    static QList<quint64> collationRanks(QStringList const &values); ///< Return the collation rank of each string of a list.
+    static QList<quint64> dictionaryKeys(Log const &log, std::function<QByteArrayView(LogEntry const &, QByteArray &)> const &value,
+        std::atomic_bool const &cancelled); ///< Return the keys for a string column, using a dictionary.
+};
+
+
+#endif //ANALOG_SORT_KEYS_H
@@ -0,0 +1,114 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of message template dialog class.
+
+
+#include "TemplateDialog.h"
+
+
+namespace {
+qsizetype constexpr maxRowsPerTemplate = 500; ///< The maximum number of entries listed for an expanded template.
+QString const dateTimeFormat = "yyyy-MM-dd HH:mm:ss.zzz"; ///< The date/time format.
+int constexpr idRole = Qt::UserRole; ///< The role used to store the template id of template items.
+int constexpr rowRole = Qt::UserRole + 1; ///< The role used to store the source row of entry items.
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] levelCounts The number of entries per level.
+/// \return A string describing the level distribution, from the highest level to the lowest.
+//****************************************************************************************************************************************************
+QString levelDistributionString(std::array<qsizetype, LogEntry::levelCount> const &levelCounts) {
+    QStringList result;
+    for (qsizetype i = LogEntry::levelCount - 1; i >= 0; --i) {
+        if (levelCounts[i] > 0) {
+            result.append(QString("%1: %2").arg(LogEntry::levelToString(LogEntry::Level(i))).arg(levelCounts[i]));
+        }
+    }
+    return result.join(", ");
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] parent The parent widget of the dialog.
+/// \param[in] log The log.
+//****************************************************************************************************************************************************
+TemplateDialog::TemplateDialog(QWidget *parent, SPLog log)
+    : QDialog(parent),
+      log_(std::move(log)) {
+    ui_.setupUi(this);
+    connect(ui_.buttonClose, &QPushButton::clicked, this, &QDialog::accept);
+    connect(ui_.tree, &QTreeWidget::itemExpanded, this, &TemplateDialog::onItemExpanded);
+    connect(ui_.tree, &QTreeWidget::itemDoubleClicked, this, &TemplateDialog::onItemDoubleClicked);
+    if (!log_) {
+        return;
+    }
+
+    QList<TemplateMiner::Template> const &templates = log_->templateMiner().templates();
+    QList<qint32> order(templates.count());
+    std::iota(order.begin(), order.end(), 0);
+    std::ranges::sort(order, [&templates](qint32 lhs, qint32 rhs) -> bool { return templates[lhs].count > templates[rhs].count; });
+
+    for (qint32 const id: order) {
+        TemplateMiner::Template const &tmpl = templates[id];
+        auto *item = new QTreeWidgetItem(ui_.tree);
+        item->setText(0, tmpl.text());
+        item->setText(1, QString::number(tmpl.count));
+        item->setText(2, LogEntry::timestampToDateTime(tmpl.firstTimestamp).toString(dateTimeFormat));
+        item->setText(3, LogEntry::timestampToDateTime(tmpl.lastTimestamp).toString(dateTimeFormat));
+        item->setText(4, levelDistributionString(tmpl.levelCounts));
+        item->setTextAlignment(1, Qt::AlignRight);
+        item->setData(0, idRole, id);
+        item->setChildIndicatorPolicy(QTreeWidgetItem::ShowIndicator);
+    }
+    ui_.labelSummary->setText(tr("%1 templates for %2 entries").arg(templates.count()).arg(log_->entries().count()));
+    for (int i = 1; i < ui_.tree->columnCount(); ++i) {
+        ui_.tree->resizeColumnToContents(i);
+    }
+    ui_.tree->setColumnWidth(0, 600);
+}
+
+
+//****************************************************************************************************************************************************
+/// The entries of the template are listed lazily, on first expansion.
+///
+/// \param[in] item The item.
+//****************************************************************************************************************************************************
+void TemplateDialog::onItemExpanded(QTreeWidgetItem *item) {
+    if ((!log_) || item->parent() || (item->childCount() > 0)) {
+        return;
+    }
+    qint32 const id = item->data(0, idRole).toInt();
+    QList<qint32> const &templateIds = log_->templateIds();
+    QList<LogEntry> const &entries = log_->entries();
+    qsizetype count = 0;
+    for (qsizetype row = 0; row < templateIds.count(); ++row) {
+        if (templateIds[row] != id) {
+            continue;
+        }
+        if (count >= maxRowsPerTemplate) {
+            auto *more = new QTreeWidgetItem(item);
+            more->setText(0, tr("... (only the first %1 entries are listed)").arg(maxRowsPerTemplate));
+            break;
+        }
+        LogEntry const &entry = entries[row];
+        auto *child = new QTreeWidgetItem(item);
+        child->setText(0, QString("%1 %2").arg(entry.message(), entry.fieldsString()).trimmed());
+        child->setText(2, LogEntry::timestampToDateTime(entry.timestamp()).toString(dateTimeFormat));
+        child->setText(4, LogEntry::levelToString(entry.level()));
+        child->setData(0, rowRole, qint32(row));
+        ++count;
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] item The item.
+//****************************************************************************************************************************************************
+void TemplateDialog::onItemDoubleClicked(QTreeWidgetItem *item, int) {
+    QVariant const row = item->data(0, rowRole);
+    if (row.isValid()) {
+        emit sourceRowActivated(row.toInt());
+    }
+}
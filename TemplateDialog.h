@@ -0,0 +1,44 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of message template dialog class.
+
+
+#ifndef ANALOG_TEMPLATE_DIALOG_H
+#define ANALOG_TEMPLATE_DIALOG_H
+
+
+#include "ui_TemplateDialog.h"
+#include "Log.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Message template dialog class.
+///
+/// The dialog shows the message templates of a log, grouped with their statistics. Expanding a template lists its entries.
+//****************************************************************************************************************************************************
+class TemplateDialog : public QDialog {
+    Q_OBJECT
+
+public: // member functions.
+    TemplateDialog(QWidget *parent, SPLog log); ///< Default constructor.
+    TemplateDialog(TemplateDialog const &) = delete; ///< Disabled copy-constructor.
+    TemplateDialog(TemplateDialog &&) = delete; ///< Disabled assignment copy-constructor.
+    ~TemplateDialog() override = default; ///< Destructor.
+    TemplateDialog& operator=(TemplateDialog const &) = delete; ///< Disabled assignment operator.
+    TemplateDialog& operator=(TemplateDialog &&) = delete; ///< Disabled move assignment operator.
+
+signals:
+    void sourceRowActivated(qint32 sourceRow); ///< Signal emitted when an entry is double-clicked.
+
+private slots:
+    void onItemExpanded(QTreeWidgetItem *item); ///< Slot for the expansion of an item.
+    void onItemDoubleClicked(QTreeWidgetItem *item, int column); ///< Slot for the double-click on an item.
+
+private: // data members
+    Ui::TemplateDialog ui_ {}; ///< The UI for the dialog.
+    SPLog log_; ///< The log.
+};
+
+
+#endif //ANALOG_TEMPLATE_DIALOG_H
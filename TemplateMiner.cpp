@@ -0,0 +1,186 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of message template miner class.
+
+
+#include "TemplateMiner.h"
+#include "MemoryUsage.h"
+
+
+namespace {
+double constexpr similarityThreshold = 0.5; ///< The minimum similarity for a message to join a template.
+qsizetype constexpr maxTemplatesPerLeaf = 64; ///< The maximum number of templates in a leaf of the routing tree.
+qint64 constexpr cacheNodeByteCount = 48; ///< The estimated size of a node of the cache, excluding the heap data of its key.
+}
+
+
+QString const TemplateMiner::wildcard = "<*>";
+
+
+//****************************************************************************************************************************************************
+/// \param[in] token The token.
+/// \return true iff the token contains a digit.
+//****************************************************************************************************************************************************
+bool hasDigit(QString const &token) {
+    return std::ranges::any_of(token, [](QChar c) -> bool { return c.isDigit(); });
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] tmpl The template tokens.
+/// \param[in] tokens The message tokens.
+/// \return The fraction of tokens identical in the template and the message.
+//****************************************************************************************************************************************************
+double similarity(QStringList const &tmpl, QStringList const &tokens) {
+    if (tokens.isEmpty()) {
+        return 1.0;
+    }
+    qsizetype equalCount = 0;
+    for (qsizetype i = 0; i < tokens.count(); ++i) {
+        if (tmpl[i] == tokens[i]) {
+            ++equalCount;
+        }
+    }
+    return double(equalCount) / double(tokens.count());
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The template as a string.
+//****************************************************************************************************************************************************
+QString TemplateMiner::Template::text() const {
+    return tokens.join(' ');
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void TemplateMiner::clear() {
+    templates_.clear();
+    leaves_.clear();
+    cache_.clear();
+}
+
+
+//****************************************************************************************************************************************************
+/// The message is only converted to a string if it is not in the cache. Messages with more than maxTokenCount tokens are truncated before
+/// matching, so the size of templates is bounded.
+///
+/// \param[in] message The UTF-8 message.
+/// \return The identifier of the template, i.e. its index in the template list.
+//****************************************************************************************************************************************************
+qint32 TemplateMiner::addMessage(QUtf8StringView message) {
+    QByteArray const key = QByteArray::fromRawData(message.data(), message.size()); // no copy is made for the lookup.
+    if (qint32 const *cachedId = cache_.object(key)) {
+        return *cachedId;
+    }
+
+    QStringList tokens = message.toString().split(' ', Qt::SkipEmptyParts);
+    for (QString &token: tokens) {
+        if (hasDigit(token)) {
+            token = wildcard;
+        }
+    }
+    if (tokens.count() > maxTokenCount) {
+        tokens.resize(maxTokenCount);
+        tokens.back() = wildcard;
+    }
+    qint32 const id = this->matchTokens(tokens);
+    cache_.insert(QByteArray(message.data(), message.size()), new qint32(id));
+    return id;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] entry The entry.
+/// \param[in] timestamp The timestamp of the entry.
+/// \return The identifier of the template.
+//****************************************************************************************************************************************************
+qint32 TemplateMiner::addEntry(LogEntry const &entry, qint64 timestamp) {
+    qint32 const id = this->addMessage(entry.messageUtf8());
+    Template &tmpl = templates_[id];
+    ++tmpl.count;
+    if ((tmpl.firstTimestamp == LogEntry::invalidTimestamp) || (timestamp < tmpl.firstTimestamp)) {
+        tmpl.firstTimestamp = timestamp;
+    }
+    tmpl.lastTimestamp = qMax(tmpl.lastTimestamp, timestamp);
+    ++tmpl.levelCounts[qsizetype(entry.level())];
+    return id;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The list of templates.
+//****************************************************************************************************************************************************
+QList<TemplateMiner::Template> const &TemplateMiner::templates() const {
+    return templates_;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] tokens The masked tokens of a message.
+/// \return The identifier of the template.
+//****************************************************************************************************************************************************
+qint32 TemplateMiner::matchTokens(QStringList const &tokens) {
+    QString const leafKey = QString("%1 %2").arg(tokens.count()).arg(tokens.isEmpty() ? QString() : tokens.front());
+    QList<qint32> &leaf = leaves_[leafKey];
+
+    qint32 bestId = -1;
+    double bestSimilarity = -1.0;
+    for (qint32 const id: leaf) {
+        QStringList const &tmpl = templates_[id].tokens;
+        if (tmpl.count() != tokens.count()) {
+            continue;
+        }
+        double const sim = similarity(tmpl, tokens);
+        if (sim > bestSimilarity) {
+            bestSimilarity = sim;
+            bestId = id;
+        }
+    }
+
+    bool const leafIsFull = leaf.count() >= maxTemplatesPerLeaf;
+    if ((bestId >= 0) && ((bestSimilarity >= similarityThreshold) || leafIsFull)) {
+        QStringList &tmpl = templates_[bestId].tokens;
+        for (qsizetype i = 0; i < tokens.count(); ++i) {
+            if (tmpl[i] != tokens[i]) {
+                tmpl[i] = wildcard;
+            }
+        }
+        return bestId;
+    }
+
+    qint32 const id = qint32(templates_.count());
+    templates_.append(Template { .tokens = tokens });
+    leaf.append(id);
+    return id;
+}
+
+
+//****************************************************************************************************************************************************
+/// The cache only speeds up the assignment of templates, so it can be released once all entries have been added.
+//****************************************************************************************************************************************************
+void TemplateMiner::releaseCache() {
+    cache_.clear();
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The estimated heap size of the miner, in bytes.
+//****************************************************************************************************************************************************
+qint64 TemplateMiner::byteCount() const {
+    qint64 result = MemoryUsage::listByteCount(templates_) + MemoryUsage::hashByteCount(leaves_)
+        + cache_.size() * (cacheNodeByteCount + qint64(sizeof(qint32)));
+    for (Template const &tpl: templates_) {
+        result += MemoryUsage::stringListByteCount(tpl.tokens);
+    }
+    for (auto it = leaves_.begin(); it != leaves_.end(); ++it) {
+        result += MemoryUsage::stringByteCount(it.key()) + MemoryUsage::listByteCount(it.value());
+    }
+    for (QByteArray const &key: cache_.keys()) {
+        result += MemoryUsage::byteArrayByteCount(key);
+    }
+    return result;
+}
@@ -0,0 +1,64 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of message template miner class.
+
+
+#ifndef ANALOG_TEMPLATE_MINER_H
+#define ANALOG_TEMPLATE_MINER_H
+
+
+#include "LogEntry.h"
+
+
+//****************************************************************************************************************************************************
+/// \brief Message template miner class.
+///
+/// The miner is an online implementation of the Drain algorithm: messages are split in tokens, tokens containing digits are masked, and
+/// messages are routed by token count and first token to a small list of templates. A message joins the most similar template if the
+/// similarity is high enough, and the differing tokens of the template become wildcards. Otherwise, it creates a new template.
+///
+/// Identical messages are resolved through a LRU cache, so the cost on typical Bridge logs is dominated by a hash lookup per entry.
+//****************************************************************************************************************************************************
+class TemplateMiner {
+public: // data types
+    struct Template {
+        QStringList tokens; ///< The tokens of the template. Wildcards are represented by TemplateMiner::wildcard.
+        qsizetype count { 0 }; ///< The number of entries matching the template.
+        qint64 firstTimestamp { LogEntry::invalidTimestamp }; ///< The timestamp of the first matching entry.
+        qint64 lastTimestamp { LogEntry::invalidTimestamp }; ///< The timestamp of the last matching entry.
+        std::array<qsizetype, LogEntry::levelCount> levelCounts {}; ///< The number of matching entries for each level.
+        QString text() const; ///< Return the template as a string.
+    }; ///< Structure for message templates.
+
+public: // static members
+    static QString const wildcard; ///< The wildcard token.
+    static qsizetype constexpr maxCacheSize = 100000; ///< The maximum number of messages in the cache.
+    static qsizetype constexpr maxTokenCount = 64; ///< Messages with more tokens are truncated, the extra tokens being replaced by a wildcard.
+
+public: // member functions.
+    TemplateMiner() = default; ///< Default constructor.
+    TemplateMiner(TemplateMiner const &) = delete; ///< Disabled copy-constructor.
+    TemplateMiner(TemplateMiner &&) = delete; ///< Disabled assignment copy-constructor.
+    ~TemplateMiner() = default; ///< Destructor.
+    TemplateMiner& operator=(TemplateMiner const &) = delete; ///< Disabled assignment operator.
+    TemplateMiner& operator=(TemplateMiner &&) = delete; ///< Disabled move assignment operator.
+
+    void clear(); ///< Clear the miner.
+    qint32 addMessage(QUtf8StringView message); ///< Assign a template to a UTF-8 message.
+    qint32 addEntry(LogEntry const &entry, qint64 timestamp); ///< Assign a template to an entry and update the template statistics.
+    QList<Template> const &templates() const; ///< Return the templates.
+    void releaseCache(); ///< Release the cache of already seen messages.
+    qint64 byteCount() const; ///< Return the estimated heap size of the miner.
+
+private: // member functions.
+    qint32 matchTokens(QStringList const &tokens); ///< Find or create the template for a list of tokens.
+
+private: // data members
+    QList<Template> templates_; ///< The templates.
+    QHash<QString, QList<qint32>> leaves_; ///< The templates of each leaf of the routing tree, by token count and first token.
+    QCache<QByteArray, qint32> cache_ { maxCacheSize }; ///< The template of the most recently seen messages, by UTF-8 message.
+};
+
+
+#endif //ANALOG_TEMPLATE_MINER_H
@@ -0,0 +1,154 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of time histogram class.
+
+
+#include "TimeHistogram.h"
+#include "MemoryUsage.h"
+
+
+namespace {
+qsizetype constexpr cancellationCheckInterval = 4096; ///< The number of entries counted between two checks of the cancellation flag.
+std::array<qint64, TimeHistogram::resolutionCount> const bucketWidths { 1000, 60 * 1000, 60 * 60 * 1000 }; ///< The bucket widths in ms.
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] buckets The sorted bucket list.
+/// \param[in] index The bucket index.
+/// \return An iterator to the first bucket whose index is greater or equal to index.
+//****************************************************************************************************************************************************
+QList<TimeHistogram::Bucket>::iterator lowerBound(QList<TimeHistogram::Bucket> &buckets, qint64 index) {
+    return std::lower_bound(buckets.begin(), buckets.end(), index,
+        [](TimeHistogram::Bucket const &bucket, qint64 value) -> bool { return bucket.index < value; });
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] buckets The sorted bucket list.
+/// \param[in] index The index of the bucket to retrieve or create.
+/// \return The bucket with the given index. The bucket is created if needed.
+//****************************************************************************************************************************************************
+TimeHistogram::Bucket &bucketAt(QList<TimeHistogram::Bucket> &buckets, qint64 index) {
+    // Entries are mostly in chronological order, so the bucket is almost always the last one, or a new one at the end.
+    if ((!buckets.isEmpty()) && (buckets.back().index == index)) {
+        return buckets.back();
+    }
+    if (buckets.isEmpty() || (buckets.back().index < index)) {
+        buckets.append(TimeHistogram::Bucket { index });
+        return buckets.back();
+    }
+    auto it = lowerBound(buckets, index);
+    if (it->index != index) {
+        it = buckets.insert(it, TimeHistogram::Bucket { index });
+    }
+    return *it;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] resolution The resolution.
+/// \return The width in milliseconds of the buckets for the resolution.
+//****************************************************************************************************************************************************
+qint64 TimeHistogram::bucketWidth(Resolution resolution) {
+    return bucketWidths[qsizetype(resolution)];
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+void TimeHistogram::clear() {
+    for (QList<Bucket> &buckets: buckets_) {
+        buckets.clear();
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// Only the finest resolution is computed from the entries. Each coarser resolution is computed from the previous one.
+///
+/// \param[in] entries The log entries.
+/// \param[in] timestamps The timestamps of the entries.
+/// \param[in] cancelled A flag that is set if the building should be cancelled. The histogram is left incomplete if it is.
+//****************************************************************************************************************************************************
+void TimeHistogram::build(QList<LogEntry> const &entries, QList<qint64> const &timestamps, std::atomic_bool const &cancelled) {
+    this->clear();
+    QList<Bucket> &seconds = buckets_[qsizetype(Resolution::Second)];
+    qint64 const secondWidth = bucketWidth(Resolution::Second);
+    for (qsizetype i = 0; i < entries.count(); ++i) {
+        if ((i % cancellationCheckInterval == 0) && cancelled) {
+            return;
+        }
+        qint64 const ts = timestamps[i];
+        if (ts < 0) {
+            continue;
+        }
+        Bucket &bucket = bucketAt(seconds, ts / secondWidth);
+        ++bucket.count;
+        ++bucket.levelCounts[qsizetype(entries[i].level())];
+    }
+
+    for (qsizetype r = 1; r < resolutionCount; ++r) {
+        qint64 const ratio = bucketWidths[r] / bucketWidths[r - 1];
+        QList<Bucket> &coarse = buckets_[r];
+        for (Bucket const &fine: buckets_[r - 1]) {
+            Bucket &bucket = bucketAt(coarse, fine.index / ratio);
+            bucket.count += fine.count;
+            for (qsizetype level = 0; level < LogEntry::levelCount; ++level) {
+                bucket.levelCounts[level] += fine.levelCounts[level];
+            }
+        }
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] resolution The resolution.
+/// \return The non-empty buckets for the resolution, in chronological order.
+//****************************************************************************************************************************************************
+QList<TimeHistogram::Bucket> const &TimeHistogram::buckets(Resolution resolution) const {
+    return buckets_[qsizetype(resolution)];
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] resolution The resolution.
+/// \param[in] start The start of the time range.
+/// \param[in] end The end of the time range (exclusive).
+/// \return The range [first, last) of the buckets of the resolution that overlap the time range.
+//****************************************************************************************************************************************************
+std::pair<qsizetype, qsizetype> TimeHistogram::bucketRange(Resolution resolution, qint64 start, qint64 end) const {
+    QList<Bucket> const &buckets = buckets_[qsizetype(resolution)];
+    qint64 const width = bucketWidth(resolution);
+    auto const less = [](Bucket const &bucket, qint64 value) -> bool { return bucket.index < value; };
+    qsizetype const first = std::lower_bound(buckets.begin(), buckets.end(), start / width, less) - buckets.begin();
+    qsizetype const last = std::lower_bound(buckets.begin(), buckets.end(), (end + width - 1) / width, less) - buckets.begin();
+    return { first, qMax(first, last) };
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] span The time span in milliseconds.
+/// \param[in] maxBucketCount The maximum number of buckets that can be displayed for the span.
+/// \return The finest resolution for which the span contains at most maxBucketCount buckets. If there is none, the coarsest resolution.
+//****************************************************************************************************************************************************
+TimeHistogram::Resolution TimeHistogram::resolutionForSpan(qint64 span, qsizetype maxBucketCount) {
+    for (qsizetype r = 0; r < resolutionCount; ++r) {
+        if (span / bucketWidths[r] <= maxBucketCount) {
+            return Resolution(r);
+        }
+    }
+    return Resolution::Hour;
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The estimated heap size of the histogram, in bytes.
+//****************************************************************************************************************************************************
+qint64 TimeHistogram::byteCount() const {
+    return std::accumulate(buckets_.begin(), buckets_.end(), qint64(0), [](qint64 acc, QList<Bucket> const &buckets) -> qint64 {
+        return acc + MemoryUsage::listByteCount(buckets);
+    });
+}
@@ -0,0 +1,62 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of time histogram class.
+
+
+#ifndef ANALOG_TIME_HISTOGRAM_H
+#define ANALOG_TIME_HISTOGRAM_H
+
+
+#include "LogEntry.h"
+#include <atomic>
+
+
+//****************************************************************************************************************************************************
+/// \brief Time histogram class.
+///
+/// The histogram is a pyramid of bucket aggregates: entries are counted per second, then seconds are summed into minutes, and minutes into
+/// hours. Only non-empty buckets are stored, in chronological order, so any time range can be drawn at any resolution without scanning the
+/// entries again.
+//****************************************************************************************************************************************************
+class TimeHistogram {
+public: // data types
+    enum class Resolution {
+        Second = 0,
+        Minute = 1,
+        Hour = 2,
+    }; ///< Enumeration for the resolutions of the histogram.
+
+    struct Bucket {
+        qint64 index { 0 }; ///< The index of the bucket, i.e. its start timestamp divided by the bucket width.
+        qint32 count { 0 }; ///< The number of entries in the bucket.
+        std::array<qint32, LogEntry::levelCount> levelCounts {}; ///< The number of entries in the bucket for each level.
+    }; ///< Structure for histogram buckets.
+
+public: // static members
+    static qsizetype constexpr resolutionCount = 3; ///< The number of resolutions.
+
+public: // static member functions.
+    static qint64 bucketWidth(Resolution resolution); ///< Return the width in milliseconds of the buckets for a resolution.
+    static Resolution resolutionForSpan(qint64 span, qsizetype maxBucketCount); ///< Return the finest resolution to display a time span.
+
+public: // member functions.
+    TimeHistogram() = default; ///< Default constructor.
+    TimeHistogram(TimeHistogram const &) = delete; ///< Disabled copy-constructor.
+    TimeHistogram(TimeHistogram &&) = delete; ///< Disabled assignment copy-constructor.
+    ~TimeHistogram() = default; ///< Destructor.
+    TimeHistogram& operator=(TimeHistogram const &) = delete; ///< Disabled assignment operator.
+    TimeHistogram& operator=(TimeHistogram &&) = delete; ///< Disabled move assignment operator.
+
+    void clear(); ///< Clear the histogram.
+    void build(QList<LogEntry> const &entries, QList<qint64> const &timestamps, std::atomic_bool const &cancelled); ///< Build the histogram.
+    QList<Bucket> const &buckets(Resolution resolution) const; ///< Return the buckets for a resolution.
+    std::pair<qsizetype, qsizetype> bucketRange(Resolution resolution, qint64 start, qint64 end) const; ///< Return the buckets overlapping a time range.
+    qint64 byteCount() const; ///< Return the estimated heap size of the histogram.
+
+private: // data members
+    std::array<QList<Bucket>, resolutionCount> buckets_; ///< The buckets for each resolution.
+};
+
+
+#endif //ANALOG_TIME_HISTOGRAM_H
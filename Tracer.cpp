@@ -0,0 +1,334 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of tracer class.
+
+
+#include "Tracer.h"
+#include "BufferedWriter.h"
+
+
+namespace {
+
+
+qsizetype constexpr blockEventCount = 1024; ///< The number of events in a buffer block.
+qint64 constexpr processID = 1; ///< The process ID used in the trace.
+
+
+//****************************************************************************************************************************************************
+/// \brief Structure for trace events.
+//****************************************************************************************************************************************************
+struct Event {
+    char const *name { nullptr }; ///< The name of the event.
+    char const *category { nullptr }; ///< The category of the event.
+    char const *argName { nullptr }; ///< The name of the argument of the event, or null if the event has no argument.
+    qint64 startNs { 0 }; ///< The start of the event, in nanoseconds.
+    qint64 durationNs { 0 }; ///< The duration of the event, in nanoseconds.
+    qint64 argValue { 0 }; ///< The value of the argument of the event.
+};
+
+
+//****************************************************************************************************************************************************
+/// \brief Structure for the blocks of event buffers.
+///
+/// Only the thread owning the buffer writes to a block. The event count and the next block are published with release semantics.
+//****************************************************************************************************************************************************
+struct Block {
+    std::array<Event, blockEventCount> events; ///< The events.
+    std::atomic<qsizetype> count { 0 }; ///< The number of events in the block.
+    std::atomic<Block *> next { nullptr }; ///< The next block, or null if this block is the last one.
+};
+
+
+//****************************************************************************************************************************************************
+/// \brief Structure for per-thread event buffers.
+//****************************************************************************************************************************************************
+struct Buffer {
+    qint64 threadID { 0 }; ///< The thread ID used in the trace.
+    QString threadName; ///< The name of the thread, protected by the registry mutex.
+    std::unique_ptr<Block> head { std::make_unique<Block>() }; ///< The first block.
+    Block *tail { head.get() }; ///< The last block, only accessed by the owning thread.
+    char const *burstName { nullptr }; ///< The name of the current burst, only accessed by the owning thread.
+    char const *burstCategory { nullptr }; ///< The category of the current burst, only accessed by the owning thread.
+    qint64 burstStartNs { 0 }; ///< The time of the first call of the current burst.
+    qint64 burstLastNs { 0 }; ///< The time of the last call of the current burst.
+    qint64 burstCallCount { 0 }; ///< The number of calls in the current burst.
+
+    ~Buffer() {
+        Block *block = head.release();
+        while (block) {
+            Block *const next = block->next.load(std::memory_order_relaxed);
+            delete block;
+            block = next;
+        }
+    } ///< Destructor.
+};
+
+
+//****************************************************************************************************************************************************
+/// \brief Structure holding the buffer of a thread, that is recycled when the thread exits.
+//****************************************************************************************************************************************************
+struct ThreadBuffer {
+    Buffer *buffer { nullptr }; ///< The buffer, or null if the thread did not record any event.
+    ~ThreadBuffer(); ///< Destructor.
+};
+
+
+std::atomic_bool enabled { false }; ///< Is tracing enabled?
+std::chrono::steady_clock::time_point const origin = std::chrono::steady_clock::now(); ///< The origin of the trace timestamps.
+std::mutex registryMutex; ///< The mutex protecting the buffer registry.
+std::deque<std::unique_ptr<Buffer>> buffers; ///< All the buffers.
+std::vector<Buffer *> freeBuffers; ///< The buffers of the threads that have exited.
+thread_local ThreadBuffer threadBuffer; ///< The buffer of the calling thread.
+
+
+}
+
+
+//****************************************************************************************************************************************************
+/// The registry mutex is only locked when a thread records its first event.
+///
+/// \return The buffer of the calling thread.
+//****************************************************************************************************************************************************
+Buffer &currentBuffer() {
+    if (!threadBuffer.buffer) {
+        std::lock_guard const lock(registryMutex);
+        if (freeBuffers.empty()) {
+            buffers.push_back(std::make_unique<Buffer>());
+            buffers.back()->threadID = qint64(buffers.size());
+            threadBuffer.buffer = buffers.back().get();
+        } else {
+            threadBuffer.buffer = freeBuffers.back();
+            freeBuffers.pop_back();
+        }
+    }
+    return *threadBuffer.buffer;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] buffer The buffer.
+/// \param[in] event The event.
+//****************************************************************************************************************************************************
+void appendEvent(Buffer &buffer, Event const &event) {
+    Block *block = buffer.tail;
+    qsizetype count = block->count.load(std::memory_order_relaxed);
+    if (count == blockEventCount) {
+        auto *const next = new Block;
+        block->next.store(next, std::memory_order_release);
+        buffer.tail = block = next;
+        count = 0;
+    }
+    block->events[count] = event;
+    block->count.store(count + 1, std::memory_order_release);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] buffer The buffer.
+//****************************************************************************************************************************************************
+void flushBurst(Buffer &buffer) {
+    if (buffer.burstCallCount == 0) {
+        return;
+    }
+    appendEvent(buffer, { buffer.burstName, buffer.burstCategory, "calls", buffer.burstStartNs, buffer.burstLastNs - buffer.burstStartNs,
+        buffer.burstCallCount });
+    buffer.burstCallCount = 0;
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+ThreadBuffer::~ThreadBuffer() {
+    if (!buffer) {
+        return;
+    }
+    flushBurst(*buffer);
+    std::lock_guard const lock(registryMutex);
+    freeBuffers.push_back(buffer);
+}
+
+
+//****************************************************************************************************************************************************
+/// Only quotes, backslashes and control characters are escaped, which is enough for the names used in the trace.
+///
+/// \param[in] str The string.
+/// \return The string as a quoted JSON string.
+//****************************************************************************************************************************************************
+QString jsonString(QString const &str) {
+    QString result = "\"";
+    for (QChar const c: str) {
+        if ((c == '"') || (c == '\\')) {
+            result += '\\';
+            result += c;
+        } else if (c.unicode() < 0x20) {
+            result += QString("\\u%1").arg(c.unicode(), 4, 16, QChar('0'));
+        } else {
+            result += c;
+        }
+    }
+    return result + "\"";
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] ns A duration in nanoseconds.
+/// \return The duration in microseconds, as a string.
+//****************************************************************************************************************************************************
+QByteArray microseconds(qint64 ns) {
+    return QByteArray::number(double(ns) / 1000.0, 'f', 3);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] name The name of the event.
+/// \param[in] category The category of the event.
+/// \param[in] argName The name of the argument of the event, or null if the event has no argument.
+/// \param[in] argValue The value of the argument of the event.
+//****************************************************************************************************************************************************
+Tracer::Scope::Scope(char const *name, char const *category, char const *argName, qint64 argValue)
+    : name_(name),
+      category_(category),
+      argName_(argName),
+      argValue_(argValue) {
+    if (Tracer::isEnabled()) {
+        startNs_ = Tracer::now();
+    }
+}
+
+
+//****************************************************************************************************************************************************
+//
+//****************************************************************************************************************************************************
+Tracer::Scope::~Scope() {
+    if (startNs_ >= 0) {
+        Tracer::addEvent(name_, category_, startNs_, Tracer::now(), argName_, argValue_);
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// \return true iff tracing is enabled.
+//****************************************************************************************************************************************************
+bool Tracer::isEnabled() {
+    return enabled.load(std::memory_order_relaxed);
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] value Should tracing be enabled?
+//****************************************************************************************************************************************************
+void Tracer::setEnabled(bool value) {
+    enabled.store(value, std::memory_order_relaxed);
+}
+
+
+//****************************************************************************************************************************************************
+/// \return The time elapsed since the start of the process, in nanoseconds.
+//****************************************************************************************************************************************************
+qint64 Tracer::now() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - origin).count();
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] name The name of the event.
+/// \param[in] category The category of the event.
+/// \param[in] startNs The start of the event, as returned by now().
+/// \param[in] endNs The end of the event, as returned by now().
+/// \param[in] argName The name of the argument of the event, or null if the event has no argument.
+/// \param[in] argValue The value of the argument of the event.
+//****************************************************************************************************************************************************
+void Tracer::addEvent(char const *name, char const *category, qint64 startNs, qint64 endNs, char const *argName, qint64 argValue) {
+    if (isEnabled()) {
+        appendEvent(currentBuffer(), { name, category, argName, startNs, endNs - startNs, argValue });
+    }
+}
+
+
+//****************************************************************************************************************************************************
+/// Calls that are less than burstGapNs apart are merged into a single event, whose argument is the number of calls. This is used for
+/// functions called thousands of times per repaint, like Log::data, that would flood the trace if each call was recorded.
+///
+/// \param[in] name The name of the burst event.
+/// \param[in] category The category of the burst event.
+//****************************************************************************************************************************************************
+void Tracer::countBurstCall(char const *name, char const *category) {
+    if (!isEnabled()) {
+        return;
+    }
+    Buffer &buffer = currentBuffer();
+    qint64 const t = now();
+    if ((buffer.burstCallCount > 0) && ((buffer.burstName != name) || (t - buffer.burstLastNs > burstGapNs))) {
+        flushBurst(buffer);
+    }
+    if (buffer.burstCallCount == 0) {
+        buffer.burstName = name;
+        buffer.burstCategory = category;
+        buffer.burstStartNs = t;
+    }
+    buffer.burstLastNs = t;
+    ++buffer.burstCallCount;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] name The name of the thread.
+//****************************************************************************************************************************************************
+void Tracer::setThreadName(QString const &name) {
+    Buffer &buffer = currentBuffer();
+    std::lock_guard const lock(registryMutex);
+    buffer.threadName = name;
+}
+
+
+//****************************************************************************************************************************************************
+/// The current burst of the calling thread is flushed first. Pending bursts of other threads are not saved.
+///
+/// \param[in] filePath The path of the file.
+//****************************************************************************************************************************************************
+void Tracer::save(QString const &filePath) {
+    if (threadBuffer.buffer) {
+        flushBurst(*threadBuffer.buffer);
+    }
+    BufferedWriter writer(filePath);
+    writer.append(QByteArrayView(R"({"displayTimeUnit":"ms","traceEvents":[)"));
+    writer.append(QString(R"({"name":"process_name","ph":"M","pid":%1,"tid":0,"args":{"name":%2}})").arg(processID)
+        .arg(jsonString(QCoreApplication::applicationName())));
+
+    std::lock_guard const lock(registryMutex);
+    for (std::unique_ptr<Buffer> const &buffer: buffers) {
+        QString const threadName = buffer->threadName.isEmpty() ? QString("Thread %1").arg(buffer->threadID) : buffer->threadName;
+        writer.append(QString(R"(,{"name":"thread_name","ph":"M","pid":%1,"tid":%2,"args":{"name":%3}})").arg(processID)
+            .arg(buffer->threadID).arg(jsonString(threadName)));
+        for (Block const *block = buffer->head.get(); block; block = block->next.load(std::memory_order_acquire)) {
+            qsizetype const count = block->count.load(std::memory_order_acquire);
+            for (qsizetype i = 0; i < count; ++i) {
+                Event const &event = block->events[i];
+                writer.append(QByteArrayView(R"(,{"name":")"));
+                writer.append(QByteArrayView(event.name));
+                writer.append(QByteArrayView(R"(","cat":")"));
+                writer.append(QByteArrayView(event.category));
+                writer.append(QByteArrayView(R"(","ph":"X","pid":)"));
+                writer.append(QByteArray::number(processID));
+                writer.append(QByteArrayView(R"(,"tid":)"));
+                writer.append(QByteArray::number(buffer->threadID));
+                writer.append(QByteArrayView(R"(,"ts":)"));
+                writer.append(microseconds(event.startNs));
+                writer.append(QByteArrayView(R"(,"dur":)"));
+                writer.append(microseconds(event.durationNs));
+                if (event.argName) {
+                    writer.append(QByteArrayView(R"(,"args":{")"));
+                    writer.append(QByteArrayView(event.argName));
+                    writer.append(QByteArrayView(R"(":)"));
+                    writer.append(QByteArray::number(event.argValue));
+                    writer.append('}');
+                }
+                writer.append('}');
+            }
+        }
+    }
+    writer.append(QByteArrayView("]}\n"));
+    writer.close();
+}
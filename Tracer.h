@@ -0,0 +1,57 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Declaration of tracer class.
+
+
+#ifndef ANALOG_TRACER_H
+#define ANALOG_TRACER_H
+
+
+//****************************************************************************************************************************************************
+/// \brief Tracer class.
+///
+/// The tracer records the activity of the application as complete events, that are saved in the Chrome trace-event JSON format, and can be
+/// viewed in Perfetto or chrome://tracing. Each thread appends its events to its own buffer, without any lock: a buffer is a list of fixed
+/// size blocks, and the number of events of a block is published with release semantics, so the buffers can be saved while threads are
+/// still recording. Buffers are only registered when a thread records its first event, and are recycled when the thread exits, so short-lived
+/// worker threads share a few tracks. Event names, categories and argument names must be string literals.
+//****************************************************************************************************************************************************
+class Tracer {
+public: // data types
+    //************************************************************************************************************************************************
+    /// \brief Scope class, that records a complete event for the duration of its scope.
+    //************************************************************************************************************************************************
+    class Scope {
+    public: // member functions.
+        Scope(char const *name, char const *category, char const *argName = nullptr, qint64 argValue = 0); ///< Default constructor.
+        Scope(Scope const &) = delete; ///< Disabled copy-constructor.
+        Scope(Scope &&) = delete; ///< Disabled assignment copy-constructor.
+        ~Scope(); ///< Destructor.
+        Scope& operator=(Scope const &) = delete; ///< Disabled assignment operator.
+        Scope& operator=(Scope &&) = delete; ///< Disabled move assignment operator.
+
+    private: // data members
+        char const *name_; ///< The name of the event.
+        char const *category_; ///< The category of the event.
+        char const *argName_; ///< The name of the argument of the event, or null if the event has no argument.
+        qint64 argValue_; ///< The value of the argument of the event.
+        qint64 startNs_ { -1 }; ///< The start of the event, or -1 if tracing is disabled.
+    };
+
+public: // static members
+    static qint64 constexpr burstGapNs = 2000000; ///< The maximum gap between two calls of the same burst, in nanoseconds.
+
+public: // static member functions.
+    static bool isEnabled(); ///< Check whether tracing is enabled.
+    static void setEnabled(bool enabled); ///< Enable or disable tracing.
+    static qint64 now(); ///< Return the time elapsed since the start of the process, in nanoseconds.
+    static void addEvent(char const *name, char const *category, qint64 startNs, qint64 endNs, char const *argName = nullptr,
+        qint64 argValue = 0); ///< Record a complete event.
+    static void countBurstCall(char const *name, char const *category); ///< Count a call in a burst of calls.
+    static void setThreadName(QString const &name); ///< Set the name of the calling thread in the trace.
+    static void save(QString const &filePath); ///< Save the trace as a Chrome trace-event JSON file.
+};
+
+
+#endif //ANALOG_TRACER_H
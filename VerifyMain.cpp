@@ -0,0 +1,157 @@
+/// \file
+/// \author Xavier Michelon
+///
+/// \brief Implementation of the parser verification tool entry-point.
+
+
+#include "Exception.h"
+#include "ParserVerifier.h"
+
+
+namespace {
+
+
+qsizetype constexpr maxSeedLineCountPerFile = 1000; ///< The maximum number of seed lines read from each file.
+QString const optRandom = "random"; ///< The name of the random line count option.
+QString const optSeed = "seed"; ///< The name of the seed option.
+
+QStringList const defaultSeedLines = {
+    R"(time="Oct 30 09:10:20.858" level=info msg="Run app" appName="Proton Mail Bridge" args="[/Users/user/bridge -c]" version=3.99.99+git)",
+    R"(time="Oct 30 09:10:21.105" level=warning msg="Failed to fetch event" error="context canceled" pkg=imap/service userID=7f3a2c)",
+    R"(time="Oct 30 09:10:21.320" level=error msg="Sync failed" error="http: \"server\" closed the connection" pkg=sync attempt=3)",
+    R"(time="Oct 30 09:10:22.001" level=debug msg="Uploading attachment" contentID= disposition= mime-type=image/jpeg service=smtp)",
+    R"(time="Oct 30 09:10:22.017" level=trace msg="IMAP command" pkg=gluon/imap session=12 command="UID FETCH 1:* (FLAGS)")",
+    R"(time="Oct 30 09:10:22.030" level=debug msg="Message updated" message updated=true pkg=imap messageID=42)",
+    "INFO[Oct 30 09:10:21.002] bridge-gui starting",
+    "DEBU[Oct 30 09:10:21.250] Connecting to gRPC service on 127.0.0.1:1042",
+    "WARN[Oct 30 09:10:21.400] Could not load the tray icon theme, falling back to default",
+    "ERRO[Oct 30 09:10:22.810] gRPC call failed: Deadline Exceeded",
+}; ///< The seed lines used when no file is given.
+
+
+}
+
+
+//****************************************************************************************************************************************************
+/// Folders are searched recursively for log files.
+///
+/// \param[in] paths The paths of files and folders.
+/// \return The paths of the log files.
+//****************************************************************************************************************************************************
+QStringList collectFiles(QStringList const &paths) {
+    QStringList result;
+    for (QString const &path: paths) {
+        QFileInfo const info(path);
+        if (info.isDir()) {
+            QDirIterator it(path, { "*.log" }, QDir::Files, QDirIterator::Subdirectories);
+            QStringList dirFiles;
+            while (it.hasNext()) {
+                dirFiles.append(it.next());
+            }
+            dirFiles.sort();
+            result += dirFiles;
+        } else if (info.exists()) {
+            result.append(path);
+        } else {
+            throw Exception(QString("'%1' does not exist.").arg(QDir::toNativeSeparators(path)));
+        }
+    }
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] filePath The path of the file.
+/// \return The first lines of the file.
+//****************************************************************************************************************************************************
+QStringList readSeedLines(QString const &filePath) {
+    QFile file(filePath);
+    if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+        throw Exception(QString("The file '%1' could not be opened.").arg(QDir::toNativeSeparators(filePath)));
+    }
+    QStringList result;
+    while ((!file.atEnd()) && (result.count() < maxSeedLineCountPerFile)) {
+        QString const line = QString::fromUtf8(file.readLine()).trimmed();
+        if (!line.isEmpty()) {
+            result.append(line);
+        }
+    }
+    return result;
+}
+
+
+//****************************************************************************************************************************************************
+/// \param[in] argc The number of command-line arguments.
+/// \param[in] argv The list of command-line arguments.
+//****************************************************************************************************************************************************
+int main(int argc, char *argv[]) {
+    QCoreApplication app(argc, argv);
+    QCoreApplication::setApplicationName("analog-verify");
+    QCoreApplication::setApplicationVersion(QString("%1").arg(ANALOG_VERSION));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Compare the log parser implementations with the reference parser, and report the first divergence.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addOptions({
+        { { "r", optRandom }, "Also verify the given number of randomized lines per log format, obtained by mutating lines of the files "
+            "or built-in lines if no file is given.", "count" },
+        { { "s", optSeed }, "The seed of the random generator. The default is 1.", "seed", "1" },
+    });
+    parser.addPositionalArgument("paths", "The log files, or folders searched recursively for log files.", "paths...");
+    parser.process(app);
+
+    QTextStream out(stdout);
+    QTextStream err(stderr);
+    try {
+        QStringList const filePaths = collectFiles(parser.positionalArguments());
+        qsizetype const randomLineCount = parser.isSet(optRandom) ? parser.value(optRandom).toLongLong() : 0;
+        if ((filePaths.isEmpty()) && (randomLineCount <= 0)) {
+            parser.showHelp(EXIT_FAILURE);
+        }
+        bool ok = false;
+        quint32 const seed = parser.value(optSeed).toUInt(&ok);
+        if (!ok) {
+            throw Exception(QString("'%1' is not a valid seed.").arg(parser.value(optSeed)));
+        }
+
+        QStringList seedLines;
+        for (QString const &filePath: filePaths) {
+            std::optional<ParserVerifier::Divergence> const divergence = ParserVerifier::verifyFile(filePath);
+            if (divergence) {
+                out << divergence->toString() << '\n';
+                return EXIT_FAILURE;
+            }
+            out << "OK " << QDir::toNativeSeparators(filePath) << '\n';
+            out.flush();
+            if (randomLineCount > 0) {
+                seedLines += readSeedLines(filePath);
+            }
+        }
+
+        if (randomLineCount > 0) {
+            QTemporaryDir tempDir;
+            if (!tempDir.isValid()) {
+                throw Exception("Could not create a temporary folder.");
+            }
+            std::optional<ParserVerifier::Divergence> const divergence = ParserVerifier::verifyRandomLines(
+                seedLines.isEmpty() ? defaultSeedLines : seedLines, randomLineCount, seed, tempDir.path());
+            if (divergence) {
+                tempDir.setAutoRemove(false);
+                out << divergence->toString() << '\n';
+                return EXIT_FAILURE;
+            }
+            out << "OK " << randomLineCount << " randomized lines per format (seed " << seed << ")\n";
+        }
+
+        out << "No divergence found.\n";
+        return EXIT_SUCCESS;
+    } catch (Exception const &e) {
+        err << e.message() << '\n';
+    } catch (std::exception const &e) {
+        err << e.what() << '\n';
+    } catch (...) {
+        err << "A fatal error occurred.\n";
+    }
+    return EXIT_FAILURE;
+}
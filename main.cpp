@@ -7,6 +7,14 @@
 #include "MainWindow.h"
 #include "AnalogApp.h"
 #include "Exception.h"
+#include "LogCache.h"
+#include "Tracer.h"
+
+
+namespace {
+QString const optMemoryBudget = "memory-budget"; ///< The name of the memory budget option.
+QString const optTrace = "trace"; ///< The name of the trace option.
+}
 
 
 //****************************************************************************************************************************************************
@@ -15,13 +23,46 @@
 //****************************************************************************************************************************************************
 int main(int argc, char *argv[]) {
     AnalogApp a(argc, argv);
+    QCoreApplication::setApplicationVersion(QString("%1").arg(ANALOG_VERSION));
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Proton Analog log viewer.");
+    parser.addHelpOption();
+    parser.addVersionOption();
+    parser.addOptions({
+        { optMemoryBudget, QString("The memory budget of the log cache, in MiB. The default is %1.").arg(LogCache::defaultBudget / (1024 * 1024)),
+            "MiB" },
+        { optTrace, "Record a trace of the application activity, saved on exit in the Chrome trace-event format, that can be viewed in "
+            "Perfetto.", "path" },
+    });
+    parser.addPositionalArgument("files", "The log files to open.", "[files...]");
+    parser.process(a);
+    if (parser.isSet(optMemoryBudget)) {
+        bool ok = false;
+        qint64 const budget = parser.value(optMemoryBudget).toLongLong(&ok);
+        if ((!ok) || (budget < 0)) {
+            qCritical() << QString("'%1' is not a valid memory budget.").arg(parser.value(optMemoryBudget));
+            return EXIT_FAILURE;
+        }
+        LogCache::setBudget(budget * 1024 * 1024);
+    }
+    if (parser.isSet(optTrace)) {
+        Tracer::setEnabled(true);
+        Tracer::setThreadName("GUI");
+    }
+
     MainWindow w;
     try {
         w.show();
-        if (argc > 1) {
-            QTimer::singleShot(0, &w, [argv, &w]() { w.open(QStringList { QString(argv[1]) }); });
+        QStringList const filePaths = parser.positionalArguments();
+        if (!filePaths.isEmpty()) {
+            QTimer::singleShot(0, &w, [filePaths, &w]() { w.open(filePaths); });
+        }
+        int const result = QApplication::exec();
+        if (parser.isSet(optTrace)) {
+            Tracer::save(parser.value(optTrace));
         }
-        return QApplication::exec();
+        return result;
     } catch (Exception const &e) {
         qCritical() << e.message() << "\n";
     } catch (std::exception const &e) {